@@ -141,6 +141,7 @@ qx.Class.define("nodesqlite.Application",
       var         httpsServer;
       var         httpPort = 80;
       var         httpsPort = 443;
+      var         snapshotExportDir;
       var         users;
       var         dbif = new playground.dbif.DbifNodeSqlite();
       
@@ -164,6 +165,10 @@ qx.Class.define("nodesqlite.Application",
             {
               httpsPort = process.argv[i].split("=", 2)[1];
             }
+            else if (process.argv[i].match(/^snapshots\.export=/))
+            {
+              snapshotExportDir = process.argv[i].split("=", 2)[1];
+            }
           }
         }
         catch(ex) 
@@ -173,6 +178,25 @@ qx.Class.define("nodesqlite.Application",
         }
       }
 
+      // If requested, export the snapshots of users' programs as git
+      // repositories, rather than starting the server
+      if (snapshotExportDir)
+      {
+        playground.dbif.SnapshotStore.exportAll(
+          playground.dbif.MFiles.UserFilesDir,
+          snapshotExportDir,
+          function(error)
+          {
+            if (error)
+            {
+              console.log("Snapshot export failed: " + error);
+            }
+
+            process.exit(error ? 1 : 0);
+          });
+        return;
+      }
+
       // 
       // Read the configuration file
       //
@@ -1048,6 +1072,23 @@ console.log("user=" + JSON.stringify(user, null, "  "));
         httpsServer.listen(httpsPort);
       }
       console.log("");
+
+      // Upon being asked to exit, first write any queued usage detail
+      [ "SIGINT", "SIGTERM" ].forEach(
+        function(signal)
+        {
+          process.on(
+            signal,
+            function()
+            {
+              console.log("Writing queued usage detail before exiting");
+              playground.dbif.UsageDetailQueue.flushAll(
+                function()
+                {
+                  process.exit(0);
+                });
+            });
+        });
     },
     
     /**
@@ -69,13 +69,54 @@ qx.Mixin.define("playground.dbif.MFiles",
     ProgDir            : "PROGRAMS",
     
     /** Subdirectory where template programs are stored */
-    TemplateDir        : "TEMPLATES"
+    TemplateDir        : "TEMPLATES",
+
+    /**
+     * Number of milliseconds for which a directory index is used before it
+     * is rebuilt, so that changes made other than via this interface (e.g.,
+     * to templates) are eventually seen
+     */
+    DirectoryIndexLifetime : 300000,
+
+    /** Each user's directory index, by user id */
+    __directoryIndexes : {},
+
+    /** Count of changes to directory indexes */
+    __directoryIndexGeneration : 0,
+
+    /** Time the server started, so entity tags differ from prior runs */
+    __startTime        : (new Date()).getTime(),
+
+    /** Maximum number of recently requested old versions to retain */
+    VersionCacheSize   : 200,
+
+    /**
+     * Recently requested old versions' code, keyed by user id, program
+     * name, and hash, least recently requested first
+     */
+    __versionCache     : {},
+
+    /** Number of old versions retained */
+    __versionCacheCount : 0,
+
+    /**
+     * Discard a user's directory index, so that it is rebuilt when next
+     * needed. This is needed only for changes not made via this interface,
+     * e.g., to the user's list of template providers.
+     *
+     * @param userId {String}
+     *   The user id
+     */
+    invalidateDirectoryIndex : function(userId)
+    {
+      delete playground.dbif.MFiles.__directoryIndexes[userId];
+    }
   },
 
   members :
   {
     /**
-     * Save a program via git.
+     * Save a program, and a snapshot of it in the user's snapshot store.
      *
      * @param programName {String}
      *   The name of the program being saved
@@ -87,7 +128,16 @@ qx.Mixin.define("playground.dbif.MFiles",
      *   The program's code to be saved
      * 
      * @param notes {String?}
-     *   If provided, the message to add as git notes for this commit
+     *   If provided, the notes to associate with this version
+     *
+     * @param userId {String?}
+     *   The id of the user whose program is being saved. If not provided,
+     *   it's the current user.
+     *
+     * @param bUnchanged {Boolean?}
+     *   If true, the code is known to be unchanged since the last version
+     *   was saved, so the detail and notes are simply added as notes to that
+     *   version.
      *
      * @return {Number}
      *   Zero upon success; non-zero otherwise
@@ -95,184 +145,88 @@ qx.Mixin.define("playground.dbif.MFiles",
      * @ignore(nodesqlite.Application.config)
      * @ignore(nodesqlite.Application.config.*)
      */
-    _saveProgram : function(programName, detail, code, notes)
+    _saveProgram : function(programName, detail, code, notes,
+                            userId, bUnchanged)
     {
       var             user;
-      var             ret;
-      var             whoAmI;
-      var             process;
-      var             exitValue;
-      var             reader;
-      var             writer;
-      var             line;
-      var             cmd;
-      var             hash;
+      var             saved;
       var             mailOptions;
       var             userFilesDir = playground.dbif.MFiles.UserFilesDir;
       var             progDir = playground.dbif.MFiles.ProgDir;
+      var             userDir;
       var             gitDir;
       var             System = liberated.dbif.System;
+      var             SnapshotStore = playground.dbif.SnapshotStore;
       
 
-      // Retrieve the current user id
-      whoAmI = this.getWhoAmI();
-      user = whoAmI.userId;
+      // Retrieve the user id, if not provided
+      user = userId || this.getWhoAmI().userId;
       
       // Sanitize the name
       programName = this.__sanitizeFilename(programName);
 
-      // Create the git directory name
-      gitDir = 
-        userFilesDir + "/" + user + "/" + progDir + "/" + programName + ".git";
-
-      // Be sure the file's git directory has been created
-      System.system( [ "mkdir", "-p", gitDir ], { showStdout : true } );
-
-      // Write the code to a file with the given name
-      try
-      {
-        System.writeFile(gitDir + "/" + programName, 
-                         code,
-                         {
-                           encoding : "utf8"
-                         });
-      }
-      catch (e)
-      {
-        console.log("\n\nFailed to create user code at " + 
-                    gitDir + "/" + programName + 
-                    ": " + e + "\n\n");
-      }
-
-      // Create the git repository
-      System.system( [ "git", "init" ], 
-                     {
-                       cwd        : gitDir,
-                       showStdout : true
-                     } );
-      
-      // Identify the user
-      System.system( [ 
-                       "git",
-                       "config",
-                       "user.name",
-                       /* whoAmI.displayName || */ "user " + whoAmI.userId
-                     ],
-                     {
-                       cwd        : gitDir,
-                       showStdout : true
-                     } );
-      
-      // and his email address
-      System.system( [ 
-                       "git",
-                       "config",
-                       "user.email",
-                       /* whoAmI.email || */ "anonymous@noplace.at.all"
-                     ],
-                     {
-                       cwd        : gitDir,
-                       showStdout : true
-                     } );
-
-      // Add the file to this git repository
-      System.system( [ "git", "add", programName ],
-                     {
-                       cwd        : gitDir,
-                       showStdout : true
-                     } );
+      // Create the program's directory name. (It retains the ".git" suffix
+      // from when each program's history was kept in a git repository.)
+      userDir = userFilesDir + "/" + user;
+      gitDir = userDir + "/" + progDir + "/" + programName + ".git";
 
       if (typeof detail == "object")
       {
         detail = qx.lang.Json.stringify(detail);
       }
 
-      // Commit the file
-      process = System.system(
-        [
-          "git",
-          "commit",
-          "-m",
-          detail,
-          "--",
-          programName
-        ],
-        { 
-          cwd        : gitDir,
-          showStdout : true
-        } );
-
-      // Did the commit succeed?
-      if (process.exitCode == 0)
+      try
       {
-        // Yup. Were notes specified?
-        if (notes)
+        // If the code is unchanged, there's nothing to write
+        if (bUnchanged)
         {
-          // Yup. Add a Notes entry to show that it was copied
-          System.system(
-            [ 
-              "git",
-              "notes",
-              "append",
-              "-m", 
-              notes + "\n-----\n"
-            ],
-            { 
-              cwd        : gitDir,
-              showStdout : true
-            } );
+          SnapshotStore.addNotes(userDir,
+                                 programName,
+                                 detail + (notes ? "\n" + notes : ""));
         }
-      }
-      else
-      {
-        console.log(process.stderr);
-        
-        // Check out the most recent version
-        System.system(
-          [
-            "git",
-            "checkout",
-            programName
-          ],
-          { 
-            cwd        : gitDir,
-            showStdout : true
-          });
-        
-        // Append the commit message as notes
-        System.system(
-          [ 
-            "git",
-            "notes",
-            "append",
-            "-m", 
-            detail + (notes ? "\n" : "\n-----\n")
-          ],
-          { 
-            cwd        : gitDir,
-            showStdout : true
-          } );
-
-          // Were notes specified too?
-          if (notes)
+        else
+        {
+          // Be sure the program's directory has been created
+          SnapshotStore.mkdirs(gitDir);
+
+          // Write the code to a file with the given name
+          System.writeFile(gitDir + "/" + programName, 
+                           code,
+                           {
+                             encoding : "utf8"
+                           });
+
+          // Save this version. If the code is unchanged since the last
+          // version, the detail and notes are added as notes to that
+          // version.
+          saved = SnapshotStore.save(userDir, programName, code, detail, notes);
+
+          // Add the program, or its new version, to the directory index
+          if (saved.bNewVersion)
           {
-            // Yup. Add a Notes entry to show that it was copied
-            System.system(
-              [ 
-                "git",
-                "notes",
-                "append",
-                "-m", 
-                notes + "\n-----\n"
-              ],
-              { 
-                cwd        : gitDir,
-                showStdout : true
-              } );
+            this.__changeDirectoryIndex(
+              user,
+              function(index)
+              {
+                index.programs[programName] = true;
+                if (index.versions[programName])
+                {
+                  index.versions[programName].unshift(
+                    {
+                      hash : saved.hash,
+                      time : saved.time
+                    });
+                }
+              });
           }
+        }
+      }
+      catch (e)
+      {
+        console.log("\n\nFailed to save user code at " + 
+                    gitDir + "/" + programName + 
+                    ": " + e + "\n\n");
       }
-      
-      console.log("\n");
 
       if (detail == "exit_crash" &&
           /"exit_crash":"Internal error/.test(notes) &&
@@ -335,28 +289,81 @@ qx.Mixin.define("playground.dbif.MFiles",
       return name;
     },
 
+    /**
+     * Describe how long ago a version was saved, in the same form as git's
+     * relative dates, so that versions from the snapshot store read the same
+     * as those listed from older git repositories.
+     *
+     * @param time {Number}
+     *   The time at which the version was saved, in milliseconds
+     *
+     * @return {String}
+     *   A description such as "3 hours ago"
+     */
+    __relativeDate : function(time)
+    {
+      var             unit;
+      var             count;
+      var             seconds;
+      var             units =
+        [
+          { name : "second", limit : 90,          seconds : 1           },
+          { name : "minute", limit : 90 * 60,     seconds : 60          },
+          { name : "hour",   limit : 36 * 3600,   seconds : 3600        },
+          { name : "day",    limit : 14 * 86400,  seconds : 86400       },
+          { name : "week",   limit : 70 * 86400,  seconds : 7 * 86400   },
+          { name : "month",  limit : 365 * 86400, seconds : 30 * 86400  },
+          { name : "year",   limit : Infinity,    seconds : 365 * 86400 }
+        ];
+
+      seconds = Math.max(0, Math.round(((new Date()).getTime() - time) / 1000));
+
+      // Find the first unit in which the age is expressed reasonably
+      for (unit = 0; seconds >= units[unit].limit; unit++)
+      {
+        // nothing more to do
+      }
+
+      count = Math.round(seconds / units[unit].seconds);
+      return (count + " " + units[unit].name + (count == 1 ? "" : "s") +
+              " ago");
+    },
+
     /**
      * Obtain a directory listing.
      *
      * @param versionsOfFilename {String?}
      *   The name of the file, in My Programs, for which versions are requested
      *
-     * @return {Map}
-     *   A map containing the elements programs, userFiles, and optionally,
-     *   templates and instructorFiles. Each is an array of files in the
-     *   specified category.
+     * @return {Array}
+     *   The files in each category (My Programs, My Files, and the
+     *   templates available to this user), and the versions of the requested
+     *   program, sorted by category and name.
      */
     getDirectoryListing : function(versionsOfFilename)
+    {
+      return this._getDirectoryListing(versionsOfFilename).dirList;
+    },
+
+    /**
+     * Obtain a directory listing, and the entity tag identifying it. The
+     * listing is built from the user's directory index, so no directories
+     * are read unless the index has expired.
+     *
+     * @param versionsOfFilename {String?}
+     *   The name of the file, in My Programs, for which versions are requested
+     *
+     * @return {Map}
+     *   The directory listing (dirList), as returned by
+     *   getDirectoryListing(), and the entity tag (etag). The entity tag
+     *   changes whenever the listing may have.
+     */
+    _getDirectoryListing : function(versionsOfFilename)
     {
       var             dirList = [];
       var             user;
-      var             userData;
-      var             userFilesDir = playground.dbif.MFiles.UserFilesDir;
-      var             dataDir = playground.dbif.MFiles.DataDir;
-      var             progDir = playground.dbif.MFiles.ProgDir;
-      var             templateDir = playground.dbif.MFiles.TemplateDir;
-      var             defaultUser = playground.dbif.MFiles.DefaultUser;
-      var             System = liberated.dbif.System;
+      var             index;
+      var             MFiles = playground.dbif.MFiles;
 
       // Assume no files are available, initially.
       var defaultDirList =
@@ -367,110 +374,178 @@ qx.Mixin.define("playground.dbif.MFiles",
           }
         ];
 
+      // Retrieve the current user id
+      user = this.getWhoAmI().userId;
+
+      // Get the user's directory index
+      index = this.__getDirectoryIndex(user);
+
+      // Add the user's programs
+      Object.keys(index.programs).forEach(
+        function(name)
+        {
+          // Are we getting versions of this file?
+          if (name == versionsOfFilename)
+          {
+            // Yup. List each version, most recent first.
+            this.__getVersions(index, user, name).forEach(
+              function(version, versionNum)
+              {
+                dirList.push(
+                  {
+                    name       : (versionNum == 0 
+                                  ? name
+                                  : (name + " -" + versionNum + ", " +
+                                     this.__relativeDate(version.time) +
+                                     (version.subject
+                                      ? " (" + version.subject + ")"
+                                      : ""))),
+                    origName   : name,
+                    hash       : (versionNum == 0 ? null : version.hash),
+                    versionNum : versionNum,
+                    category   : "My Programs",
+                    user       : user
+                  });
+              },
+              this);
+          }
+          else
+          {
+            dirList.push(
+              {
+                name       : name,
+                origName   : name,
+                hash       : null,
+                versionNum : 0,
+                category   : "My Programs",
+                user       : user
+              });
+          }
+        },
+        this);
+
+      // Add the user's files and the templates
+      dirList = dirList.concat(index.files);
+
+      // If we haven't added anything to the directory listing...
+      if (dirList.length === 0)
+      {
+        // ... then use the default directory list
+        dirList = defaultDirList;
+      }
+
+      // Sort the directory listing by name category then name
+      dirList.sort(
+        function(a, b)
+        {
+          if (a.category != b.category)
+          {
+            return (a.category < b.category 
+                    ? -1 
+                    : (a.category > b.category
+                       ? 1
+                       : 0));
+          }
+          
+          return (a.name < b.name
+                  ? -1
+                  : (a.name > b.name
+                     ? 1
+                     : 0));
+        });
+
+      return (
+        {
+          dirList : dirList,
+          etag    : (MFiles.__startTime + "-" + index.generation + "-" +
+                     (versionsOfFilename || ""))
+        });
+    },
+
+    /**
+     * Retrieve a user's directory index, building it if it isn't available
+     * or has expired.
+     *
+     * @param user {String}
+     *   The user id
+     *
+     * @return {Map}
+     *   The directory index, containing:
+     *     programs   - a map whose keys are the names of the user's programs
+     *     files      - directory listing entries for the user's files and
+     *                  the templates available to the user
+     *     versions   - a map of the versions of programs, by program name,
+     *                  for those which have been requested
+     *     generation - a number which changes whenever the index does
+     *     time       - the time at which the index was built
+     */
+    __getDirectoryIndex : function(user)
+    {
+      var             index;
+      var             userData;
+      var             MFiles = playground.dbif.MFiles;
+      var             userFilesDir = MFiles.UserFilesDir;
+      var             dataDir = MFiles.DataDir;
+      var             progDir = MFiles.ProgDir;
+      var             templateDir = MFiles.TemplateDir;
+      var             defaultUser = MFiles.DefaultUser;
+      var             System = liberated.dbif.System;
+
+      // Do we have a current index?
+      index = MFiles.__directoryIndexes[user];
+      if (index &&
+          (new Date()).getTime() - index.time < MFiles.DirectoryIndexLifetime)
+      {
+        // Yup. Use it.
+        return index;
+      }
+
+      index =
+        {
+          programs   : {},
+          files      : [],
+          versions   : {},
+          generation : ++MFiles.__directoryIndexGeneration,
+          time       : (new Date()).getTime()
+        };
 
       var addFiles = function(dirData)
       {
-        var             i;
         var             files;
-        var             name;
-        var             gitDir;
-        var             process;
-        var             reader;
-        var             line;
-        var             lines;
-        var             hash;
-        var             versionDate;
-        var             versionNum;
 
         // Obtain its files (if any).
-        files = System.readdir(dirData.name);
+        files = System.readdir(dirData.name) || [];
 
-        // Was it a directory?
-        if (files != null)
-        {
-          // Yup. Enumerate any files within.
-          for (i = 0; i < files.length; i++)
+        // Enumerate any files within.
+        files.forEach(
+          function(name)
           {
-            // Retrieve the file name
-            name = files[i];
-
             // If we're in the program directory, the name ends with ".git",
             // and we must strip that off.
             if (dirData.category == "My Programs")
             {
               // Exclude any "removed" files (they end with .git.<timestamp>)
-              if (name.match(/\.git\.[0-9]+$/))
+              if (! name.match(/\.git\.[0-9]+$/))
               {
-                continue;
+                // Strip off the git suffix, for display
+                index.programs[name.replace(/\.git$/, "")] = true;
               }
-
-              // Strip off the git suffix, for display
-              name = name.replace(/\.git$/, "");
+              return;
             }
 
-            // Are we getting versions of this file?
-            if (dirData.category == "My Programs" && name == versionsOfFilename)
-            {
-              // Yup. Build the full path for the git directory name
-              gitDir = dirData.name + "/" + name + ".git";
-
-              // Retrieve the timestamp and subject of every version. 
-              process = System.system(
-                [ 
-                  "git",
-                  "log",
-                  "--format=format:%h/%cr (%s)"
-                ],
-                { 
-                  cwd        : gitDir,
-                  showStdout : true
-                } );
-
-              // Split lines into an array
-              lines = process.stdout.split("\n");
-
-              // Read each line, and add an entry to the directory list
-              for (versionNum = 0; versionNum < lines.length; ++versionNum)
+            // Add this file's name to the index
+            index.files.push(
               {
-                // Extract the hash and version date portions
-                line = lines[versionNum].split("/");
-                hash = line[0];
-                versionDate = line[1];
-
-                dirList.push(
-                  {
-                    name       : (versionNum == 0 
-                                  ? name
-                                  : (name + " -" + versionNum +
-                                     ", " + versionDate)),
-                    origName   : name,
-                    hash       : (versionNum == 0 ? null : hash),
-                    versionNum : versionNum,
-                    category   : dirData.category,
-                    user       : dirData.user
-                  });
-              }
-            }
-            else
-            {
-              // Add this file's name to the map to be returned
-              dirList.push(
-                {
-                  name       : name,
-                  origName   : name,
-                  hash       : null,
-                  versionNum : 0,
-                  category   : dirData.category,
-                  user       : dirData.user
-                });
-            }
-          }
-        }
-      }.bind(this);
+                name       : name,
+                origName   : name,
+                hash       : null,
+                versionNum : 0,
+                category   : dirData.category,
+                user       : dirData.user
+              });
+          });
+      };
 
-      // Retrieve the current user id
-      user = this.getWhoAmI().userId;
-      
       // Add the user's own programs and files, and standard templates
       [
         {
@@ -537,34 +612,114 @@ qx.Mixin.define("playground.dbif.MFiles",
             });
         });
 
-      // If we haven't added anything to the directory listing...
-      if (dirList.length === 0)
+      MFiles.__directoryIndexes[user] = index;
+      return index;
+    },
+
+    /**
+     * Retrieve the versions of a program, from the directory index if
+     * they've been retrieved before.
+     *
+     * @param index {Map}
+     *   The user's directory index
+     *
+     * @param user {String}
+     *   The user id
+     *
+     * @param name {String}
+     *   The program name
+     *
+     * @return {Array}
+     *   The versions, most recent first. Each is a map containing its hash
+     *   (hash), the time it was saved (time, in milliseconds), and, for
+     *   those from an older git repository, its commit subject (subject).
+     */
+    __getVersions : function(index, user, name)
+    {
+      var             gitDir;
+      var             process;
+      var             versions;
+      var             MFiles = playground.dbif.MFiles;
+      var             System = liberated.dbif.System;
+
+      // Have we already retrieved them?
+      if (index.versions[name])
       {
-        // ... then use the default directory list
-        dirList = defaultDirList;
+        // Yup.
+        return index.versions[name];
       }
 
-      // Sort the directory listing by name category then name
-      dirList.sort(
-        function(a, b)
-        {
-          if (a.category != b.category)
+      // List the versions in the snapshot store
+      versions = playground.dbif.SnapshotStore.getVersions(
+        MFiles.UserFilesDir + "/" + user, name).map(
+          function(version)
           {
-            return (a.category < b.category 
-                    ? -1 
-                    : (a.category > b.category
-                       ? 1
-                       : 0));
-          }
-          
-          return (a.name < b.name
-                  ? -1
-                  : (a.name > b.name
-                     ? 1
-                     : 0));
-        });
+            return { hash : version.hash, time : version.time };
+          });
+
+      // Build the full path for the git directory name
+      gitDir = (MFiles.UserFilesDir + "/" + user + "/" + MFiles.ProgDir + "/" +
+                name + ".git");
 
-      return dirList;
+      // Older versions may have been saved in a git repository, before there
+      // was a snapshot store. Do we have one?
+      if (System.fileExists(gitDir + "/.git"))
+      {
+        // Yup. Retrieve the hash, timestamp, and subject of every version.
+        // They follow any versions in the snapshot store.
+        process = System.system(
+          [ 
+            "git",
+            "log",
+            "--format=format:%h/%ct/%s"
+          ],
+          { 
+            cwd        : gitDir,
+            showStdout : true
+          } );
+
+        process.stdout.split("\n").forEach(
+          function(line)
+          {
+            var             fields = line.split("/");
+
+            if (! line)
+            {
+              return;
+            }
+
+            versions.push(
+              {
+                hash    : fields[0],
+                time    : fields[1] * 1000,
+                subject : fields.slice(2).join("/")
+              });
+          });
+      }
+
+      index.versions[name] = versions;
+      return versions;
+    },
+
+    /**
+     * Update a user's directory index, if it's been built
+     *
+     * @param user {String}
+     *   The user id
+     *
+     * @param fChange {Function}
+     *   Function which updates the index. It is passed the index.
+     */
+    __changeDirectoryIndex : function(user, fChange)
+    {
+      var             MFiles = playground.dbif.MFiles;
+      var             index = MFiles.__directoryIndexes[user];
+
+      if (index)
+      {
+        fChange(index);
+        index.generation = ++MFiles.__directoryIndexGeneration;
+      }
     },
 
     /**
@@ -575,7 +730,8 @@ qx.Mixin.define("playground.dbif.MFiles",
      *
      * @param category {String}
      *   The category in which this program is contained. If "My Programs"
-     *   then we find the program in its git directory; otherwise, not.
+     *   then old versions are found in the snapshot store; otherwise, there
+     *   are no old versions.
      *
      * @param hash {String|null}
      *   The hash of a version of the program, or null to request most recent
@@ -685,18 +841,13 @@ qx.Mixin.define("playground.dbif.MFiles",
             // Are they requesting an old (non-HEAD) version?
             if (hash)
             {
-              // Yup. Extract that version.
-              System.system(
-                [ 
-                  "git",
-                  "checkout",
-                  "-f",
-                  hash
-                ],
-                { 
-                  cwd        : dir,
-                  showStdout : true
-                } );
+              // Yup. Retrieve it, without disturbing the current file.
+              code = this.__getVersion(userId, programName, dir, hash);
+              if (code === null)
+              {
+                throw new Error("Internal error: version " + hash +
+                                " of " + programName + " not found");
+              }
             }
           }
           else
@@ -722,7 +873,10 @@ qx.Mixin.define("playground.dbif.MFiles",
         // listing to find out its current name.
         try
         {
-          code = System.readFile(dir + "/" + programName);
+          if (typeof code != "string")
+          {
+            code = System.readFile(dir + "/" + programName);
+          }
         }
         catch(e)
         {
@@ -754,23 +908,6 @@ qx.Mixin.define("playground.dbif.MFiles",
           code = System.readFile(dir + "/" + files[0]);
         }
 
-        // Do we need to revert to HEAD?
-        if (userId === user && category == "My Programs" && hash)
-        {
-          // Yup. Revert to HEAD
-          System.system(
-            [ 
-              "git",
-              "checkout",
-              "-f",
-              "master"
-            ],
-            { 
-              cwd        : dir,
-              showStdout : true
-            } );
-        }
-
         ret =
           {
             name : programName,
@@ -809,7 +946,131 @@ qx.Mixin.define("playground.dbif.MFiles",
           });
       }
     },
-    
+
+    /**
+     * Retrieve an old version of a program. The program's current file is
+     * never touched, so this may be done concurrently with other retrievals
+     * and with saves.
+     *
+     * @param userId {String}
+     *   The user id of the program's owner
+     *
+     * @param programName {String}
+     *   The (sanitized) program name
+     *
+     * @param dir {String}
+     *   The program's directory, which may contain a git repository of
+     *   versions saved before there was a snapshot store
+     *
+     * @param hash {String}
+     *   The hash of the version, as provided in the directory listing
+     *
+     * @return {String|null}
+     *   The code of that version, or null if it's not found
+     */
+    __getVersion : function(userId, programName, dir, hash)
+    {
+      var             key;
+      var             code;
+      var             files;
+      var             process;
+      var             oldest;
+      var             MFiles = playground.dbif.MFiles;
+      var             cache = MFiles.__versionCache;
+      var             System = liberated.dbif.System;
+
+      // Have we retrieved this version recently?
+      key = userId + "/" + programName + "/" + hash;
+      if (key in cache)
+      {
+        // Yup. Re-add it, so that the least recently requested is first.
+        code = cache[key];
+        delete cache[key];
+        cache[key] = code;
+        return code;
+      }
+
+      // Look in the snapshot store
+      code = playground.dbif.SnapshotStore.getObject(
+        MFiles.UserFilesDir + "/" + userId, hash);
+
+      // If it's not there, it may be in an older git repository. Ensure the
+      // hash can't be taken as an option or a revision expression.
+      if (code === null &&
+          /^[0-9a-f]{4,40}$/.test(hash) &&
+          System.fileExists(dir + "/.git"))
+      {
+        try
+        {
+          // Find the file in that version. It may have had an older name.
+          process = System.system(
+            [
+              "git",
+              "ls-tree",
+              "--name-only",
+              hash
+            ],
+            {
+              cwd        : dir,
+              showStdout : true
+            } );
+
+          files = (process.stdout || "").split("\n").filter(
+            function(name)
+            {
+              return name && name.substr(0, 1) != '.';
+            });
+
+          if (files.indexOf(programName) == -1 && files.length == 1)
+          {
+            programName = files[0];
+          }
+
+          // Read the file from that version, without checking it out
+          if (files.indexOf(programName) != -1)
+          {
+            process = System.system(
+              [
+                "git",
+                "show",
+                hash + ":" + programName
+              ],
+              {
+                cwd        : dir,
+                showStdout : true
+              } );
+
+            code = process.stdout || "";
+          }
+        }
+        catch(e)
+        {
+          code = null;
+        }
+      }
+
+      // If we didn't find it, there's nothing to retain
+      if (code === null)
+      {
+        return null;
+      }
+
+      // If we're retaining too many, discard the least recently requested
+      if (MFiles.__versionCacheCount >= MFiles.VersionCacheSize)
+      {
+        for (oldest in cache)
+        {
+          delete cache[oldest];
+          --MFiles.__versionCacheCount;
+          break;
+        }
+      }
+
+      cache[key] = code;
+      ++MFiles.__versionCacheCount;
+      return code;
+    },
+
     /**
      * Rename a program
      * 
@@ -846,6 +1107,10 @@ qx.Mixin.define("playground.dbif.MFiles",
       dir = userFilesDir + "/" + user + "/" + progDir;
 
 
+      // Write any queued snapshots of the program now. Written later, they
+      // would recreate it under its old name.
+      playground.dbif.UsageDetailQueue.flushProgram(this, user, oldName);
+
       // Protect from malicious use of the old and new file names
       oldName = this.__sanitizeFilename(oldName);
       newName = this.__sanitizeFilename(newName);
@@ -857,42 +1122,28 @@ qx.Mixin.define("playground.dbif.MFiles",
         return { status : 1 };
       }
 
-      // Move the source file
-      System.system(
-        [ 
-          "git",
-          "mv",
-          oldName,
-          newName
-        ],
-        {
-          cwd        : dir + "/" + newName + ".git",
-          showStdout : true
-        });
+      // Rename the source file within it. (Its old name may no longer be
+      // there, if it was renamed in an older git repository, so failure is
+      // ignored.)
+      System.rename(dir + "/" + newName + ".git/" + oldName,
+                    dir + "/" + newName + ".git/" + newName);
 
-      // Add the renamed file
-      System.system(
-        [ 
-          "git",
-          "add",
-          newName
-        ],
-        {
-          cwd        : dir + "/" + newName + ".git",
-          showStdout : true
-        });
+      // Its history goes with it
+      playground.dbif.SnapshotStore.rename(
+        userFilesDir + "/" + user, oldName, newName);
 
-      // Commit the move
-      System.system(
-        [ 
-          "git",
-          "commit",
-          "-m",
-          "Renamed source file"
-        ],
+      // Update the directory index
+      this.__changeDirectoryIndex(
+        user,
+        function(index)
         {
-          cwd        : dir + "/" + newName + ".git",
-          showStdout : true
+          delete index.programs[oldName];
+          index.programs[newName] = true;
+          if (index.versions[oldName])
+          {
+            index.versions[newName] = index.versions[oldName];
+            delete index.versions[oldName];
+          }
         });
 
       // Save the program
@@ -944,6 +1195,10 @@ qx.Mixin.define("playground.dbif.MFiles",
       dir = userFilesDir + "/" + user + "/" + progDir;
 
 
+      // Write any queued snapshots of the program now. Written later, they
+      // would recreate it.
+      playground.dbif.UsageDetailQueue.flushProgram(this, user, name);
+
       // Protect from malicious use of the file name
       name = this.__sanitizeFilename(name);
 
@@ -968,6 +1223,19 @@ qx.Mixin.define("playground.dbif.MFiles",
                                  dir + "/" + newName);
       } while (! bRenamed);
 
+      // Retain its history, by the same name, so it's available for research
+      playground.dbif.SnapshotStore.rename(
+        userFilesDir + "/" + user, name, newName);
+
+      // Remove it from the directory index
+      this.__changeDirectoryIndex(
+        user,
+        function(index)
+        {
+          delete index.programs[name];
+          delete index.versions[name];
+        });
+
       // Give 'em a new directory listing
       return (
         {
@@ -1011,6 +1279,13 @@ qx.Mixin.define("playground.dbif.MFiles",
       // Retrieve the current user id
       user = this.getWhoAmI().userId;
       
+      // Write any queued snapshots of the program now, so that the copy
+      // begins with its most recent version
+      if (fromUserId === user)
+      {
+        playground.dbif.UsageDetailQueue.flushProgram(this, user, fromName);
+      }
+
       // Protect from malicious use of the file names
       fromName = this.__sanitizeFilename(fromName);
       toName = this.__sanitizeFilename(toName);
@@ -1057,94 +1332,60 @@ qx.Mixin.define("playground.dbif.MFiles",
         isGit = false;
       }
 
-      // Is the source already a git repository?
-      if (! isGit)
-      {
-        // No. Read the existing file and treat it as a brand new file for
-        // this user.
-        try
-        {
-          // ... then read the source file
-          code = System.readFile(fromDir + "/" + fromName);
-          
-          // Now we can treat this as a brand new file with no git history
-          this._saveProgram(toName, "copied", code);
-        }
-        catch (e)
-        {
-          console.log("\n\nFailed to copy user's code " + ": " + e + "\n\n");
-        }
-      }
-      else
+      try
       {
-        // We're copying an existing git directory to a new one.
-        // Clone the original git directory to the new one.
-        System.system(
-          [ 
-            "git",
-            "clone",
-            fromDir,
-            toDir
-          ],
-          {
-            showStdout : true
-          });
-
-        // Rename the file
-        System.system(
-          [ 
-            "git",
-            "mv",
-            fromName,
-            toName
-          ],
-          {
-            cwd        : toDir,
-            showStdout : true
-          });
+        // Read the source file
+        code = System.readFile(fromDir + "/" + fromName);
 
-        // Add the renamed file
-        System.system(
-          [ 
-            "git",
-            "add",
-            toName
-          ],
+        // If we're copying one of the user's own programs, the copy begins
+        // with its history. Otherwise, it's a brand new file with no history.
+        if (isGit)
+        {
+          playground.dbif.SnapshotStore.copy(
+            userFilesDir + "/" + user, fromName, toName);
+
+          // Older versions may have been saved in a git repository, before
+          // there was a snapshot store. If so, the copy gets a clone of it.
+          // Nothing need be checked out; versions are read from the
+          // repository itself.
+          if (System.fileExists(fromDir + "/.git"))
           {
-            cwd        : toDir,
-            showStdout : true
-          });
+            System.system(
+              [
+                "git",
+                "clone",
+                "--no-checkout",
+                fromDir,
+                toDir
+              ],
+              {
+                showStdout : true
+              });
+          }
+        }
 
-        // Commit the move
-        System.system(
-          [ 
-            "git",
-            "commit",
-            "-m",
-            "Renamed source file"
-          ],
+        // Save the copy, noting from where it was copied
+        this._saveProgram(toName,
+                          "copied",
+                          code,
+                          ("copied from file: " + 
+                           "name: " + fromName + ", " +
+                           "user: " + fromUserId + ", " +
+                           "category: " + fromCategory));
+
+        // If it was copied with its history, saving it created no new
+        // version, so add it to the directory index
+        this.__changeDirectoryIndex(
+          user,
+          function(index)
           {
-            cwd        : toDir,
-            showStdout : true
+            index.programs[toName] = true;
           });
       }
-
-      // Add a Notes entry to show that it was copied
-      System.system(
-        [ 
-          "git",
-          "notes",
-          "append",
-          "-m", 
-          ("copied from file: " + 
-           "name: " + fromName + ", " +
-           "user: " + fromUserId + ", " +
-           "category: " + fromCategory) + "\n-----\n"
-        ],
-        {
-          cwd        : toDir,
-          showStdout : true
-        });
+      catch (e)
+      {
+        console.log("\n\nFailed to copy user's code " + ": " + e + "\n\n");
+      }
 
       return (
         {
@@ -139,6 +139,9 @@ qx.Mixin.define("playground.dbif.MSettings",
           // Save this user
           userObj.put();
 
+          // His templates may have changed
+          playground.dbif.MFiles.invalidateDirectoryIndex(userId);
+
           return 0;
         }.bind(this));
     }
@@ -16,161 +16,322 @@ qx.Mixin.define("playground.dbif.MUsageDetail",
     // Initialize a user
     this.registerService("learncs.usageDetail",
                          this.usageDetail,
-                         [ "data" ]);
+                         [ "data", "listingEtag" ]);
+  },
+
+  statics :
+  {
+    /** Maximum number of programs' most recent snapshots to retain */
+    MaxSnapshots : 2000,
+
+    /**
+     * The most recent snapshot received for each user's program, against
+     * which deltas are applied. Each is a map containing the snapshot (text)
+     * and its hash (hash), keyed by user id and program name.
+     */
+    __snapshots : {},
+
+    /** Number of snapshots retained */
+    __snapshotCount : 0,
+
+    /**
+     * Reconstruct a snapshot from a delta
+     *
+     * @param key {String}
+     *   The key identifying the user's program
+     *
+     * @param delta {Map}
+     *   The delta, as created by playground.dbif.SnapshotDelta.create()
+     *
+     * @return {String|null}
+     *   The snapshot, or null if the delta's base isn't the program's most
+     *   recent snapshot, or the delta doesn't reproduce the expected snapshot
+     */
+    __applyDelta : function(key, delta)
+    {
+      var             base = playground.dbif.MUsageDetail.__snapshots[key];
+
+      if (! base || ! delta || base.hash !== delta.base)
+      {
+        return null;
+      }
+
+      return playground.dbif.SnapshotDelta.apply(base.text, delta);
+    },
+
+    /**
+     * Retain a program's most recent snapshot, against which the next delta
+     * will be applied
+     *
+     * @param key {String}
+     *   The key identifying the user's program
+     *
+     * @param text {String}
+     *   The snapshot
+     */
+    __retainSnapshot : function(key, text)
+    {
+      var             oldest;
+      var             MUsageDetail = playground.dbif.MUsageDetail;
+      var             snapshots = MUsageDetail.__snapshots;
+
+      // Re-add this program, so that the least recently updated is first
+      if (key in snapshots)
+      {
+        delete snapshots[key];
+        --MUsageDetail.__snapshotCount;
+      }
+
+      // If we're retaining too many, discard the least recently updated
+      if (MUsageDetail.__snapshotCount >= MUsageDetail.MaxSnapshots)
+      {
+        for (oldest in snapshots)
+        {
+          delete snapshots[oldest];
+          --MUsageDetail.__snapshotCount;
+          break;
+        }
+      }
+
+      snapshots[key] =
+        {
+          text : text,
+          hash : playground.dbif.SnapshotDelta.hash(text)
+        };
+      ++MUsageDetail.__snapshotCount;
+    }
   },
 
   members :
   {
     /**
-     * A usage detail status report
+     * A usage detail status report. The events are queued, to be written
+     * shortly, so that the report can be acknowledged immediately.
      *
      * @param dataList {Array}
      *   Array of usage detail maps. Fields are as in "User-provided" section of
-     *   ObjUsageDetail
+     *   ObjUsageDetail. The snapshot may be provided in full (snapshot), or
+     *   as a change to the program's prior snapshot (snapshotDelta; see
+     *   playground.dbif.SnapshotDelta).
+     *
+     * @param listingEtag {String?}
+     *   The entity tag of the directory listing the client has, as last
+     *   returned, or the empty string if it has none
      * 
-     * @return {Map|null}
+     * @return {Array|Map|null}
      *   If any element of the dataList contains a snapshot, then a directory
      *   listing is returned; otherwise null.
+     *
+     *   If a listingEtag is provided, or any element contains a delta, a map
+     *   is instead returned. It contains the directory listing (dirList),
+     *   which is null if there was no snapshot or the listing is unchanged
+     *   from listingEtag; the listing's entity tag (etag); and an array of
+     *   the names of programs for which a delta couldn't be applied
+     *   (resync). Events carrying those programs' deltas are not
+     *   recorded; the client must resend them with the snapshot in full.
      * 
      * @ignore(nodesqlite.Application)
      */
-    usageDetail : function(dataList, error)
+    usageDetail : function(dataList, listingEtag, error)
     {
-      var             _this = this;
+      var             listing = null;
       var             last = null;
+      var             user = this.getWhoAmI().userId;
+      var             resync = [];
+      var             snapshots;
+      var             bDelta = false;
       var             bNeedDirectoryListing = false;
+      var             MUsageDetail = playground.dbif.MUsageDetail;
+
+      // Older clients don't provide an entity tag
+      if (typeof listingEtag != "string")
+      {
+        listingEtag = null;
+      }
+
+      // Reconstruct each snapshot provided as a change to the prior one. A
+      // program's events are in order, so each delta applies to the
+      // snapshot retained from the one before it.
+      snapshots = dataList.map(
+        function(data)
+        {
+          var             snapshot;
+          var             key;
 
-      return liberated.dbif.Entity.asTransaction(
-        function()
+          // Store any snapshot data, and then delete it from the
+          // object. It's saved in the snapshot store, not in the database.
+          snapshot = data.snapshot;
+          delete data.snapshot;
+
+          // If the snapshot was provided as a change to the prior one,
+          // reconstruct it
+          key = user + "/" + (data.filename || "code.c");
+          if (data.snapshotDelta)
+          {
+            bDelta = true;
+            snapshot = MUsageDetail.__applyDelta(key, data.snapshotDelta);
+
+            // If we couldn't, ask for the full snapshot next time
+            if (snapshot === null && resync.indexOf(data.filename) == -1)
+            {
+              resync.push(data.filename);
+            }
+          }
+
+          // Retain this snapshot, to apply the next delta to
+          if (snapshot)
+          {
+            MUsageDetail.__retainSnapshot(key, snapshot);
+          }
+
+          return snapshot;
+        });
+
+      dataList.forEach(
+        function(data, i)
         {
-          dataList.forEach(
-            function(data)
+          var             error;
+          var             message = null;
+          var             snapshot = snapshots[i];
+          var             detailData;
+          var             messageData;
+          var             mailOptions;
+          var             Application = nodesqlite.Application;
+
+          // The client resends, in full, each event whose program's delta
+          // couldn't be applied. Don't record those events without their
+          // snapshot now.
+          if (data.snapshotDelta)
+          {
+            delete data.snapshotDelta;
+            if (resync.indexOf(data.filename) != -1)
             {
-              var             error;
-              var             message;
-              var             snapshot;
-              var             detailObj;
-              var             detailData;
-              var             messageData;
-              var             mailOptions;
-              var             Application = nodesqlite.Application;
-
-              // Store any snapshot data, and then delete it from the
-              // object. It's saved in git, not in the database.
-              snapshot = data.snapshot;
-              delete data.snapshot;
-
-              // Keep track of any snapshots we found
-              bNeedDirectoryListing = bNeedDirectoryListing || !! snapshot;
-
-              // Create the usage detail object
-              detailObj = new playground.dbif.ObjUsageDetail();
-
-              // Get the object's data
-              detailData = detailObj.getData();
-
-              // Merge the provided members into the new object's data
-              qx.lang.Object.mergeWith(detailData, data, true);
-
-              // Re-add (or overwrite, if the user was nasty), the user id
-              detailData.user = this.getWhoAmI().userId;
-
-              // Copy non-null fields into a new map
-              messageData = {};
-              Object.keys(detailData).forEach(
-                function(key)
-                {
-                  if (detailData[key] !== null)
-                  {
-                    messageData[key] = detailData[key];
-                  }
-                });
+              return;
+            }
+          }
 
-              // Write the usage detail to the database
-              detailObj.put();
+          // Keep track of any snapshots we found
+          bNeedDirectoryListing = bNeedDirectoryListing || !! snapshot;
 
-              // Save the key value
-              messageData.id = detailData.id;
+          // Begin with the fields of a new usage detail object (it is
+          // created when written), so that the time stamp is now
+          detailData = new playground.dbif.ObjUsageDetail().getData();
 
-              // Is there a snapshot to be saved?
-              if (snapshot)
+          // Merge the provided members into the new object's data
+          qx.lang.Object.mergeWith(detailData, data, true);
+
+          // Re-add (or overwrite, if the user was nasty), the user id
+          detailData.user = user;
+
+          // Copy non-null fields into a new map
+          messageData = {};
+          Object.keys(detailData).forEach(
+            function(key)
+            {
+              if (detailData[key] !== null)
               {
-                // Yup. Save it.
-                if (messageData.type == "button_press" && 
-                    messageData.button_press == "Run")
-                {
-                  message = "run";
-                }
-                else if (messageData.type == "error")
-                {
-                  message = messageData.type;
-                  
-                  // We don't need the 'expected' internal error stuff in the
-                  // commit message or notes.
-                  error = qx.lang.Json.parse(messageData.error);
-                  delete error.expected;
-                  messageData.error = qx.lang.Json.stringify(error);
-                }
-                else if (messageData.type == "button_press")
+                messageData[key] = detailData[key];
+              }
+            });
+
+          // Is there a snapshot to be saved?
+          if (snapshot)
+          {
+            // Yup. Determine its detail.
+            if (messageData.type == "button_press" && 
+                messageData.button_press == "Run")
+            {
+              message = "run";
+            }
+            else if (messageData.type == "error")
+            {
+              message = messageData.type;
+
+              // We don't need the 'expected' internal error stuff in the
+              // commit message or notes.
+              error = qx.lang.Json.parse(messageData.error);
+              delete error.expected;
+              messageData.error = qx.lang.Json.stringify(error);
+            }
+            else if (messageData.type == "button_press")
+            {
+              message = messageData.type + ": " + messageData.button_press;
+            }
+            else
+            {
+              message = messageData.type;
+            }
+
+            // Keep track of this most recent message data
+            last = messageData;
+
+            if ("developer" in messageData && messageData.developer)
+            {
+              // Send email
+              mailOptions = 
                 {
-                  message = messageData.type + ": " + messageData.button_press;
-                }
-                else
+                  from    : "LearnCS! <noreply@learn.cs.uml.edu>",
+                  to      : Application.config.developerRecipients,
+                  subject : "Developer debug message",
+                  text    : (snapshot + "\n\n" +
+                             qx.lang.Json.stringify(messageData))
+                };
+
+              // send mail with defined transport object
+              this.sendMail(
+                mailOptions,
+                function(info)
                 {
-                  message = messageData.type;
-                }
-
-                // Save the program
-                _this._saveProgram(
-                  messageData.filename || "code.c", 
-                  message,
-                  snapshot,
-                  qx.lang.Json.stringify(messageData));
-                
-                // Keep track of this most recent message data
-                last = messageData;
-
-                if ("developer" in messageData && messageData.developer)
+                  console.log("Developer message sent to " + 
+                              Application.config.developerRecipients +
+                              ": " + info.response);
+                },
+                function(error, info)
                 {
-                  // Send email
-                  mailOptions = 
-                    {
-                      from    : "LearnCS! <noreply@learn.cs.uml.edu>",
-                      to      : Application.config.developerRecipients,
-                      subject : "Developer debug message",
-                      text    : (snapshot + "\n\n" +
-                                 qx.lang.Json.stringify(messageData))
-                    };
-
-                  // send mail with defined transport object
-                  this.sendMail(
-                    mailOptions,
-                    function(info)
-                    {
-                      console.log("Developer message sent to " + 
-                                  Application.config.developerRecipients +
-                                  ": " + info.response);
-                    },
-                    function(error, info)
-                    {
-                      console.log("Failed to send developer message to " +
-                                  Application.config.developerRecipients +
-                                  ": " + error);
-                    });
-                }
-              }
-            }.bind(this),
-            [],
-            this);
-
-          // If there was any snapshot data, return a new directory listing
-          return bNeedDirectoryListing 
-            ? this.getDirectoryListing(last && last.versions
-                                       ? last.filename
-                                       : null) 
-            : null;
+                  console.log("Failed to send developer message to " +
+                              Application.config.developerRecipients +
+                              ": " + error);
+                });
+            }
+          }
 
+          // Queue the usage detail, and any snapshot, to be written
+          playground.dbif.UsageDetailQueue.enqueue(
+            this,
+            {
+              user        : user,
+              data        : detailData,
+              messageData : messageData,
+              snapshot    : snapshot || null,
+              filename    : messageData.filename || "code.c",
+              message     : message
+            });
         }.bind(this));
+
+      // If there was any snapshot data, get a new directory listing
+      if (bNeedDirectoryListing)
+      {
+        listing = this._getDirectoryListing(last && last.versions
+                                            ? last.filename
+                                            : null);
+      }
+
+      // Older clients expect just the directory listing
+      if (listingEtag === null && ! bDelta)
+      {
+        return listing && listing.dirList;
+      }
+
+      // Others need the listing only if it's changed, and learn of any
+      // snapshots they must resend
+      return (
+        {
+          dirList : (listing && listing.etag !== listingEtag
+                     ? listing.dirList
+                     : null),
+          etag    : listing ? listing.etag : listingEtag,
+          resync  : resync
+        });
     }
   }
 });
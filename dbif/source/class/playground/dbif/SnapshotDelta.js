@@ -0,0 +1,138 @@
+/**
+ * Copyright (c) 2013 Derrell Lipman
+ *
+ * License:
+ *   GPL Version 2: http://www.gnu.org/licenses/gpl-2.0.html
+ */
+
+/**
+ * Compact encoding of a program snapshot as a change to a prior snapshot
+ *
+ * Successive snapshots of a program usually differ in only one region, if
+ * at all. A delta describes that region: the text at [start, start +
+ * remove) of the base snapshot is replaced by insert. The base snapshot,
+ * and the resulting one, are identified by their hashes, so the receiver
+ * can verify that it has the right base and reconstructed the right text.
+ *
+ * This class is used by both the client, to create deltas, and the server,
+ * to apply them.
+ */
+qx.Class.define("playground.dbif.SnapshotDelta",
+{
+  type : "static",
+
+  statics :
+  {
+    /**
+     * Compute the hash identifying a snapshot. This is not cryptographic;
+     * it need only distinguish successive snapshots of a program.
+     *
+     * @param text {String}
+     *   The snapshot
+     *
+     * @return {String}
+     *   The hash, consisting of the text length and a 32-bit FNV-1a hash of
+     *   its characters
+     */
+    hash : function(text)
+    {
+      var             i;
+      var             hash = 0x811c9dc5;
+
+      for (i = 0; i < text.length; i++)
+      {
+        hash ^= text.charCodeAt(i);
+
+        // Multiply by the FNV prime (2^24 + 0x193), modulo 2^32, without
+        // losing precision
+        hash = ((hash << 24) + (hash >>> 0) * 0x193) >>> 0;
+      }
+
+      return text.length + "-" + hash.toString(16);
+    },
+
+    /**
+     * Create a delta describing the change from one snapshot to another
+     *
+     * @param base {String}
+     *   The prior snapshot
+     *
+     * @param baseHash {String}
+     *   The prior snapshot's hash
+     *
+     * @param text {String}
+     *   The new snapshot
+     *
+     * @return {Map}
+     *   The delta, containing the hash of the base snapshot (base), the
+     *   region of the base which changed (start, remove), its replacement
+     *   (insert), and the hash of the new snapshot (hash)
+     */
+    create : function(base, baseHash, text)
+    {
+      var             start = 0;
+      var             baseEnd = base.length;
+      var             textEnd = text.length;
+
+      // Find the common prefix
+      while (start < baseEnd && start < textEnd &&
+             base.charCodeAt(start) == text.charCodeAt(start))
+      {
+        ++start;
+      }
+
+      // Find the common suffix, not overlapping the prefix
+      while (baseEnd > start && textEnd > start &&
+             base.charCodeAt(baseEnd - 1) == text.charCodeAt(textEnd - 1))
+      {
+        --baseEnd;
+        --textEnd;
+      }
+
+      return (
+        {
+          base   : baseHash,
+          start  : start,
+          remove : baseEnd - start,
+          insert : text.substring(start, textEnd),
+          hash   : playground.dbif.SnapshotDelta.hash(text)
+        });
+    },
+
+    /**
+     * Reconstruct a snapshot from its base and a delta
+     *
+     * @param base {String}
+     *   The base snapshot, whose hash is delta.base
+     *
+     * @param delta {Map}
+     *   The delta, as created by create()
+     *
+     * @return {String|null}
+     *   The reconstructed snapshot, or null if the delta is malformed or
+     *   doesn't reproduce the expected snapshot
+     */
+    apply : function(base, delta)
+    {
+      var             text;
+
+      if (typeof delta.start != "number" ||
+          typeof delta.remove != "number" ||
+          typeof delta.insert != "string" ||
+          delta.start < 0 ||
+          delta.remove < 0 ||
+          delta.start + delta.remove > base.length)
+      {
+        return null;
+      }
+
+      text = (base.substr(0, delta.start) +
+              delta.insert +
+              base.substr(delta.start + delta.remove));
+
+      return (playground.dbif.SnapshotDelta.hash(text) == delta.hash
+              ? text
+              : null);
+    }
+  }
+});
@@ -0,0 +1,783 @@
+/**
+ * Copyright (c) 2013 Derrell Lipman
+ *
+ * License:
+ *   GPL Version 2: http://www.gnu.org/licenses/gpl-2.0.html
+ */
+
+/**
+ * Append-only store of program snapshots
+ *
+ * Each version of a user's program is saved here, without spawning any
+ * processes. Each user has a store directory containing:
+ *
+ *   objects/xx/yyyy...  The content of each distinct snapshot, named by its
+ *                       SHA-1 hash (xx being the first two hex digits), so
+ *                       identical snapshots of any of the user's programs
+ *                       are stored only once.
+ *
+ *   logs/<program>      The program's history, one JSON record per line, in
+ *                       the order saved. A version record is
+ *                         { "hash" : <hash>, "time" : <ms>, "detail" : <s> }
+ *                       optionally with "notes". A notes record, appended
+ *                       when notes are added to the most recent version
+ *                       (e.g., when a snapshot is unchanged), is
+ *                         { "time" : <ms>, "notes" : <s> }
+ *
+ * Records are only ever appended, so a log is never rewritten. Renaming or
+ * removing a program renames its log.
+ *
+ * For research, exportGit() materializes a program's history as a git
+ * repository, as was formerly created as each snapshot was saved.
+ *
+ * @ignore(require)
+ * @ignore(Buffer)
+ * @ignore(process)
+ */
+qx.Class.define("playground.dbif.SnapshotStore",
+{
+  type : "static",
+
+  statics :
+  {
+    /** Subdirectory of a user's directory containing the store */
+    StoreDir : "SNAPSHOTS",
+
+    /** Maximum number of logs' most recent version hashes to retain */
+    LastHashCacheSize : 2000,
+
+    /**
+     * The hash of the most recent version in each log, keyed by the log's
+     * path, so that each save needn't read the log
+     */
+    __lastHash : {},
+
+    /** Number of entries in __lastHash */
+    __lastHashCount : 0,
+
+    /**
+     * Save a snapshot of a program. If its content is unchanged from the
+     * program's most recent version, no new version is created; the detail
+     * and notes are instead added as notes to that version.
+     *
+     * @param userDir {String}
+     *   The user's directory
+     *
+     * @param programName {String}
+     *   The (sanitized) program name
+     *
+     * @param code {String}
+     *   The program's code
+     *
+     * @param detail {String}
+     *   Detail information describing this version
+     *
+     * @param notes {String?}
+     *   Notes to be associated with this version
+     *
+     * @return {Map}
+     *   The snapshot's hash (hash), the time at which it was saved (time),
+     *   and whether a new version was created (bNewVersion)
+     */
+    save : function(userDir, programName, code, detail, notes)
+    {
+      var             hash;
+      var             last;
+      var             time = (new Date()).getTime();
+      var             SnapshotStore = playground.dbif.SnapshotStore;
+
+      // Store the content, if it isn't already
+      hash = SnapshotStore.putObject(userDir, code);
+
+      // Has the content changed since the most recent version?
+      last = SnapshotStore.__getLastHash(userDir, programName);
+      if (last == hash)
+      {
+        // Nope. Just add notes to that version.
+        SnapshotStore.addNotes(
+          userDir,
+          programName,
+          detail + (notes ? "\n" + notes : ""));
+        return { hash : hash, time : time, bNewVersion : false };
+      }
+
+      SnapshotStore.__append(
+        userDir,
+        programName,
+        {
+          hash   : hash,
+          time   : time,
+          detail : detail,
+          notes  : notes || undefined
+        });
+
+      return { hash : hash, time : time, bNewVersion : true };
+    },
+
+    /**
+     * Add notes to the most recent version of a program
+     *
+     * @param userDir {String}
+     *   The user's directory
+     *
+     * @param programName {String}
+     *   The (sanitized) program name
+     *
+     * @param notes {String}
+     *   The notes to add
+     */
+    addNotes : function(userDir, programName, notes)
+    {
+      playground.dbif.SnapshotStore.__append(
+        userDir,
+        programName,
+        {
+          time  : (new Date()).getTime(),
+          notes : notes
+        });
+    },
+
+    /**
+     * Retrieve the versions of a program
+     *
+     * @param userDir {String}
+     *   The user's directory
+     *
+     * @param programName {String}
+     *   The (sanitized) program name
+     *
+     * @return {Array}
+     *   The versions, most recent first. Each is a map containing the
+     *   snapshot's hash (hash), the time it was saved (time, in
+     *   milliseconds), its detail (detail), and an array of its notes
+     *   (notes). The array is empty if the program has no versions in the
+     *   store.
+     */
+    getVersions : function(userDir, programName)
+    {
+      var             fs = require("fs");
+      var             text;
+      var             record;
+      var             version = null;
+      var             versions = [];
+
+      try
+      {
+        text = fs.readFileSync(
+          playground.dbif.SnapshotStore.__logPath(userDir, programName),
+          "utf8");
+      }
+      catch(e)
+      {
+        // No log, so no versions
+        return versions;
+      }
+
+      text.split("\n").forEach(
+        function(line)
+        {
+          // Ignore the empty line following the final record, or a partial
+          // record left by a failed write
+          try
+          {
+            record = JSON.parse(line);
+          }
+          catch(e)
+          {
+            return;
+          }
+
+          if (record.hash)
+          {
+            version =
+              {
+                hash   : record.hash,
+                time   : record.time,
+                detail : record.detail,
+                notes  : record.notes ? [ record.notes ] : []
+              };
+            versions.unshift(version);
+          }
+          else if (version && record.notes)
+          {
+            version.notes.push(record.notes);
+          }
+        });
+
+      return versions;
+    },
+
+    /**
+     * Store content, if it's not already stored
+     *
+     * @param userDir {String}
+     *   The user's directory
+     *
+     * @param content {String}
+     *   The content to be stored
+     *
+     * @return {String}
+     *   The content's hash, by which it may be retrieved
+     */
+    putObject : function(userDir, content)
+    {
+      var             hash;
+      var             path;
+      var             tempPath;
+      var             fs = require("fs");
+      var             SnapshotStore = playground.dbif.SnapshotStore;
+
+      hash = require("crypto").createHash("sha1")
+        .update(content, "utf8")
+        .digest("hex");
+
+      path = SnapshotStore.__objectPath(userDir, hash);
+
+      // Identical content is stored only once
+      if (! fs.existsSync(path))
+      {
+        SnapshotStore.mkdirs(path.replace(/\/[^\/]*$/, ""));
+
+        // Write it under a temporary name, so that a partially-written
+        // object is never found under its hash
+        tempPath = path + "." + process.pid + ".tmp";
+        fs.writeFileSync(tempPath, content, "utf8");
+        fs.renameSync(tempPath, path);
+      }
+
+      return hash;
+    },
+
+    /**
+     * Retrieve stored content
+     *
+     * @param userDir {String}
+     *   The user's directory
+     *
+     * @param hash {String}
+     *   The content's hash
+     *
+     * @return {String|null}
+     *   The content, or null if no content with that hash is stored
+     */
+    getObject : function(userDir, hash)
+    {
+      // Don't allow the hash to reach outside of the store
+      if (! /^[0-9a-f]{40}$/.test(hash))
+      {
+        return null;
+      }
+
+      try
+      {
+        return require("fs").readFileSync(
+          playground.dbif.SnapshotStore.__objectPath(userDir, hash),
+          "utf8");
+      }
+      catch(e)
+      {
+        return null;
+      }
+    },
+
+    /**
+     * Rename a program's history
+     *
+     * @param userDir {String}
+     *   The user's directory
+     *
+     * @param oldName {String}
+     *   The (sanitized) current program name
+     *
+     * @param newName {String}
+     *   The (sanitized) new program name
+     */
+    rename : function(userDir, oldName, newName)
+    {
+      var             SnapshotStore = playground.dbif.SnapshotStore;
+
+      // Forget the most recent versions of both. They're re-read when next
+      // needed.
+      SnapshotStore.__forgetLastHash(userDir, oldName);
+      SnapshotStore.__forgetLastHash(userDir, newName);
+
+      try
+      {
+        require("fs").renameSync(SnapshotStore.__logPath(userDir, oldName),
+                                 SnapshotStore.__logPath(userDir, newName));
+      }
+      catch(e)
+      {
+        // There was no history to rename
+      }
+    },
+
+    /**
+     * Copy a program's history to a new program
+     *
+     * @param userDir {String}
+     *   The user's directory
+     *
+     * @param fromName {String}
+     *   The (sanitized) name of the program being copied
+     *
+     * @param toName {String}
+     *   The (sanitized) name of the new program
+     */
+    copy : function(userDir, fromName, toName)
+    {
+      var             fs = require("fs");
+      var             SnapshotStore = playground.dbif.SnapshotStore;
+
+      SnapshotStore.__forgetLastHash(userDir, toName);
+
+      try
+      {
+        // The objects are shared; only the log need be copied
+        fs.writeFileSync(
+          SnapshotStore.__logPath(userDir, toName),
+          fs.readFileSync(SnapshotStore.__logPath(userDir, fromName)));
+      }
+      catch(e)
+      {
+        // There was no history to copy
+      }
+    },
+
+    /**
+     * Create a directory, and any missing parent directories
+     *
+     * @param dir {String}
+     *   The directory path
+     */
+    mkdirs : function(dir)
+    {
+      var             fs = require("fs");
+
+      if (fs.existsSync(dir))
+      {
+        return;
+      }
+
+      playground.dbif.SnapshotStore.mkdirs(dir.replace(/\/[^\/]*$/, ""));
+
+      try
+      {
+        fs.mkdirSync(dir);
+      }
+      catch(e)
+      {
+        // It may have just been created by someone else
+        if (e.code != "EEXIST")
+        {
+          throw e;
+        }
+      }
+    },
+
+    /**
+     * Materialize a program's history as a git repository, with a commit
+     * for each version and its notes as git notes.
+     *
+     * @param userDir {String}
+     *   The user's directory
+     *
+     * @param userId {String}
+     *   The user's id, for the commits' author
+     *
+     * @param programName {String}
+     *   The (sanitized) program name
+     *
+     * @param gitDir {String}
+     *   The directory in which to create the repository. It must not
+     *   already contain one.
+     *
+     * @param callback {Function}
+     *   Function called upon completion. It is passed an error, or null
+     *   upon success.
+     */
+    exportGit : function(userDir, userId, programName, gitDir, callback)
+    {
+      var             mark = 0;
+      var             stream = [];
+      var             notes = [];
+      var             child_process = require("child_process");
+      var             SnapshotStore = playground.dbif.SnapshotStore;
+      var             fileName;
+
+      // Add data to the fast-import stream
+      var data = function(text)
+      {
+        stream.push("data " + Buffer.byteLength(text, "utf8") + "\n",
+                    text,
+                    "\n");
+      };
+
+      // The file is named for the program, even if the program was removed
+      fileName = programName.replace(/\.git\.[0-9]+$/, "");
+
+      // Generate a commit, in chronological order, for each version
+      SnapshotStore.getVersions(userDir, programName).reverse().forEach(
+        function(version)
+        {
+          var             when = Math.floor(version.time / 1000) + " +0000";
+          var             content = SnapshotStore.getObject(userDir,
+                                                            version.hash);
+
+          stream.push("blob\n", "mark :" + (++mark) + "\n");
+          data(content === null ? "" : content);
+
+          stream.push("commit refs/heads/master\n",
+                      "mark :" + (++mark) + "\n",
+                      "committer user " + userId +
+                        " <anonymous@noplace.at.all> " + when + "\n");
+          data(version.detail || "");
+          stream.push("M 100644 :" + (mark - 1) + " " + fileName + "\n\n");
+
+          if (version.notes.length > 0)
+          {
+            notes.push(
+              {
+                mark : mark,
+                text : version.notes.join("\n-----\n") + "\n-----\n",
+                when : when
+              });
+          }
+        });
+
+      // Add the notes, in a single commit on the notes ref
+      if (notes.length > 0)
+      {
+        stream.push("commit refs/notes/commits\n",
+                    "committer user " + userId +
+                      " <anonymous@noplace.at.all> " +
+                      notes[notes.length - 1].when + "\n");
+        data("Notes added by snapshot export");
+        notes.forEach(
+          function(note)
+          {
+            stream.push("N inline :" + note.mark + "\n");
+            data(note.text);
+          });
+        stream.push("\n");
+      }
+
+      // Create the repository, and import the history into it
+      SnapshotStore.mkdirs(gitDir);
+      child_process.execFile(
+        "git",
+        [ "init" ],
+        { cwd : gitDir },
+        function(error)
+        {
+          var             importer;
+
+          if (error)
+          {
+            callback(error);
+            return;
+          }
+
+          importer = child_process.spawn(
+            "git",
+            [ "fast-import", "--quiet" ],
+            { cwd : gitDir, stdio : [ "pipe", "ignore", "inherit" ] });
+
+          importer.on(
+            "exit",
+            function(code)
+            {
+              if (code !== 0)
+              {
+                callback(new Error("git fast-import failed: " + code));
+                return;
+              }
+
+              // Check out the most recent version
+              child_process.execFile(
+                "git",
+                [ "checkout", "-f", "master" ],
+                { cwd : gitDir },
+                function(error)
+                {
+                  callback(error || null);
+                });
+            });
+
+          importer.stdin.end(stream.join(""), "utf8");
+        });
+    },
+
+    /**
+     * Materialize the history of every program of every user as git
+     * repositories, as exportGit() does for one program. The repository for
+     * each program is created at <destDir>/<user id>/<program name>.git.
+     * The histories of removed programs are exported too, named as the
+     * removed program's directory is.
+     *
+     * @param userFilesDir {String}
+     *   The top-level directory containing users' code
+     *
+     * @param destDir {String}
+     *   The directory in which to create the repositories
+     *
+     * @param callback {Function}
+     *   Function called upon completion. It is passed an error, or null
+     *   upon success.
+     */
+    exportAll : function(userFilesDir, destDir, callback)
+    {
+      var             fs = require("fs");
+      var             SnapshotStore = playground.dbif.SnapshotStore;
+      var             programs = [];
+
+      // Find each user's programs with history
+      fs.readdirSync(userFilesDir).forEach(
+        function(userId)
+        {
+          var             userDir = userFilesDir + "/" + userId;
+          var             logDir;
+
+          logDir = userDir + "/" + SnapshotStore.StoreDir + "/logs";
+
+          if (! fs.existsSync(logDir))
+          {
+            return;
+          }
+
+          fs.readdirSync(logDir).forEach(
+            function(programName)
+            {
+              programs.push(
+                {
+                  userDir     : userDir,
+                  userId      : userId,
+                  programName : programName
+                });
+            });
+        });
+
+      // Export them one at a time
+      var next = function(error)
+      {
+        var             program;
+        var             gitDir;
+
+        if (error || programs.length === 0)
+        {
+          callback(error || null);
+          return;
+        }
+
+        program = programs.shift();
+        gitDir = destDir + "/" + program.userId + "/" + program.programName;
+        if (! /\.git\.[0-9]+$/.test(program.programName))
+        {
+          gitDir += ".git";
+        }
+        console.log("Exporting " + gitDir);
+        SnapshotStore.exportGit(program.userDir,
+                                program.userId,
+                                program.programName,
+                                gitDir,
+                                next);
+      };
+
+      next(null);
+    },
+
+    /**
+     * Append a record to a program's log
+     *
+     * @param userDir {String}
+     *   The user's directory
+     *
+     * @param programName {String}
+     *   The (sanitized) program name
+     *
+     * @param record {Map}
+     *   The record to be appended
+     */
+    __append : function(userDir, programName, record)
+    {
+      var             path;
+      var             SnapshotStore = playground.dbif.SnapshotStore;
+
+      path = SnapshotStore.__logPath(userDir, programName);
+      SnapshotStore.mkdirs(path.replace(/\/[^\/]*$/, ""));
+      require("fs").appendFileSync(path, JSON.stringify(record) + "\n");
+
+      // If this is a new version, it's now the most recent
+      if (record.hash)
+      {
+        SnapshotStore.__rememberLastHash(path, record.hash);
+      }
+    },
+
+    /**
+     * Retrieve the hash of a program's most recent version. If it's not
+     * known from a prior save, only the end of the log is read to find it.
+     *
+     * @param userDir {String}
+     *   The user's directory
+     *
+     * @param programName {String}
+     *   The (sanitized) program name
+     *
+     * @return {String|null}
+     *   The hash, or null if the program has no versions in the store
+     */
+    __getLastHash : function(userDir, programName)
+    {
+      var             fd;
+      var             pos;
+      var             len;
+      var             buf;
+      var             lines;
+      var             i;
+      var             record;
+      var             hash = null;
+      var             chunks = [];
+      var             fs = require("fs");
+      var             SnapshotStore = playground.dbif.SnapshotStore;
+      var             path = SnapshotStore.__logPath(userDir, programName);
+
+      // Have we already got it?
+      if (SnapshotStore.__lastHash.hasOwnProperty(path))
+      {
+        // Yup.
+        return SnapshotStore.__lastHash[path];
+      }
+
+      try
+      {
+        fd = fs.openSync(path, "r");
+      }
+      catch(e)
+      {
+        // No log, so no versions
+        return null;
+      }
+
+      try
+      {
+        // Read backward from the end of the log, a block at a time, until
+        // a version record is found
+        for (pos = fs.fstatSync(fd).size; pos > 0 && hash === null; )
+        {
+          len = Math.min(4096, pos);
+          pos -= len;
+          buf = new Buffer(len);
+          fs.readSync(fd, buf, 0, len, pos);
+          chunks.unshift(buf);
+
+          // The first line may be incomplete, unless it begins the log.
+          // Ignore it, and the empty line following the final record, and a
+          // partial record left by a failed write.
+          lines = Buffer.concat(chunks).toString("utf8").split("\n");
+          for (i = lines.length - 1; i >= (pos > 0 ? 1 : 0); i--)
+          {
+            try
+            {
+              record = JSON.parse(lines[i]);
+            }
+            catch(e)
+            {
+              continue;
+            }
+
+            if (record.hash)
+            {
+              hash = record.hash;
+              break;
+            }
+          }
+        }
+      }
+      finally
+      {
+        fs.closeSync(fd);
+      }
+
+      SnapshotStore.__rememberLastHash(path, hash);
+      return hash;
+    },
+
+    /**
+     * Retain the hash of a log's most recent version
+     *
+     * @param path {String}
+     *   The path of the log
+     *
+     * @param hash {String|null}
+     *   The hash of the log's most recent version
+     */
+    __rememberLastHash : function(path, hash)
+    {
+      var             oldest;
+      var             SnapshotStore = playground.dbif.SnapshotStore;
+      var             cache = SnapshotStore.__lastHash;
+
+      // Re-add this log, so that the least recently saved is first
+      if (cache.hasOwnProperty(path))
+      {
+        delete cache[path];
+        --SnapshotStore.__lastHashCount;
+      }
+
+      // If we're retaining too many, discard the least recently saved
+      if (SnapshotStore.__lastHashCount >= SnapshotStore.LastHashCacheSize)
+      {
+        for (oldest in cache)
+        {
+          delete cache[oldest];
+          --SnapshotStore.__lastHashCount;
+          break;
+        }
+      }
+
+      cache[path] = hash;
+      ++SnapshotStore.__lastHashCount;
+    },
+
+    /**
+     * Forget the hash of a program's most recent version, as when its log
+     * is replaced
+     *
+     * @param userDir {String}
+     *   The user's directory
+     *
+     * @param programName {String}
+     *   The (sanitized) program name
+     */
+    __forgetLastHash : function(userDir, programName)
+    {
+      var             SnapshotStore = playground.dbif.SnapshotStore;
+      var             path = SnapshotStore.__logPath(userDir, programName);
+
+      if (SnapshotStore.__lastHash.hasOwnProperty(path))
+      {
+        delete SnapshotStore.__lastHash[path];
+        --SnapshotStore.__lastHashCount;
+      }
+    },
+
+    /**
+     * Generate the path of a program's log
+     */
+    __logPath : function(userDir, programName)
+    {
+      return (userDir + "/" + playground.dbif.SnapshotStore.StoreDir +
+              "/logs/" + programName);
+    },
+
+    /**
+     * Generate the path of a stored object
+     */
+    __objectPath : function(userDir, hash)
+    {
+      return (userDir + "/" + playground.dbif.SnapshotStore.StoreDir +
+              "/objects/" + hash.substr(0, 2) + "/" + hash.substr(2));
+    }
+  }
+});
@@ -0,0 +1,463 @@
+/**
+ * Copyright (c) 2013 Derrell Lipman
+ *
+ * License:
+ *   GPL Version 2: http://www.gnu.org/licenses/gpl-2.0.html
+ */
+
+/**
+ * Write-behind queue of usage detail events
+ *
+ * Usage detail reports are acknowledged as soon as they're received. Their
+ * events are queued here, and written, for all users at once, in a single
+ * transaction, shortly thereafter. A snapshot identical to the one queued
+ * just before it, for the same user and program, is not saved again; its
+ * detail is instead added as notes to that version.
+ *
+ * Before a program is renamed, removed, or copied, its queued events must
+ * be written, via flushProgram(), lest a snapshot written afterward
+ * recreate it under its old name. Before the server exits, all queued
+ * events are written via flushAll().
+ *
+ * Counters of queue depth, flush latency, and events per second are
+ * available via getStatistics(), and are logged periodically.
+ *
+ * @ignore(require)
+ * @ignore(setTimeout)
+ * @ignore(clearTimeout)
+ */
+qx.Class.define("playground.dbif.UsageDetailQueue",
+{
+  type : "static",
+
+  statics :
+  {
+    /** Number of milliseconds between writes of queued events */
+    FlushInterval      : 1000,
+
+    /** Number of milliseconds between logging of statistics */
+    StatisticsInterval : 60000,
+
+    /** Events not yet written */
+    __queue            : [],
+
+    /** Events being written by the flush in progress */
+    __inFlight         : [],
+
+    /** Most recently queued snapshot of each user's program, by key */
+    __lastSnapshot     : {},
+
+    /** Class of which to instantiate a database interface, when writing */
+    __dbifClass        : null,
+
+    /** Whether a flush is scheduled or in progress */
+    __bScheduled       : false,
+
+    /** Whether a flush is in progress */
+    __bFlushing        : false,
+
+    /** The timer of a scheduled flush */
+    __timer            : null,
+
+    /** Function to call once all events are written, if requested */
+    __onFlushed        : null,
+
+    /** Statistics since the server started */
+    __stats            :
+    {
+      events            : 0,
+      coalesced         : 0,
+      dropped           : 0,
+      failed            : 0,
+      flushes           : 0,
+      maxQueueDepth     : 0,
+      lastFlushLatency  : 0,
+      maxFlushLatency   : 0,
+      totalFlushLatency : 0
+    },
+
+    /** Time, and event count, when statistics were last logged */
+    __lastReport       :
+    {
+      time   : (new Date()).getTime(),
+      events : 0
+    },
+
+    /**
+     * Queue a usage detail event to be written
+     *
+     * @param dbif {playground.dbif.MDbifCommon}
+     *   The database interface via which the event was received. A new
+     *   instance of its class is used to write the event.
+     *
+     * @param event {Map}
+     *   The event, containing:
+     *     user        - the user id
+     *     data        - the usage detail data to be written to the database
+     *     messageData - the (non-null) data to be saved as the snapshot's
+     *                   notes, along with the database key once written
+     *     snapshot    - the program's code, or null
+     *     filename    - the program name, if there is a snapshot
+     *     message     - detail describing the snapshot, if there is one
+     */
+    enqueue : function(dbif, event)
+    {
+      var             key;
+      var             UsageDetailQueue = playground.dbif.UsageDetailQueue;
+      var             queue = UsageDetailQueue.__queue;
+      var             stats = UsageDetailQueue.__stats;
+
+      UsageDetailQueue.__dbifClass = dbif.constructor;
+
+      // Is this snapshot identical to the one queued before it?
+      if (event.snapshot)
+      {
+        key = event.user + "/" + event.filename;
+        event.bUnchanged = (UsageDetailQueue.__lastSnapshot[key] ===
+                            event.snapshot);
+        UsageDetailQueue.__lastSnapshot[key] = event.snapshot;
+
+        if (event.bUnchanged)
+        {
+          ++stats.coalesced;
+        }
+      }
+
+      queue.push(event);
+      ++stats.events;
+      stats.maxQueueDepth = Math.max(stats.maxQueueDepth, queue.length);
+
+      // Is there already a flush scheduled (or in progress)?
+      if (UsageDetailQueue.__bScheduled)
+      {
+        // Yup. Nothing more to do right now.
+        return;
+      }
+
+      UsageDetailQueue.__schedule();
+    },
+
+    /**
+     * Retrieve the queue statistics
+     *
+     * @return {Map}
+     *   The number of events not yet written (queueDepth) and the most ever
+     *   awaiting a write (maxQueueDepth); the number of events received
+     *   (events), of snapshots coalesced with the prior one (coalesced), of
+     *   snapshots not saved because their program was renamed or removed
+     *   while they were being written (dropped), and of events which failed
+     *   to be written (failed); and the number of
+     *   flushes (flushes) and their latency, in milliseconds (lastLatency,
+     *   maxLatency, averageLatency); and the rate at which events have been
+     *   received since statistics were last logged (eventsPerSecond).
+     */
+    getStatistics : function()
+    {
+      var             UsageDetailQueue = playground.dbif.UsageDetailQueue;
+      var             stats = UsageDetailQueue.__stats;
+      var             last = UsageDetailQueue.__lastReport;
+      var             elapsed = (new Date()).getTime() - last.time;
+
+      return (
+        {
+          queueDepth      : UsageDetailQueue.__queue.length,
+          maxQueueDepth   : stats.maxQueueDepth,
+          events          : stats.events,
+          coalesced       : stats.coalesced,
+          dropped         : stats.dropped,
+          failed          : stats.failed,
+          flushes         : stats.flushes,
+          lastLatency     : stats.lastFlushLatency,
+          maxLatency      : stats.maxFlushLatency,
+          averageLatency  : (stats.flushes
+                             ? Math.round(stats.totalFlushLatency /
+                                          stats.flushes)
+                             : 0),
+          eventsPerSecond : (elapsed > 0
+                             ? Math.round((stats.events - last.events) *
+                                          10000 / elapsed) / 10
+                             : 0)
+        });
+    },
+
+    /**
+     * Write the queued events of one program now, as must be done before
+     * the program is renamed, removed, or copied. This must be called from
+     * a fiber.
+     *
+     * A snapshot of the program which is already being written, by a flush
+     * in progress, can't be written first. It could be saved after the
+     * operation, recreating the program, so it is not saved; its usage
+     * detail is still written.
+     *
+     * @param dbif {playground.dbif.MDbifCommon}
+     *   The database interface with which to write the events
+     *
+     * @param user {String}
+     *   The user id
+     *
+     * @param programName {String}
+     *   The program name, as provided by the client (not sanitized)
+     */
+    flushProgram : function(dbif, user, programName)
+    {
+      var             events = [];
+      var             UsageDetailQueue = playground.dbif.UsageDetailQueue;
+      var             stats = UsageDetailQueue.__stats;
+
+      // Determine whether an event is one of this program's
+      var isProgram = function(event)
+      {
+        return event.user === user && event.filename === programName;
+      };
+
+      // Don't save the program's snapshots that a flush is writing
+      UsageDetailQueue.__inFlight.forEach(
+        function(event)
+        {
+          if (isProgram(event) && event.snapshot)
+          {
+            event.snapshot = null;
+            ++stats.dropped;
+          }
+        });
+
+      // Take the program's queued events
+      UsageDetailQueue.__queue = UsageDetailQueue.__queue.filter(
+        function(event)
+        {
+          if (isProgram(event))
+          {
+            events.push(event);
+            return false;
+          }
+
+          return true;
+        });
+      delete UsageDetailQueue.__lastSnapshot[user + "/" + programName];
+
+      // Write them
+      if (events.length > 0)
+      {
+        UsageDetailQueue.__writeEvents(dbif, events);
+      }
+    },
+
+    /**
+     * Write all queued events now, as when the server is about to exit
+     *
+     * @param callback {Function}
+     *   Function to call once all events have been written
+     */
+    flushAll : function(callback)
+    {
+      var             UsageDetailQueue = playground.dbif.UsageDetailQueue;
+
+      // Is there anything to write?
+      if (! UsageDetailQueue.__bScheduled)
+      {
+        // Nope.
+        callback();
+        return;
+      }
+
+      UsageDetailQueue.__onFlushed = callback;
+
+      // If a flush is in progress, it will write the remaining events once
+      // it's done. Otherwise, write them now, rather than when scheduled.
+      if (! UsageDetailQueue.__bFlushing)
+      {
+        clearTimeout(UsageDetailQueue.__timer);
+        UsageDetailQueue.__flush();
+      }
+    },
+
+    /**
+     * Write all queued events, in a single transaction
+     */
+    __flush : function()
+    {
+      var             events;
+      var             UsageDetailQueue = playground.dbif.UsageDetailQueue;
+
+      // Take the queued events. Any arriving while these are written are
+      // queued anew, and coalesced only with each other.
+      events = UsageDetailQueue.__queue;
+      UsageDetailQueue.__queue = [];
+      UsageDetailQueue.__lastSnapshot = {};
+      UsageDetailQueue.__inFlight = events;
+      UsageDetailQueue.__bFlushing = true;
+
+      // Run in a fiber, to allow for synchronous calls
+      require("synchronize").fiber(
+        function()
+        {
+          var             latency;
+          var             callback;
+          var             startTime = (new Date()).getTime();
+          var             stats = UsageDetailQueue.__stats;
+
+          UsageDetailQueue.__writeEvents(
+            new UsageDetailQueue.__dbifClass(),
+            events);
+
+          // Update statistics
+          latency = (new Date()).getTime() - startTime;
+          ++stats.flushes;
+          stats.lastFlushLatency = latency;
+          stats.maxFlushLatency = Math.max(stats.maxFlushLatency, latency);
+          stats.totalFlushLatency += latency;
+
+          UsageDetailQueue.__logStatistics();
+
+          // Flushes are never concurrent. If events arrived during this
+          // one, flush them next: right away, if all events are to be
+          // written now; otherwise when scheduled.
+          UsageDetailQueue.__inFlight = [];
+          UsageDetailQueue.__bFlushing = false;
+          if (UsageDetailQueue.__queue.length > 0)
+          {
+            if (UsageDetailQueue.__onFlushed)
+            {
+              UsageDetailQueue.__flush();
+            }
+            else
+            {
+              UsageDetailQueue.__schedule();
+            }
+            return;
+          }
+
+          // Everything has been written
+          UsageDetailQueue.__bScheduled = false;
+          callback = UsageDetailQueue.__onFlushed;
+          if (callback)
+          {
+            UsageDetailQueue.__onFlushed = null;
+            callback();
+          }
+        });
+    },
+
+    /**
+     * Write events, in a single transaction
+     *
+     * @param dbif {playground.dbif.MDbifCommon}
+     *   The database interface with which to save snapshots
+     *
+     * @param events {Array}
+     *   The events, each as provided to enqueue()
+     */
+    __writeEvents : function(dbif, events)
+    {
+      var             UsageDetailQueue = playground.dbif.UsageDetailQueue;
+      var             stats = UsageDetailQueue.__stats;
+
+      try
+      {
+        liberated.dbif.Entity.asTransaction(
+          function()
+          {
+            events.forEach(
+              function(event)
+              {
+                // Don't let one bad event prevent writing the others
+                try
+                {
+                  UsageDetailQueue.__write(dbif, event);
+                }
+                catch(e)
+                {
+                  ++stats.failed;
+                  console.log("Failed to write usage detail for user " +
+                              event.user + ": " + e);
+                }
+              });
+          });
+      }
+      catch(e)
+      {
+        stats.failed += events.length;
+        console.log("Failed to write " + events.length +
+                    " usage detail events: " + e);
+      }
+    },
+
+    /**
+     * Schedule writing the queued events
+     */
+    __schedule : function()
+    {
+      var             UsageDetailQueue = playground.dbif.UsageDetailQueue;
+
+      UsageDetailQueue.__bScheduled = true;
+      UsageDetailQueue.__timer =
+        setTimeout(UsageDetailQueue.__flush, UsageDetailQueue.FlushInterval);
+    },
+
+    /**
+     * Write one event
+     *
+     * @param dbif {playground.dbif.MDbifCommon}
+     *   The database interface with which to save the snapshot
+     *
+     * @param event {Map}
+     *   The event, as provided to enqueue()
+     */
+    __write : function(dbif, event)
+    {
+      var             detailObj;
+      var             detailData;
+
+      // Create the usage detail object
+      detailObj = new playground.dbif.ObjUsageDetail();
+
+      // Get the object's data, and merge in the event's data
+      detailData = detailObj.getData();
+      qx.lang.Object.mergeWith(detailData, event.data, true);
+
+      // Write the usage detail to the database
+      detailObj.put();
+
+      // Is there a snapshot to be saved?
+      if (event.snapshot)
+      {
+        // Yup. Its notes include the key value.
+        event.messageData.id = detailData.id;
+
+        // Save the program
+        dbif._saveProgram(
+          event.filename,
+          event.message,
+          event.snapshot,
+          qx.lang.Json.stringify(event.messageData),
+          event.user,
+          event.bUnchanged);
+      }
+    },
+
+    /**
+     * Log the statistics, if it's time to do so
+     */
+    __logStatistics : function()
+    {
+      var             now = (new Date()).getTime();
+      var             UsageDetailQueue = playground.dbif.UsageDetailQueue;
+
+      if (now - UsageDetailQueue.__lastReport.time <
+          UsageDetailQueue.StatisticsInterval)
+      {
+        return;
+      }
+
+      console.log("Usage detail queue: " +
+                  qx.lang.Json.stringify(UsageDetailQueue.getStatistics()));
+
+      UsageDetailQueue.__lastReport =
+        {
+          time   : now,
+          events : UsageDetailQueue.__stats.events
+        };
+    }
+  }
+});
@@ -0,0 +1,440 @@
+/**
+ * Batch runner for the canning/ and c-tests/ programs
+ *
+ * The interpreter is loaded once, and each program is then preprocessed,
+ * parsed, and run in turn, in this process. The output of each canning
+ * program is compared with its expected output, from
+ * canning/TESTS-EXPECTED-OUTPUT. The programs in c-tests/ have no expected
+ * output; they pass if they exit with exit code 0.
+ *
+ * The results, including the preprocess, parse, and execution times, the
+ * number of node visits, and the peak stack and heap usage of each program,
+ * are written as JSON to standard output (or to the file specified with
+ * --output). Progress is shown on standard error.
+ *
+ * Run with: dbatch [--output <file>] [--timeout <ms>] [--only <regexp>]
+ *
+ * Copyright (c) 2013 Derrell Lipman
+ *
+ * License:
+ *   GPL Version 2: http://www.gnu.org/licenses/gpl-2.0.html
+ */
+
+var             fs = require("fs");
+var             os = require("os");
+var             path = require("path");
+var             optimist = require("optimist");
+
+// Let Main know that it is being run from the command line
+bTest = true;
+
+require("lib/Symtab.js");
+require("lib/Scheduler.js");
+require("lib/Node.js");
+require("lib/Preprocessor.js");
+require("lib/Exit.js");
+require("lib/RuntimeError.js");
+require("lib/NotYetImplemented.js");
+require("machine/Memory.js");
+require("machine/Machine.js");
+require("stdio/AbstractFile.js");
+require("stdio/EofError.js");
+require("stdio/Printf.js");
+require("stdio/Scanf.js");
+require("stdio/Stdin.js");
+require("stdio/Stdout.js");
+require("stdio/Stderr.js");
+require("stdio/RemoteFile.js");
+require("stdio/StringIn.js");
+require("stdio/StringOut.js");
+require("builtin/Stdlib.js");
+require("builtin/Ctype.js");
+require("builtin/Math.js");
+require("builtin/Time.js");
+
+var             ansic = require("ansic.js");
+
+var             argv;
+var             rootDir;
+var             current = null;
+var             results = [];
+var             tests = [];
+var             batchStart;
+var             realExit = process.exit;
+var             realWrite = process.stdout.write;
+var             canningDir = path.join(__dirname, "canning");
+var             cTestsDir = path.join(__dirname, "c-tests");
+var             mainProcess = playground.c.Main.process;
+
+optimist.usage(
+  "Usage: $0 [--output <file>] [--timeout <ms>] [--only <regexp>]");
+argv = optimist.argv;
+
+/**
+ * Get the current time, in milliseconds, with the best available resolution
+ */
+function now()
+{
+  var             t = process.hrtime();
+
+  return t[0] * 1000 + t[1] / 1000000;
+}
+
+/**
+ * Retrieve the expected standard output of each canning test, in order, from
+ * the output captured by _dotests.js.
+ *
+ * @return {Array}
+ *   The expected standard output of each test
+ */
+function readExpectedOutput()
+{
+  var             text;
+
+  text = fs.readFileSync(path.join(canningDir, "TESTS-EXPECTED-OUTPUT"),
+                         "utf8");
+
+  // Each test's output begins with its command line, prefixed by "% ".
+  // Its standard output follows "STDOUT: ", and is followed by the newline
+  // added by console.log().
+  return text.split(/^% /m).slice(1).map(
+    function(block)
+    {
+      var             stdout;
+
+      stdout = block.substring(block.indexOf("STDOUT: ") + "STDOUT: ".length);
+      return stdout.replace(/\n$/, "");
+    });
+}
+
+/**
+ * Build the list of tests to be run
+ */
+function findTests()
+{
+  var             expected = readExpectedOutput();
+  var             only = argv.only ? new RegExp(argv.only) : null;
+
+  // First, the canning tests, in the order _dotests.js runs them
+  require("./canning/tests.js").forEach(
+    function(test, i)
+    {
+      var             name = test.name.trim();
+      var             stdin = "";
+      var             inputFile;
+
+      // Standard input is as specified by the test. If there is none, but
+      // there's an input file for this program, provide that.
+      inputFile = path.join(canningDir,
+                            "input",
+                            name.split("-")[0] + "-input");
+      if (typeof test.stdin != "undefined")
+      {
+        // _dotests.js echoes the input, which adds a newline
+        stdin = test.stdin + "\n";
+      }
+      else if (fs.existsSync(inputFile))
+      {
+        stdin = fs.readFileSync(inputFile, "utf8");
+      }
+
+      tests.push(
+        {
+          suite    : "canning",
+          name     : name,
+          file     : path.join(canningDir, name),
+          stdin    : stdin,
+          args     : test.args || null,
+          preproc  : (test.extras || []).indexOf("--preproc") != -1,
+          expected : expected[i]
+        });
+    });
+
+  // Then the c-tests, which have no expected output
+  fs.readdirSync(cTestsDir).sort().forEach(
+    function(name)
+    {
+      if (! name.match(/\.c$/))
+      {
+        return;
+      }
+
+      tests.push(
+        {
+          suite    : "c-tests",
+          name     : name,
+          file     : path.join(cTestsDir, name),
+          stdin    : "",
+          args     : null,
+          preproc  : false,
+          expected : null
+        });
+    });
+
+  // If only some tests were requested, remove the others
+  if (only)
+  {
+    tests = tests.filter(
+      function(test)
+      {
+        return only.test(test.suite + "/" + test.name);
+      });
+  }
+}
+
+/**
+ * Programs open their input files as /canning/pNNN-input. Create a root
+ * directory for RemoteFile in which those names refer to canning/input/.
+ */
+function createRootDir()
+{
+  rootDir = fs.mkdtempSync(path.join(os.tmpdir(), "dbatch-"));
+  fs.symlinkSync(path.join(canningDir, "input"),
+                 path.join(rootDir, "canning"));
+}
+
+/**
+ * Remove the root directory created by createRootDir()
+ */
+function removeRootDir()
+{
+  fs.unlinkSync(path.join(rootDir, "canning"));
+  fs.rmdirSync(rootDir);
+}
+
+// Note when parsing completes and execution begins. The parser calls
+// Main.process() upon reaching the start symbol.
+playground.c.Main.process = function(root, argv)
+{
+  if (current)
+  {
+    current.parseEnd = now();
+  }
+
+  return mainProcess.call(playground.c.Main, root, argv);
+};
+
+/**
+ * Run one test, and then call a function
+ *
+ * @param test {Map}
+ *   The test to be run, as created by findTests()
+ *
+ * @param next {Function}
+ *   The function to call after the test has completed
+ */
+function runTest(test, next)
+{
+  var             code;
+  var             timer;
+  var             output = [];
+  var             state = { start : now() };
+  var             mem = playground.c.machine.Memory.getInstance();
+  var             Node = playground.c.lib.Node;
+
+  process.stderr.write("Running test: " + test.suite + "/" + test.name + "\n");
+
+  /**
+   * Record the results of this test, and move on to the next one. This
+   * replaces process.exit() while the test runs.
+   *
+   * @param exitCode {Integer}
+   *   The program's exit code
+   */
+  function finish(exitCode)
+  {
+    var             result;
+    var             stats;
+    var             end = now();
+    var             out = output.join("");
+
+    // Ignore any exit after we've finished (e.g., upon timeout)
+    if (current !== state)
+    {
+      return;
+    }
+    current = null;
+    clearTimeout(timer);
+
+    // Stop capturing output. Exit requests continue to come here, so that a
+    // program which is stopped late cannot end the batch.
+    process.stdout.write = realWrite;
+
+    result =
+      {
+        suite          : test.suite,
+        name           : test.name,
+        exitCode       : exitCode,
+        timedOut       : !! state.timedOut,
+        preprocessTime : state.preprocessEnd - state.start
+      };
+
+    // If the program was parsed, determine how long that and execution took
+    if (state.parseEnd)
+    {
+      stats = playground.c.lib.Scheduler.getStatistics();
+      result.parseTime = state.parseEnd - state.preprocessEnd;
+      result.executionTime = end - state.parseEnd;
+      result.nodeVisits = stats ? stats.nodes : 0;
+      result.peak =
+        {
+          stack : mem.getPeakStackUsage(),
+          heap  : playground.c.builtin.Stdlib.getPeakHeapUsage()
+        };
+    }
+    else if (state.preprocessEnd)
+    {
+      result.parseTime = end - state.preprocessEnd;
+    }
+
+    // Compare with the expected output, if there is any; otherwise a
+    // successful exit is a pass.
+    if (test.expected !== null)
+    {
+      result.passed = (out === test.expected);
+      if (! result.passed)
+      {
+        result.expected = test.expected;
+        result.output = out;
+      }
+    }
+    else
+    {
+      result.passed = (exitCode === 0);
+      if (! result.passed)
+      {
+        result.output = out;
+      }
+    }
+
+    results.push(result);
+    setImmediate(next);
+  }
+
+  // Start from a clean machine
+  current = state;
+  mem.initAll();
+  playground.c.lib.Scheduler.reset();
+  Node._bStop = false;
+
+  // Capture the output, and each request to exit
+  process.stdout.write = function(str)
+  {
+    output.push(String(str));
+    return true;
+  };
+  process.exit = finish;
+
+  // Stop a program which runs too long
+  timer = setTimeout(
+    function()
+    {
+      state.timedOut = true;
+
+      // Ask the interpreter to stop. It will then exit.
+      Node._bStop = true;
+
+      // If it doesn't exit soon, give up on it.
+      timer = setTimeout(
+        function()
+        {
+          finish(null);
+        },
+        5000);
+    },
+    argv.timeout || 60000);
+
+  try
+  {
+    code = fs.readFileSync(test.file, "utf8");
+    playground.c.lib.Preprocessor.preprocess(
+      code,
+      function(preprocessedCode)
+      {
+        state.preprocessEnd = now();
+
+        if (test.preproc)
+        {
+          console.log(preprocessedCode);
+          finish(0);
+          return;
+        }
+
+        try
+        {
+          // Reinitialize, and then set our options for this run
+          playground.c.Main.main(ansic.parser);
+          playground.c.stdio.RemoteFile.ROOTDIR = rootDir;
+          playground.c.Main.commandLine = test.args;
+
+          // Provide the program's standard input, followed by end of file
+          playground.c.stdio.Stdin.getInstance().inject(test.stdin.split(""));
+          process.stdin.pause();
+          process.stdin._bEof = true;
+
+          playground.c.Main.parse(ansic.parser, preprocessedCode);
+        }
+        catch(e)
+        {
+          console.log(">>> " + e.toString() + "\n" + (e.stack || ""));
+          finish(1);
+        }
+      });
+  }
+  catch(e)
+  {
+    console.log(">>> Preprocessor encountered an error:\n" + e);
+    finish(1);
+  }
+}
+
+/**
+ * Write the results, and exit
+ */
+function report()
+{
+  var             json;
+  var             passed;
+
+  passed = results.filter(function(result) { return result.passed; }).length;
+
+  json = JSON.stringify(
+    {
+      tests     : results.length,
+      passed    : passed,
+      failed    : results.length - passed,
+      totalTime : now() - batchStart,
+      results   : results
+    },
+    null,
+    "  ");
+
+  if (argv.output)
+  {
+    fs.writeFileSync(argv.output, json + "\n");
+  }
+  else
+  {
+    process.stdout.write(json + "\n");
+  }
+
+  process.stderr.write(passed + " of " + results.length + " tests passed\n");
+
+  removeRootDir();
+  realExit(passed == results.length ? 0 : 1);
+}
+
+findTests();
+createRootDir();
+batchStart = now();
+
+(function runNext()
+ {
+   if (tests.length === 0)
+   {
+     report();
+     return;
+   }
+
+   runTest(tests.shift(), runNext);
+ })();
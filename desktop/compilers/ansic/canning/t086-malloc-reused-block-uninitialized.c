@@ -0,0 +1,15 @@
+#include <stdio.h>
+#include <stdlib.h>
+
+int main(int argc, char * argv[])
+{
+    char * p;
+    char * q;
+
+    p = malloc(16);
+    p[0] = 42;
+    free(p);
+    q = malloc(16);
+    printf("q[0] = %d\n", q[0]);
+    return 0;
+}
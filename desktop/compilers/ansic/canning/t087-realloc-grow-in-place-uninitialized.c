@@ -0,0 +1,18 @@
+#include <stdio.h>
+#include <stdlib.h>
+
+int main(int argc, char * argv[])
+{
+    char * p;
+    char * q;
+
+    p = malloc(8);
+    q = malloc(8);
+    q[0] = 42;
+    free(q);
+    p[0] = 23;
+    p = realloc(p, 16);
+    printf("p[0] = %d\n", p[0]);
+    printf("p[8] = %d\n", p[8]);
+    return 0;
+}
@@ -0,0 +1,20 @@
+#include <stdio.h>
+#include <stdlib.h>
+
+int main(int argc, char * argv[])
+{
+    char * p;
+    char * q;
+    char * r;
+
+    q = malloc(32);
+    q[24] = 42;
+    free(q);
+    p = malloc(8);
+    r = malloc(8);
+    p[0] = 23;
+    p = realloc(p, 16);
+    printf("p[0] = %d\n", p[0]);
+    printf("p[8] = %d\n", p[8]);
+    return 0;
+}
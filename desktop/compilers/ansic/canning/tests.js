@@ -0,0 +1,528 @@
+/**
+ * The list of canning tests, shared by _dotests.js and the batch runner.
+ *
+ * Each test names the program to run, and optionally the standard input to
+ * provide to it (stdin), its command line arguments (args), and additional
+ * options to dcc (extras). The expected output of each test, in this order,
+ * is in TESTS-EXPECTED-OUTPUT.
+ *
+ * Copyright (c) 2013 Derrell Lipman
+ *
+ * License:
+ *   GPL Version 2: http://www.gnu.org/licenses/gpl-2.0.html
+ */
+
+module.exports =
+  [
+    {
+      name  : "p001-helloworld.c"
+    },
+
+    {
+      name  : "p002-value6.c"
+    },
+
+    {
+      name  : "p003-charP.c"
+    },
+
+    {
+      name  : "p004-scanf.c",
+      stdin : "42"
+    },
+
+    {
+      name  : "p005-sum-of-two-values.c",
+      stdin : "23 42"
+    },
+
+    {
+      name  : "p006-fscanf.c"
+    },
+
+
+    {
+      name  : "p007-bigger-than-100.c",
+      stdin : "99"
+    },
+    {
+      name  : "p007-bigger-than-100.c",
+      stdin : "100"
+    },
+    {
+      name  : "p007-bigger-than-100.c",
+      stdin : "101"
+    },
+
+
+    {
+      name  : "p008-horizontal-line.c"
+    },
+
+    {
+      name  : "p009-using-for-loop.c"
+    },
+
+    {
+      name  : "p010-sum-of-twenty.c"
+    },
+
+
+    {
+      name  : "p011-equal-to-zero.c",
+      stdin : "-1"
+    },
+    {
+      name  : "p011-equal-to-zero.c",
+      stdin : "0"
+    },
+    {
+      name  : "p011-equal-to-zero.c",
+      stdin : "1"
+    },
+
+
+    {
+      name  : "p012-pos-neg-zero.c",
+      stdin : "-1"
+    },
+    {
+      name  : "p012-pos-neg-zero.c",
+      stdin : "0"
+    },
+    {
+      name  : "p012-pos-neg-zero.c",
+      stdin : "1"
+    },
+
+
+    {
+      name  : "p013-abs-function.c",
+      stdin : "3"
+    },
+    {
+      name  : "p013-abs-function.c",
+      stdin : "-4"
+    },
+
+
+    {
+      name  : "p015-sqrt-function.c",
+      stdin : "2"
+    },
+
+    {
+      name  : "p016-sine-atof.c",
+      args : "3.1415926"
+    },
+    {
+      name  : "p016-sine-atof.c",
+      args  : "1.570796"
+    },
+
+
+    {
+      name  : "p017-count-characters.c",
+      stdin : "hello world."
+    },
+
+    {
+      name  : "p018-solidbox.c",
+      stdin : "8 5"
+    },
+
+    {
+      name  : "p019-area-of-rectangle.c",
+      stdin : "5 8"
+    },
+    {
+      name  : "p019-area-of-rectangle.c",
+      stdin : "2.3 8"
+    },
+
+    {
+      name  : "p020-area-of-circle.c",
+      stdin : "1"
+    },
+    {
+      name  : "p020-area-of-circle.c",
+      stdin : "2"
+    },
+
+
+    {
+      name  : "p021-argv.c",
+      args  : "hello world"
+    },
+
+    {
+      name  : "p022-reverse-command-line.c",
+      args  : "hello world"
+    },
+
+    {
+      name  : "p023-scanf-returns-what.c"
+    },
+
+    {
+      name  : "p024-one-dim-array.c"
+    },
+
+    {
+      name  : "p025-sum-of-bunch.c"
+    },
+
+    {
+      name  : "p026-fgetc-and-toupper.c"
+    },
+
+    {
+      name  : "p027-reverse.c",
+      stdin : " 2 3 4 5 6 7 8 9 10 11 12 13 "
+    },
+
+    {
+      name  : "p028-digit-sum.c"
+    },
+
+    {
+      name  : "p029-average.c"
+    },
+
+    {
+      name  : "p030-unfilledbox.c",
+      stdin : "8 5"
+    },
+
+    {
+      name  : "p038-blank-removal.c",
+      args  : "/canning/p038-input"
+    },
+
+    {
+      name  : "p054-fibonacci-iterative.c",
+      stdin : "5"
+    },
+    {
+      name  : "p054-fibonacci-iterative.c",
+      stdin : "8"
+    },
+    {
+      name  : "p054-fibonacci-iterative.c",
+      stdin : "12"
+    },
+
+
+    {
+      name  : "p055-fibonacci-recursive.c",
+      stdin : "5"
+    },
+    {
+      name  : "p055-fibonacci-recursive.c",
+      stdin : "8"
+    },
+    {
+      name  : "p055-fibonacci-recursive.c",
+      stdin : "12"
+    },
+    
+    {
+      name  : "p202-string-copy.c",
+      args  : "hello"
+    },
+    
+    {
+      name  : "p203-malloc-array-of-structs.c"
+    },
+
+    {
+      name  : "p205-malloc-struct-array-print-reverse.c"
+    },
+
+    {
+      name  : "p206-push-pop.c"
+    },
+
+    {
+      name  : "p207-rpn-calculator.c",
+      stdin : "1 2 + p 1 2 s + p 3 5 - p 2 2 * 3 3 * * p 2 3 + 4 s * p 2 + a q"
+    },
+
+    {
+      name  : "t001-global-pointer-initialized.c"
+    },
+    {
+      name  : "t002-decl-after-stmt.c"
+    },
+    {
+      name  : "t003-forward-decl.c"
+    },
+    {
+      name  : "t004-forward-decl-missing.c"
+    },
+    {
+      name  : "t005-forward-decl-only.c"
+    },
+    {
+      name  : "t006-struct-decl-and-access.c"
+    },
+    {
+      name  : "t007-struct-pointer-deref.c"
+    },
+    {
+      name  : "t008-struct-redeclaration.c"
+    },
+    {
+      name  : "t009-union-simple.c"
+    },
+    
+    // t010: Add simple enum test here
+
+    {
+      name  : "t011-undef-enum-param.c"
+    },
+    {
+      name   : "t012-preproc-correct-lines-if.c",
+      extras : [ "--preproc" ]
+    },
+    {
+      name   : "t013-preproc-correct-lines-else.c",
+      extras : [ "--preproc" ]
+    },
+    {
+      name   : "t014-switch-break.c"
+    },
+    {
+      name   : "t015-switch-no-break.c"
+    },
+    {
+      name   : "t016-switch-default.c"
+    },
+    {
+      name   : "t017-macro-good.c",
+      extras : [ "--preproc" ]
+    },
+    {
+      name   : "t018-macro-bad.c",
+      extras : [ "--preproc" ]
+    },
+    {
+      name   : "t019-fscanf-null-handle.c"
+    },
+    {
+      name   : "t020-fscanf-bad-handle.c"
+    },
+    {
+      name   : "t021-preproc-leading-blank-lines.c",
+      extras : [ "--preproc" ]
+    },
+    {
+      name   : "t022-array-initialize.c"
+    },
+    {
+      name   : "t023-array-initialize-bad-1.c"
+    },
+    {
+      name   : "t024-call-int-as-func.c"
+    },
+    {
+      name   : "t025-call-function-via-pointer.c"
+    },
+    {
+      name   : "t026-struct-initialize.c"
+    },
+    {
+      name   : "t027-union-initialize.c"
+    },
+    {
+      name   : "t028-global-struct-decl.c"
+    },
+    {
+      name   : "t029-include-missing-right-angle.c"
+    },
+    {
+      name   : "t030-include-missing-left-angle.c"
+    },
+    {
+      name   : "t031-include-missing-both-angles.c"
+    },
+    {
+      name   : "t032-include-with-quotes.c"
+    },
+    {
+      name   : "t033-include-missing-right-quote.c"
+    },
+    {
+      name   : "t034-include-missing-left-quote.c"
+    },
+    {
+      name   : "t035-ctype.c"
+    },
+    {
+      name   : "t036-assignment-error-1.c"
+    },
+    {
+      name   : "t037-assignment-error-2.c"
+    },
+    {
+      name   : "t038-assignment-error-3.c"
+    },
+    {
+      name   : "t039-multiple-case.c"
+    },
+    {
+      name   : "t040-case-enum.c"
+    },
+    {
+      name   : "t041-case-const.c"
+    },
+    {
+      name   : "t042-non-special-escape.c"
+    },
+    {
+      name   : "t043-for-loop-comma-list.c"
+    },
+    {
+      name   : "t044-enum-value-lvalue.c"
+    },
+    {
+      name   : "t045-math.c"
+    },
+    {
+      name   : "t046-array-parameter.c"
+    },
+    {
+      name   : "t047-array-var-dereference.c"
+    },
+    {
+      name   : "t048-time.c"
+    },
+    {
+      name   : "t049-initializer-is-function.c"
+    },
+    {
+      name   : "t050-shadowed-parameter.c"
+    },
+    {
+      name   : "t051-cast.c"
+    },
+    {
+      name   : "t052-error-dereference.c"
+    },
+    {
+      name   : "t053-multiple-initializers.c"
+    },
+    {
+      name   : "t054-post-increment-pointer.c"
+    },
+    {
+      name   : "t055-short-circuit.c"
+    },
+    {
+      name   : "t056-printf-percent-g.c"
+    },
+    {
+      name   : "t057-sizeof-as-argument.c"
+    },
+    {
+      name   : "t058-null-not-in-quotes.c"
+    },
+    {
+      name   : "t059-address-of-array.c"
+    },
+    {
+      name   : "t060-array-variable-length.c"
+    },
+    {
+      name   : "t061-return-value-from-void-function.c"
+    },
+    {
+      name   : "t062-duplicate-function-forward-decl.c"
+    },
+    {
+      name   : "t063-function-name-as-lvalue.c"
+    },
+    {
+      name   : "t064-function-name-as-rvalue.c"
+    },
+    {
+      name   : "t065-redefine-builtin.c"
+    },
+/*
+    {
+      name   : "t066-deref-address-of.c"
+    },
+*/
+    {
+      name   : "t067-call-int-as-function.c"
+    },
+/* FIXME!!!
+    {
+      name   : "t068-pass-struct-to-function.c"
+    },
+*/
+    {
+      name   : "t069-multi-char-char-constant.c"
+    },
+/*
+    {
+      name   : "t070-missing-arg-to-builtin.c"
+    },
+    {
+      name   : "t071-uppercase-while.c"
+    },
+    {
+      name   : "t072-n-dir-array-initialization.c"
+    }
+*/
+    {
+      name   : "t073-assign-declared-not-defined-function.c"
+    },
+    {
+      name   : "t074-struct-member-access-on-non-struct-var.c"
+    },
+    {
+      name   : "t075-switch-no-statement-list.c"
+    },
+    {
+      name   : "t076-switch-empty-statement-list.c"
+    },
+    {
+      name   : "t077-multi-dim-array-initializer.c"
+    },
+    {
+      name   : "t078-multi-dim-array-bad-1.c "
+    },
+    {
+      name   : "t079-pass-struct-to-function-2.c"
+    },
+    {
+      name   : "t080-array-wrong-param-type.c"
+    },
+    {
+      name   : "t081-int-accessed-as-array.c"
+    },
+    {
+      name   : "t082-scanf-address-0.c",
+      stdin  : "3"
+    },
+    {
+      name   : "t083-array-initializer-negative-value.c"
+    },
+    {
+      name   : "t084-scanf-one-format-marker-no-address.c",
+      stdin  : "3"
+    },
+    {
+      name   : "t085-scanf-invalid-format-string-addr.c"
+    },
+    {
+      name   : "t086-malloc-reused-block-uninitialized.c"
+    },
+    {
+      name   : "t087-realloc-grow-in-place-uninitialized.c"
+    },
+    {
+      name   : "t088-realloc-copy-uninitialized.c"
+    }
+  ];
@@ -0,0 +1,123 @@
+/**
+ * Micro-benchmark of memory access throughput
+ *
+ * Run with: nodejs benchmark-memory.js [iterations]
+ *
+ * Copyright (c) 2013 Derrell Lipman
+ *
+ * License:
+ *   GPL Version 2: http://www.gnu.org/licenses/gpl-2.0.html
+ */
+
+var qx = require("qooxdoo");
+require("../../../playground/source/class/playground/c/machine/Memory");
+require("../../../playground/source/class/playground/c/lib/Node");
+require("../../../playground/source/class/playground/c/lib/Preprocessor");
+
+var             Memory = playground.c.machine.Memory;
+var             mem = Memory.getInstance();
+var             iterations = parseInt(process.argv[2], 10) || 1000000;
+var             gas = Memory.info.gas.start;
+var             rts = Memory.info.rts.start;
+var             sink = 0;
+
+/**
+ * Run one benchmark, and display the number of operations per second.
+ *
+ * @param name {String}
+ *   The name of the benchmark
+ *
+ * @param f {Function}
+ *   Function to be called with the iteration number, once per iteration
+ */
+function bench(name, f)
+{
+  var             i;
+  var             start;
+  var             elapsed;
+
+  // Warm up
+  for (i = 0; i < 10000; i++)
+  {
+    f(i);
+  }
+
+  start = Date.now();
+  for (i = 0; i < iterations; i++)
+  {
+    f(i);
+  }
+  elapsed = Math.max(Date.now() - start, 1);
+
+  console.log(("                              " + name).substr(-30) + ": " +
+              Math.round(iterations / elapsed * 1000) + " ops/sec");
+}
+
+// Don't let uninitialized-memory checking skew the results
+playground.c.lib.Preprocessor.pragma.debugFlags.uninitializedMemory = 0;
+
+// Start with an empty stack
+mem.setReg("SP", "unsigned int", rts + Memory.info.rts.length);
+
+// Reference: what each access used to cost, creating a view per access
+bench("view per access (reference)",
+      function(i)
+      {
+        new Int32Array(mem._memory, gas + ((i & 0xff) << 2), 1)[0] = i;
+        sink += new Int32Array(mem._memory, gas + ((i & 0xff) << 2), 1)[0];
+      });
+
+bench("set/get int",
+      function(i)
+      {
+        mem.set(gas + ((i & 0xff) << 2), "int", i);
+        sink += mem.get(gas + ((i & 0xff) << 2), "int");
+      });
+
+bench("set/get char",
+      function(i)
+      {
+        mem.set(gas + (i & 0xff), "char", i & 0x7f);
+        sink += mem.get(gas + (i & 0xff), "char");
+      });
+
+bench("set/get double",
+      function(i)
+      {
+        mem.set(rts + ((i & 0xff) << 2), "double", i / 2);
+        sink += mem.get(rts + ((i & 0xff) << 2), "double");
+      });
+
+bench("set/get type code",
+      function(i)
+      {
+        mem.set(gas + ((i & 0xff) << 2), Memory.typeCode["int"], i);
+        sink += mem.get(gas + ((i & 0xff) << 2), Memory.typeCode["int"]);
+      });
+
+bench("setReg/getReg",
+      function(i)
+      {
+        mem.setReg("R1", "unsigned int", i);
+        sink += mem.getReg("R1", "unsigned int");
+      });
+
+bench("move",
+      function(i)
+      {
+        mem.move(gas + ((i & 0xff) << 2), "int",
+                 gas + 1024 + ((i & 0xff) << 2), "int");
+      });
+
+bench("stackPush/stackPop",
+      function(i)
+      {
+        mem.stackPush("int", i);
+        sink += mem.stackPop("int");
+      });
+
+// Use the sink so the work can't be optimized away
+if (isNaN(sink))
+{
+  console.log("unexpected result");
+}
@@ -0,0 +1,92 @@
+/**
+ * Benchmark of the preprocessor's macro expansion, using a synthetic source
+ * with many macro definitions and many lines which use them.
+ *
+ * Run with: nodejs benchmark-preprocessor.js [lines] [macros]
+ *
+ * Copyright (c) 2013 Derrell Lipman
+ *
+ * License:
+ *   GPL Version 2: http://www.gnu.org/licenses/gpl-2.0.html
+ */
+
+var qx = require("qooxdoo");
+require("../../../playground/source/class/playground/c/lib/RuntimeError");
+require("../../../playground/source/class/playground/c/lib/Preprocessor");
+
+var             numLines = parseInt(process.argv[2], 10) || 10000;
+var             numMacros = parseInt(process.argv[3], 10) || 1000;
+
+/**
+ * Create the synthetic source. Half of the macros are constants, of
+ * varying name length; the rest are function-like macros, some of which
+ * invoke others. Each line uses several macros, and several identifiers
+ * which are not macros.
+ *
+ * @return {String}
+ *   The source code to be preprocessed
+ */
+function createSource()
+{
+  var             i;
+  var             name;
+  var             lines = [];
+
+  /**
+   * Get the name of the i-th macro
+   */
+  function macroName(i)
+  {
+    return (i % 2 ? "TABLE_ENTRY_CONSTANT_" : "K") + i;
+  }
+
+  for (i = 0; i < numMacros; i++)
+  {
+    name = macroName(i);
+    if (i % 4 < 2)
+    {
+      lines.push("#define " + name + " (" + i + ")");
+    }
+    else if (i % 4 == 2)
+    {
+      lines.push("#define " + name + "(a, b) ((a) * " + i + " + (b))");
+    }
+    else
+    {
+      lines.push("#define " + name + "(x) " + macroName(i - 3) +
+                 "(x, " + macroName(i - 2) + ")");
+    }
+  }
+
+  for (i = 0; i < numLines; i++)
+  {
+    lines.push(
+      "int variable_" + i + " = " +
+        macroName(i % numMacros - i % 4) + " + " +
+        macroName((i * 7) % numMacros - (i * 7) % 4 + 1) + " + " +
+        macroName((i * 13) % numMacros - (i * 13) % 4 + 2) +
+        "(variable_" + (i - 1) + ", " + i + ") + " +
+        macroName((i * 17) % numMacros - (i * 17) % 4 + 3) +
+        "(not_a_macro_" + i + ") - strlen(\"K" + i + " is not expanded\");");
+  }
+
+  return lines.join("\n") + "\n";
+}
+
+var             source = createSource();
+var             start;
+var             elapsed;
+var             length;
+
+start = Date.now();
+playground.c.lib.Preprocessor.preprocess(
+  source,
+  function(preprocessedCode)
+  {
+    length = preprocessedCode.length;
+  });
+elapsed = Math.max(Date.now() - start, 1);
+
+console.log(numLines + " lines, " + numMacros + " macros (" +
+            source.length + " bytes in, " + length + " bytes out): " +
+            elapsed + " ms");
@@ -72,6 +72,7 @@ qx.Class.define("playground.Application",
 
     editor : null,
     __bFirstError : true,
+    __syntaxCheckTimer : null,
 
     // storages
     __samples : null,
@@ -87,6 +88,9 @@ qx.Class.define("playground.Application",
 
     __modified : false,
 
+    // entity tag of the displayed directory listing, if known
+    __directoryListingEtag : "",
+
     // used for removing the created objects in the run code
     __beforeReg : null,
     __afterReg : null,
@@ -259,6 +263,14 @@ else... */
       this.editor.addListener("disableHighlighting", function() {
         this.__toolbar.enableHighlighting(false);
       }, this);
+
+      // Check the syntax of the code as it's edited
+      this.editor.addListener("changeCode", this.__scheduleSyntaxCheck, this);
+
+      // Begin loading the interpreter into a worker, in which programs will
+      // be run when possible
+      playground.c.worker.Client.getInstance();
+
       playground.view.Editor.loadAce(function() {
         this.init("ace");
       }, this);
@@ -584,11 +596,23 @@ else... */
     },
 
 
-    _displayDirectoryListing : function(result)
+    /**
+     * Display a directory listing
+     *
+     * @param result {Array}
+     *   The directory listing, as returned by the server
+     *
+     * @param etag {String?}
+     *   The listing's entity tag, if provided by the server
+     */
+    _displayDirectoryListing : function(result, etag)
     {
       var             model;
       var             marshaler;
 
+      // Remember which listing is displayed
+      this.__directoryListingEtag = etag || "";
+
       // Display the result values.
       marshaler = new qx.data.marshal.Json();
       marshaler.toClass(result, true);
@@ -604,6 +628,18 @@ else... */
       this.__samplesPane.selectByName(this.getName());
     },
 
+
+    /**
+     * Retrieve the entity tag of the displayed directory listing
+     *
+     * @return {String}
+     *   The entity tag, or the empty string if it's not known
+     */
+    getDirectoryListingEtag : function()
+    {
+      return this.__directoryListingEtag;
+    },
+
     // ***************************************************
     // PROPERTY APPLY
     // ***************************************************
@@ -1745,6 +1781,134 @@ else... */
       this.__bFirstError = true;
     },
 
+    /**
+     * Arrange for the syntax of the code to be checked once the user pauses
+     * in editing it.
+     */
+    __scheduleSyntaxCheck : function()
+    {
+      // Create the timer upon first use
+      if (! this.__syntaxCheckTimer)
+      {
+        this.__syntaxCheckTimer = new qx.event.Timer(750);
+        this.__syntaxCheckTimer.addListener(
+          "interval",
+          function()
+          {
+            this.__syntaxCheckTimer.stop();
+            this.__checkSyntax();
+          },
+          this);
+      }
+
+      // Restart the timer upon each change
+      this.__syntaxCheckTimer.restart();
+    },
+
+    /**
+     * Preprocess and parse the code, without running it, and show any errors
+     * as annotations in the editor. It's done in the Web Worker, when that's
+     * available, so as not to delay the user interface. The parsed program
+     * is retained, so that it needn't be parsed again when it's run.
+     *
+     * @ignore(require)
+     */
+    __checkSyntax : function()
+    {
+      var             editor = this.editor;
+
+      /**
+       * Determine whether a program is running (or stopped at a breakpoint),
+       * in which case the syntax can't be checked, as parsing would disturb
+       * its symbol tables.
+       */
+      var bProgramActive = function()
+      {
+        var             state = this.getProgramState();
+
+        return ! (state === null || state == "idle" || state == "crashed");
+      }.bind(this);
+
+      /**
+       * Show the errors in the editor's gutter
+       *
+       * @param errors {Array}
+       *   The errors, each with a location and a message
+       */
+      var showErrors = function(errors)
+      {
+        editor.setAnnotations(
+          errors.map(
+            function(error)
+            {
+              return (
+                {
+                  row    : error.loc.first_line - 1,
+                  column : Math.max(error.loc.first_column - 1, 0),
+                  text   : "! " + error.message,
+                  type   : "error"
+                });
+            }));
+      };
+
+      // Check it in the worker, if possible. Otherwise, it's checked here.
+      if (playground.c.worker.Client.getInstance().check(editor.getCode(),
+                                                         showErrors))
+      {
+        return;
+      }
+
+      if (bProgramActive())
+      {
+        return;
+      }
+
+      try
+      {
+        playground.c.lib.Preprocessor.preprocess(
+          editor.getCode(),
+          function(preprocessedCode)
+          {
+            require(
+              ["resource/playground/script/ansic.js"],
+              function(ansic)
+              {
+                // A program may have been started since we began
+                if (bProgramActive())
+                {
+                  return;
+                }
+
+                try
+                {
+                  showErrors(playground.c.Main.check(ansic, preprocessedCode));
+                }
+                catch(e)
+                {
+                  // It'll be reported if the program is run
+                  console.log("Syntax check failed: " + e);
+                }
+              });
+          },
+          true);
+      }
+      catch(e)
+      {
+        // The preprocessor found an error
+        showErrors(
+          [
+            {
+              loc     :
+              {
+                first_line   : (e.node && e.node.line) || 1,
+                first_column : 0
+              },
+              message : e.message || String(e)
+            }
+          ]);
+      }
+    },
+
     /**
      * Runs the current set sample and checks if it need to be saved to the url.
      *
@@ -1778,6 +1942,13 @@ else... */
       playground.c.Main.output("", true);
       this.clearErrors();
 
+      // If the program can be run in the worker, do so.
+      if (playground.c.worker.Client.getInstance().canRun(code))
+      {
+        playground.c.worker.Client.getInstance().run(code);
+        return;
+      }
+
       // We need an initial attempt at requiring ansic.js, which fails much
       // of the time. The next require of the same file will then succeed.
       try
@@ -1875,7 +2046,7 @@ else... */
                 try
                 {
                   playground.c.Main.main(ansic);
-                  ansic.parse(preprocessedCode);
+                  playground.c.Main.parse(ansic, preprocessedCode);
                 }
                 catch (e2)
                 {
@@ -23,6 +23,15 @@ qx.Class.define("playground.ServerOp",
     /** timer handle to send enqueued data */
     __timer : null,
 
+    /**
+     * The most recent snapshot of each program which has been sent to the
+     * server, keyed by program name. Each is a map containing the snapshot
+     * (text) and its hash (hash). Subsequent snapshots are sent as changes
+     * to it, even before the server acknowledges it, as the server applies
+     * each change to the snapshot it received before.
+     */
+    __sent : {},
+
     /**
      * Issue a remote procedure call request.
      * 
@@ -141,6 +150,15 @@ qx.Class.define("playground.ServerOp",
       // Enqueue this new request
       queue.push(data);
       
+      // Arrange for it to be sent
+      playground.ServerOp.__startTimer();
+    },
+
+    /**
+     * Start a timer to send the queued data, unless one is already active
+     */
+    __startTimer : function()
+    {
       // Is there already a timer active?
       if (playground.ServerOp.__timer)
       {
@@ -179,6 +197,9 @@ qx.Class.define("playground.ServerOp",
     __sendQueue : function(userData, timerId)
     {
       var             queue = playground.ServerOp.__queue;
+      var             sent = playground.ServerOp.__sent;
+      var             unacknowledged = [];
+      var             SnapshotDelta = playground.dbif.SnapshotDelta;
 /*
       // Add a snapshot immediately before sending this batch of reports
       queue.push(
@@ -194,14 +215,115 @@ qx.Class.define("playground.ServerOp",
       // There's no longer a timer running.
       playground.ServerOp.__timer = null;
 
+      // Send each snapshot as a change to the program's prior one, if that
+      // one was sent. Retain each until the server acknowledges it.
+      queue.forEach(
+        function(data)
+        {
+          var             base;
+          var             text = data.snapshot;
+          var             hash;
+
+          if (! text)
+          {
+            return;
+          }
+
+          base = sent[data.filename];
+          if (base)
+          {
+            data.snapshotDelta =
+              SnapshotDelta.create(base.text, base.hash, text);
+            hash = data.snapshotDelta.hash;
+            delete data.snapshot;
+          }
+          else
+          {
+            hash = SnapshotDelta.hash(text);
+          }
+
+          unacknowledged.push(
+            {
+              event    : data,
+              text     : text,
+              bDelta   : !! base
+            });
+
+          // This is the base for the program's next snapshot
+          sent[data.filename] = { text : text, hash : hash };
+        });
+
       playground.ServerOp.rpc(
         function(result, id)              // success callback
         {
-          qx.core.Init.getApplication()._displayDirectoryListing(result);
+          var             etag;
+          var             resend;
+          var             resync = [];
+          var             bListing = true;
+
+          // The result includes the names of programs for which the server
+          // couldn't apply deltas
+          if (result && ! qx.lang.Type.isArray(result))
+          {
+            resync = result.resync || [];
+            etag = result.etag;
+            result = result.dirList;
+            bListing = !! result;
+          }
+
+          // The server didn't have the base of those programs' deltas, so
+          // it didn't record the events which carried them. Resend those
+          // events, with their snapshots in full, ahead of anything queued
+          // since, and then send the programs' subsequent snapshots in full
+          // until a new base is sent.
+          if (resync.length > 0)
+          {
+            resend = unacknowledged.filter(
+              function(snapshot)
+              {
+                return (snapshot.bDelta &&
+                        resync.indexOf(snapshot.event.filename) != -1);
+              });
+
+            resync.forEach(
+              function(filename)
+              {
+                delete playground.ServerOp.__sent[filename];
+              });
+
+            playground.ServerOp.__queue = resend.map(
+              function(snapshot)
+              {
+                var             event = qx.lang.Object.clone(snapshot.event);
+
+                delete event.snapshotDelta;
+                event.snapshot = snapshot.text;
+                return event;
+              }).concat(playground.ServerOp.__queue);
+
+            if (resend.length > 0)
+            {
+              playground.ServerOp.__startTimer();
+            }
+          }
+
+          // Display the directory listing, unless it's unchanged
+          if (bListing)
+          {
+            qx.core.Init.getApplication()._displayDirectoryListing(result,
+                                                                   etag);
+          }
+        },
+        function(ex, id)                  // failure callback
+        {
+          // We don't know what the server has. Send full snapshots next time.
+          playground.ServerOp.__sent = {};
         },
-        null,                             // failure callback
         "usageDetail",                    // function to be called
-        [ queue ]);                       // arguments to function
+        [                                 // arguments to function
+          queue,
+          qx.core.Init.getApplication().getDirectoryListingEtag()
+        ]);
     }
   },
   
@@ -29,6 +29,7 @@ if (typeof qx === "undefined")
   var             bConsole = true;
 
   require("./lib/Symtab.js");
+  require("./lib/Scheduler.js");
   require("./lib/Node.js");
   require("./lib/Exit.js");
   require("./lib/RuntimeError.js");
@@ -71,68 +72,252 @@ qx.Class.define("playground.c.Main",
     /** Functions to be called after program execution */
     finalize : [],
 
+    /** Maximum number of parsed programs retained by parse() */
+    PARSE_CACHE_MAX : 4,
+
     /**
-     * @ignore(process.exit)
-     * @ignore(bTest)
+     * Recently-parsed programs, most recent last. Each entry is a map
+     * containing the hash and text of the preprocessed program, and the root
+     * of its abstract syntax tree.
      */
-    main : function(parser)
+    __parseCache : [],
+
+    /** The entry to receive the tree currently being parsed, if any */
+    __pendingParse : null,
+
+    /** The key and errors of the most recent failed syntax check */
+    __lastCheck : null,
+
+    /**
+     * Parse and run a preprocessed program. If the same program was parsed
+     * recently (as when it is run again, with different input), its existing
+     * abstract syntax tree is reused, and parsing is skipped entirely.
+     *
+     * Main.main() must have been called first, as it resets the run-time
+     * state for each run.
+     *
+     * @param parser {Object}
+     *   The parser, as was passed to main()
+     *
+     * @param preprocessedCode {String}
+     *   The output of the preprocessor
+     */
+    parse : function(parser, preprocessedCode)
     {
-      var             argv;
-      var             optimist;
-      var             terminal;
-      var             button;
+      var             entry;
 
-      if (bConsole || (typeof bTest != "undefined" && bTest))
+      // Is this program in the cache?
+      entry = playground.c.Main.__findParsed(preprocessedCode);
+      if (entry.root)
       {
-        // Option processing, when run from the command line
-        optimist = require("optimist");
-        optimist.usage(
-          "Usage: $0 " +
-            "[--ast] [--symtab] [--rts] [--heap] [--gas] " +
-            "[--cmdline <command_line>] [--rootdir <root_dir>]" +
-          "<file.c>");
-        optimist["boolean"]( [ "ast", "symtab", "rts", "heap", "gas" ] );
-        argv = optimist.argv;
-        
-        // If help was requested...
-        if (argv.h || argv.help)
-        {
-          // ... then just print the help message and exit
-          console.log(optimist.help());
-          process.exit(0);
-        }
-        
-        // Set flags
-        playground.c.Main.debugFlags.ast    = !!argv["ast"];
-        playground.c.Main.debugFlags.symtab = !!argv["symtab"];
-        playground.c.Main.debugFlags.rts    = !!argv["rts"];
-        playground.c.Main.debugFlags.heap   = !!argv["heap"];
-        playground.c.Main.debugFlags.gas    = !!argv["gas"];
-        
-        // If a root directory is specified...
-        if (argv["rootdir"])
+        // Yup. String literals are allocated in global memory as the
+        // program runs, and that memory has been cleared since the last run,
+        // so they must be allocated anew. Then run it again.
+        playground.c.Main.__forgetStrings(entry.root);
+        playground.c.Main.process(entry.root);
+        return;
+      }
+
+      // It's not. Arrange for process() to save the tree, and then parse.
+      playground.c.Main.__pendingParse = entry;
+      try
+      {
+        parser.parse(preprocessedCode);
+      }
+      finally
+      {
+        playground.c.Main.__pendingParse = null;
+      }
+    },
+
+    /**
+     * Check the syntax of a preprocessed program, without running it. This
+     * may be called while the user edits the program, but not while a
+     * program is running, as parsing resets the symbol table. A program
+     * which parses successfully is added to the cache used by parse(), so
+     * that it needn't be parsed again when it is run.
+     *
+     * @param parser {Object}
+     *   The parser
+     *
+     * @param preprocessedCode {String}
+     *   The output of the preprocessor
+     *
+     * @return {Array}
+     *   The list of errors found, each a map containing the location of the
+     *   error (loc) and a description of it (message). The list is empty if
+     *   there are no syntax errors.
+     */
+    check : function(parser, preprocessedCode)
+    {
+      var             entry;
+      var             error;
+      var             errors = [];
+      var             lastCheck = playground.c.Main.__lastCheck;
+
+      // If this program has already been parsed successfully, or failed to
+      // parse the last time we checked it, there's no need to parse it again.
+      entry = playground.c.Main.__findParsed(preprocessedCode);
+      if (entry.root)
+      {
+        return errors;
+      }
+
+      if (lastCheck && lastCheck.hash === entry.hash &&
+          lastCheck.key === entry.key)
+      {
+        return lastCheck.errors;
+      }
+
+      // Collect, rather than report, any errors
+      error = playground.c.Main.__createErrorHandler(parser, errors);
+      playground.c.Main.__prepareParser(parser, error);
+
+      // Parse the program. If it's successful, process() will save the tree
+      // but not run it.
+      entry.bCheckOnly = true;
+      playground.c.Main.__pendingParse = entry;
+      try
+      {
+        parser.parse(preprocessedCode);
+      }
+      catch(e)
+      {
+        // The parser gives up after reporting an error. Any other exception
+        // is unexpected.
+        if (errors.length === 0)
         {
-          playground.c.stdio.RemoteFile.ROOTDIR = argv["rootdir"].toString();
+          throw e;
         }
-        
-        // If a command line was specified...
-        if (argv["cmdline"])
+      }
+      finally
+      {
+        playground.c.Main.__pendingParse = null;
+      }
+
+      // Remember the errors, in case the same program is checked again
+      if (errors.length > 0)
+      {
+        playground.c.Main.__lastCheck =
+          {
+            hash   : entry.hash,
+            key    : entry.key,
+            errors : errors
+          };
+      }
+
+      return errors;
+    },
+
+    /**
+     * Find a preprocessed program in the cache of parsed programs. If it's
+     * found, it becomes the most recently used.
+     *
+     * @param preprocessedCode {String}
+     *   The output of the preprocessor
+     *
+     * @return {Map}
+     *   The cache entry for the program, if found. Otherwise, a new entry,
+     *   not yet in the cache, with no root.
+     */
+    __findParsed : function(preprocessedCode)
+    {
+      var             i;
+      var             hash;
+      var             entry;
+      var             key;
+      var             cache = playground.c.Main.__parseCache;
+
+      // The tree depends, too, on the set of files that were included
+      key =
+        JSON.stringify(playground.c.lib.Preprocessor.includedFiles || []) +
+        "\n" +
+        preprocessedCode;
+
+      // Hash it, to avoid comparing the full text with each cached program
+      hash = playground.c.Main.__hash(key);
+
+      // Is this program in the cache?
+      for (i = 0; i < cache.length; i++)
+      {
+        if (cache[i].hash === hash && cache[i].key === key)
         {
-          playground.c.Main.commandLine = argv["cmdline"].toString();
+          // Yup. Make it the most recently used.
+          entry = cache.splice(i, 1)[0];
+          cache.push(entry);
+          return entry;
         }
       }
-      else
+
+      return { hash : hash, key : key, root : null };
+    },
+
+    /**
+     * Discard the addresses of the string literals in a tree, so that each
+     * is allocated and written to memory again when next it's evaluated.
+     *
+     * @param node {playground.c.lib.Node}
+     *   The root of the (sub)tree
+     */
+    __forgetStrings : function(node)
+    {
+      if (node.type == "string_literal")
       {
-        // Set focus to the terminal window
-        terminal = qx.core.Init.getApplication().getUserData("terminal");
-        terminal.focus();
-        terminal.clear();
-        
-        // Ensure the terminal is not in end-of-file condition
-        terminal.setEof(false);
+        node._mem = null;
       }
 
-      var error =
+      (node.children || []).forEach(
+        function(child)
+        {
+          if (child)
+          {
+            playground.c.Main.__forgetStrings(child);
+          }
+        });
+    },
+
+    /**
+     * Calculate a 32-bit FNV-1a hash of a string
+     *
+     * @param str {String}
+     *   The string to be hashed
+     *
+     * @return {Integer}
+     *   The hash value
+     */
+    __hash : function(str)
+    {
+      var             i;
+      var             hash = 0x811c9dc5;
+
+      for (i = 0; i < str.length; i++)
+      {
+        hash ^= str.charCodeAt(i);
+        hash = Math.imul(hash, 0x01000193);
+      }
+
+      return hash >>> 0;
+    },
+
+    /**
+     * Create the handler for errors encountered during parsing. Normally
+     * each error is reported to the user: in the terminal, in the editor,
+     * and as a status report. When only checking the syntax, each error is
+     * instead added to a caller-provided list.
+     *
+     * @param parser {Object}
+     *   The parser
+     *
+     * @param errors {Array?}
+     *   If provided, the list to which each error's location and message are
+     *   added, in lieu of reporting it.
+     *
+     * @return {Map}
+     *   The error handler, to be provided to Node.setError()
+     */
+    __createErrorHandler : function(parser, errors)
+    {
+      var             error =
       {
         /**
          * Function called upon each error encountered during parsing
@@ -156,10 +341,13 @@ qx.Class.define("playground.c.Main",
           var             editor;
           var             expected;
           
-          // Set the program state
+          // Set the program state, unless we're only checking the syntax
           try
           {
-            qx.core.Init.getApplication().setProgramState("idle");
+            if (! errors)
+            {
+              qx.core.Init.getApplication().setProgramState("idle");
+            }
           }
           catch(e)
           {
@@ -359,6 +547,18 @@ qx.Class.define("playground.c.Main",
               errStr += "\t" + hint + "\n\n";
             }
 
+            // If we're only checking the syntax, just record the error
+            if (errors)
+            {
+              errors.push(
+                {
+                  loc     : hash.loc,
+                  message : hint
+                });
+              ++error.errorCount;
+              return;
+            }
+
             // Send the error as a status report
             hash.displayError = errStr;
             playground.c.Main._statusReport(
@@ -399,12 +599,32 @@ qx.Class.define("playground.c.Main",
         errorCount : 0
       };
 
-      // Re-initialize the environment
-      playground.c.Main.reinit();
+      return error;
+    },
+
+    /**
+     * Prepare the parser and the symbol table for parsing a program, and
+     * include the files found by the preprocessor, as they may define types
+     * which the parser must recognize.
+     *
+     * @param parser {Object}
+     *   The parser
+     *
+     * @param error {Map}
+     *   The error handler, as created by __createErrorHandler()
+     */
+    __prepareParser : function(parser, error)
+    {
 
       // Function called upon each error encountered during parsing
       parser.yy.parseError = error.parseError;
 
+      // Function to display rules as they are parsed
+      parser.yy.R = function(rule)
+      {
+//        console.log("rule: " + rule);
+      };
+
       // Give the Node class access to the error object
       playground.c.lib.Node.setError(error);
 
@@ -413,33 +633,6 @@ qx.Class.define("playground.c.Main",
 
       // Create the root-level symbol table
       new playground.c.lib.Symtab(null, null, 0);
-
-      // If there was a prior stdin and/or stdout, cancel any of its pending
-      // timers, and flush output.
-      [ 
-        "stdin",
-        "stdout",
-        "stderr"
-      ].forEach(
-        function(stream)
-        {
-          // If there's a prior instance of this stream...
-          if (playground.c.Main[stream])
-          {
-            // ... then remove any pending listeners
-            qx.event.Registration.removeAllListeners(playground.c.Main[stream]);
-
-            // Reinitialize the stream
-            playground.c.Main[stream].init();
-          }
-          else
-          {
-            // Get the singleton instance of this stream
-            playground.c.Main[stream] = 
-              playground.c.stdio[qx.lang.String.firstUp(stream)].getInstance();
-          }
-        });
-
       // Reset the includes and finalize lists
       playground.c.Main.includes = [];
       playground.c.Main.finalize = [];
@@ -474,23 +667,26 @@ qx.Class.define("playground.c.Main",
           switch(file)
           {
           case "learncs.h" :
-            include = function()
+            include = function(bDeclareOnly)
             {
-              return (playground.c.builtin.Learncs.include(file, line));
+              return (playground.c.builtin.Learncs.include(
+                        file, line, bDeclareOnly));
             };
             break;
 
           case "elevator.h" :
-            include = function()
+            include = function(bDeclareOnly)
             {
-              return (playground.c.builtin.Elevator.include(file, line));
+              return (playground.c.builtin.Elevator.include(
+                        file, line, bDeclareOnly));
             };
             break;
 
           case "draw.h" :
-            include = function()
+            include = function(bDeclareOnly)
             {
-              return (playground.c.builtin.Draw.include(file, line));
+              return (playground.c.builtin.Draw.include(
+                        file, line, bDeclareOnly));
             };
             finalize = function()
             {
@@ -499,23 +695,26 @@ qx.Class.define("playground.c.Main",
             break;
 
           case "ctype.h" :
-            include = function()
+            include = function(bDeclareOnly)
             {
-              return (playground.c.builtin.Ctype.include(file, line));
+              return (playground.c.builtin.Ctype.include(
+                        file, line, bDeclareOnly));
             };
             break;
 
           case "math.h" :
-            include = function()
+            include = function(bDeclareOnly)
             {
-              return (playground.c.builtin.Math.include(file, line));
+              return (playground.c.builtin.Math.include(
+                        file, line, bDeclareOnly));
             };
             break;
 
           case "stdio.h" :
-            include = function()
+            include = function(bDeclareOnly)
             {
-              return (playground.c.stdio.Stdio.include(file, line));
+              return (playground.c.stdio.Stdio.include(
+                        file, line, bDeclareOnly));
             };
             finalize = function()
             {
@@ -524,9 +723,10 @@ qx.Class.define("playground.c.Main",
             break;
 
           case "stdlib.h" :
-            include = function()
+            include = function(bDeclareOnly)
             {
-              return (playground.c.builtin.Stdlib.include(file, line));
+              return (playground.c.builtin.Stdlib.include(
+                        file, line, bDeclareOnly));
             };
             finalize = function()
             {
@@ -535,9 +735,10 @@ qx.Class.define("playground.c.Main",
             break;
 
           case "time.h" :
-            include = function()
+            include = function(bDeclareOnly)
             {
-              return (playground.c.builtin.Time.include(file, line));
+              return (playground.c.builtin.Time.include(
+                        file, line, bDeclareOnly));
             };
             break;
 
@@ -558,8 +759,10 @@ qx.Class.define("playground.c.Main",
             playground.c.Main.finalize.push(finalize);
           }
 
-          // Include it now, for continued parsing
-          includeError = include();
+          // Declare its functions, constants, and types now, for continued
+          // parsing. Its other effects (e.g., showing a canvas, or
+          // initializing the heap) await running the program.
+          includeError = include(true);
           if (includeError)
           {
             playground.c.lib.Node.getError().parseError(
@@ -568,13 +771,106 @@ qx.Class.define("playground.c.Main",
             return;
           }
       });
+    },
 
+    /**
+     * @ignore(process.exit)
+     * @ignore(bTest)
+     */
+    main : function(parser)
+    {
+      var             argv;
+      var             optimist;
+      var             terminal;
+      var             button;
+      var             error;
 
-      // Function to display rules as they are parsed
-      parser.yy.R = function(rule)
+      if (bConsole || (typeof bTest != "undefined" && bTest))
       {
-//        console.log("rule: " + rule);
-      };
+        // Option processing, when run from the command line
+        optimist = require("optimist");
+        optimist.usage(
+          "Usage: $0 " +
+            "[--ast] [--symtab] [--rts] [--heap] [--gas] [--sched] " +
+            "[--cmdline <command_line>] [--rootdir <root_dir>]" +
+          "<file.c>");
+        optimist["boolean"](
+          [ "ast", "symtab", "rts", "heap", "gas", "sched" ] );
+        argv = optimist.argv;
+        
+        // If help was requested...
+        if (argv.h || argv.help)
+        {
+          // ... then just print the help message and exit
+          console.log(optimist.help());
+          process.exit(0);
+        }
+        
+        // Set flags
+        playground.c.Main.debugFlags.ast    = !!argv["ast"];
+        playground.c.Main.debugFlags.symtab = !!argv["symtab"];
+        playground.c.Main.debugFlags.rts    = !!argv["rts"];
+        playground.c.Main.debugFlags.heap   = !!argv["heap"];
+        playground.c.Main.debugFlags.gas    = !!argv["gas"];
+        playground.c.Main.debugFlags.sched  = !!argv["sched"];
+        
+        // If a root directory is specified...
+        if (argv["rootdir"])
+        {
+          playground.c.stdio.RemoteFile.ROOTDIR = argv["rootdir"].toString();
+        }
+        
+        // If a command line was specified...
+        if (argv["cmdline"])
+        {
+          playground.c.Main.commandLine = argv["cmdline"].toString();
+        }
+      }
+      else
+      {
+        // Set focus to the terminal window
+        terminal = qx.core.Init.getApplication().getUserData("terminal");
+        terminal.focus();
+        terminal.clear();
+        
+        // Ensure the terminal is not in end-of-file condition
+        terminal.setEof(false);
+      }
+
+      // Create the handler for errors encountered during parsing
+      error = playground.c.Main.__createErrorHandler(parser);
+
+      // Re-initialize the environment
+      playground.c.Main.reinit();
+
+      // If there was a prior stdin and/or stdout, cancel any of its pending
+      // timers, and flush output.
+      [ 
+        "stdin",
+        "stdout",
+        "stderr"
+      ].forEach(
+        function(stream)
+        {
+          // If there's a prior instance of this stream...
+          if (playground.c.Main[stream])
+          {
+            // ... then remove any pending listeners
+            qx.event.Registration.removeAllListeners(playground.c.Main[stream]);
+
+            // Reinitialize the stream
+            playground.c.Main[stream].init();
+          }
+          else
+          {
+            // Get the singleton instance of this stream
+            playground.c.Main[stream] = 
+              playground.c.stdio[qx.lang.String.firstUp(stream)].getInstance();
+          }
+        });
+
+      // Prepare the parser and symbol table for a new parse
+      playground.c.Main.__prepareParser(parser, error);
     },
 
     /**
@@ -646,8 +942,30 @@ qx.Class.define("playground.c.Main",
       var             line;
       var             button;
       var             message;
+      var             pending = playground.c.Main.__pendingParse;
+      var             cache = playground.c.Main.__parseCache;
       var             developer = false;
 
+      // If parse() or check() is awaiting this tree, save it for subsequent
+      // runs
+      if (pending)
+      {
+        playground.c.Main.__pendingParse = null;
+        pending.root = root;
+        cache.push(pending);
+        if (cache.length > playground.c.Main.PARSE_CACHE_MAX)
+        {
+          cache.shift();
+        }
+
+        // If we're only checking the syntax, we're done.
+        if (pending.bCheckOnly)
+        {
+          pending.bCheckOnly = false;
+          return;
+        }
+      }
+
       try
       {
         playground.c.Main._process(root, argv);
@@ -749,7 +1067,6 @@ qx.Class.define("playground.c.Main",
       var             origSp;
       var             data = {};
       var             argArr;
-      var             intSize;
       var             ptrSize;
       var             entry;
       var             symtab;
@@ -758,6 +1075,7 @@ qx.Class.define("playground.c.Main",
       var             declarator;
       var             function_decl;
       var             cmdLine;
+      var             bViewOpen;
       var             Memory = playground.c.machine.Memory;
       var             mem = Memory.getInstance();
 
@@ -789,7 +1107,7 @@ qx.Class.define("playground.c.Main",
           var             error;
           var             message;
 
-          error = fInclude();
+          error = fInclude(false);
           if (error)
           {
             // Show the error in the editor
@@ -868,6 +1186,13 @@ qx.Class.define("playground.c.Main",
                           Memory.info.gas.length);
         }
 
+        if (playground.c.Main.debugFlags.sched && programState)
+        {
+          console.log("Scheduler statistics: " +
+                      JSON.stringify(
+                        playground.c.lib.Scheduler.getStatistics()));
+        }
+
         // 'try' will fail when not in GUI environment
         try
         {
@@ -1080,7 +1405,6 @@ qx.Class.define("playground.c.Main",
             playground.c.lib.Symtab.display();
           }
 
-          intSize = Memory.typeSize["int"];
           ptrSize = Memory.typeSize["pointer"];
 
           // Get the symbol table entry for main, if it exists
@@ -1118,6 +1442,20 @@ qx.Class.define("playground.c.Main",
               // Do nothing. The call will fail when not running in the GUI
             }
 
+            // Symbol information for the memory template view need be
+            // maintained as the program runs only if the view is open.
+            try
+            {
+              bViewOpen =
+                qx.core.Init.getApplication().memTemplateBox.isVisible();
+            }
+            catch(e)
+            {
+              // Not running in the GUI, so there is no view
+              bViewOpen = false;
+            }
+            mem.setViewDetached(! bViewOpen);
+
 
             // Save the stack pointer, so we can restore it after the function
             // call
@@ -1214,12 +1552,14 @@ qx.Class.define("playground.c.Main",
                     getIsParameter  : function() { return false; }
                   });
 
-                // Now write each character to memory
-                arg.split("").forEach(
-                  function(ch, i)
-                  {
-                    mem.set(p + i, "char", ch.charCodeAt(0));
-                  });
+                // Now write the characters to memory
+                mem.setBytes(
+                  p,
+                  arg.split("").map(
+                    function(ch)
+                    {
+                      return ch.charCodeAt(0);
+                    }));
               });
 
             // We want to end on a word boundary. If there are an odd number
@@ -1280,21 +1620,23 @@ qx.Class.define("playground.c.Main",
 
             // Push the return address (our current line number) onto the stack
             sp = mem.stackPush("unsigned int", 0);
-            mem.setSymbolInfo(
-              sp,
-              {
-                getName         : function() { return "return to line #"; },
-                getType         : function() { return "int"; },
-                getUnsigned     : function() { return false; },
-                getSize         : function() { return intSize; },
-                getPointerCount : function() { return 0; },
-                getArraySizes   : function() { return []; },
-                getIsParameter  : function() { return false; }
-              });
+            mem.setReturnAddressInfo(sp);
 
             // Set symbol info for the root symbol table's symbols
             playground.c.lib.Symtab.getByName("*").addSymbols();
 
+            // Compile the tree into executor closures, now that the symbol
+            // tables have been built. The executors look up symbols as they
+            // run, so a tree reused by parse() needn't be compiled again.
+            if (! root._bCompiled)
+            {
+              root.compile();
+              root._bCompiled = true;
+            }
+
+            // Begin a new time slice, and reset the scheduler's statistics
+            playground.c.lib.Scheduler.reset();
+
             // Process main()
             try
             {
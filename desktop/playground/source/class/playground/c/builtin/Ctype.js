@@ -50,7 +50,7 @@ qx.Class.define("playground.c.builtin.Ctype",
     /** punctuation characters' ascii values. Initialized in defer */
     _PUNCT : null,
 
-    include : function(name, line)
+    include : function(name, line, bDeclareOnly)
     {
       var             rootSymtab;
       
@@ -28,7 +28,7 @@ qx.Class.define("playground.c.builtin.Draw",
   {
     _drawCanvas     : null,
 
-    include : function(name, line)
+    include : function(name, line, bDeclareOnly)
     {
       var             rootSymtab;
       var             mem;
@@ -44,49 +44,53 @@ qx.Class.define("playground.c.builtin.Draw",
         // Get the root symbol table
         rootSymtab = playground.c.lib.Symtab.getByName("*");
 
-        // Show the graphics canvas. Save the graphics canvas for later use.
-        terminal = qx.core.Init.getApplication().getUserData("terminal");
-        graphicsCanvas = terminal.getGraphicsCanvas();
-        graphicsCanvas.show();
-        
-        // Initialize the draw list
-        clazz._drawList = [];
-
-        // Dispose of any old drawing canvas
-        if (clazz._drawCanvas)
+        // Unless only declaring the functions, prepare to draw
+        if (! bDeclareOnly)
         {
-          clazz._drawCanvas.dispose();
-          clazz._drawCanvas = null;
-        }
+          // Show the graphics canvas. Save the graphics canvas for later use.
+          terminal = qx.core.Init.getApplication().getUserData("terminal");
+          graphicsCanvas = terminal.getGraphicsCanvas();
+          graphicsCanvas.show();
+        
+          // Initialize the draw list
+          clazz._drawList = [];
 
-        // Create the drawing canvas
-        clazz._drawCanvas = new qx.ui.embed.Canvas();
-        clazz._drawCanvas.set(
+          // Dispose of any old drawing canvas
+          if (clazz._drawCanvas)
           {
-            syncDimension : true
-          });
+            clazz._drawCanvas.dispose();
+            clazz._drawCanvas = null;
+          }
 
-        graphicsCanvas.addListenerOnce(
-          "appear",
-          function(e)
-          {
-            var             sizeHint;
+          // Create the drawing canvas
+          clazz._drawCanvas = new qx.ui.embed.Canvas();
+          clazz._drawCanvas.set(
+            {
+              syncDimension : true
+            });
 
-            // Determine the size of the parent, if yet known
-            sizeHint = graphicsCanvas.getInnerSize();
+          graphicsCanvas.addListenerOnce(
+            "appear",
+            function(e)
+            {
+              var             sizeHint;
 
-            clazz._drawCanvas.set(
-              {
-                canvasWidth  : sizeHint.width,
-                canvasHeight : sizeHint.height
-              });
-          });
+              // Determine the size of the parent, if yet known
+              sizeHint = graphicsCanvas.getInnerSize();
+
+              clazz._drawCanvas.set(
+                {
+                  canvasWidth  : sizeHint.width,
+                  canvasHeight : sizeHint.height
+                });
+            });
         
-        // Add it to the graphics canvas
-        graphicsCanvas.add(clazz._drawCanvas, { edge : 0 } );
+          // Add it to the graphics canvas
+          graphicsCanvas.add(clazz._drawCanvas, { edge : 0 } );
         
-        // When we get a redraw event, redraw everything in the draw list
-        clazz._drawCanvas.addListener("redraw", clazz.finalize);
+          // When we get a redraw event, redraw everything in the draw list
+          clazz._drawCanvas.addListener("redraw", clazz.finalize);
+        }
 
         //
         // Add built-in functions.
@@ -362,24 +366,13 @@ qx.Class.define("playground.c.builtin.Draw",
     
     draw_setColor : function(success, failure, color)
     {
-      var             i;
-      var             memBytes;
-      var             jStr;
-
-      // Get memory as an array
       if (! this._mem)
       {
         this._mem = playground.c.machine.Memory.getInstance();
       }
 
-      memBytes = this._mem.toArray(0);
-
       // Convert the ASCII color string to a JavaScript string
-      for (jStr = [], i = color; memBytes[i] != 0 && i < memBytes.length; i++)
-      {
-        jStr.push(memBytes[i]);
-      }
-      color = String.fromCharCode.apply(null, jStr);
+      color = this._mem.getString(color);
             
       playground.c.builtin.Draw.__draw_common(
         success,
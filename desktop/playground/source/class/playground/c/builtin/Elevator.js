@@ -56,7 +56,7 @@ qx.Class.define("playground.c.builtin.Elevator",
     _eventQueue     : null,
     _lastTime       : 0,
 
-    include : function(name, line)
+    include : function(name, line, bDeclareOnly)
     {
       var             rootSymtab;
       var             mem;
@@ -70,20 +70,26 @@ qx.Class.define("playground.c.builtin.Elevator",
         // Get the root symbol table
         rootSymtab = playground.c.lib.Symtab.getByName("*");
 
-        // Show the graphics canvas. Save the graphics canvas for later use.
-        terminal = qx.core.Init.getApplication().getUserData("terminal");
-        this._graphicsCanvas = terminal.getGraphicsCanvas();
-        this._graphicsCanvas.show();
-        
-        // Show the elevator and buttons in the graphics canvas
-        this._initAll();
+        // Unless only declaring the functions, show the elevator
+        if (! bDeclareOnly)
+        {
+          // Show the graphics canvas. Save the graphics canvas for later use.
+          terminal = qx.core.Init.getApplication().getUserData("terminal");
+          this._graphicsCanvas = terminal.getGraphicsCanvas();
+          this._graphicsCanvas.show();
+
+          // Show the elevator and buttons in the graphics canvas
+          this._initAll();
+        }
 
         //
-        // ... then add built-in functions.
+        // ... then add built-in functions. Each awaits the elevator or its
+        // buttons, so is marked as blocking.
         //
         [
           {
             name : "elevatorDown",
+            bBlocking : true,
             func : function()
             {
               var args = Array.prototype.slice.call(arguments);
@@ -92,6 +98,7 @@ qx.Class.define("playground.c.builtin.Elevator",
           },
           {
             name : "elevatorUp",
+            bBlocking : true,
             func : function()
             {
               var args = Array.prototype.slice.call(arguments);
@@ -100,6 +107,7 @@ qx.Class.define("playground.c.builtin.Elevator",
           },
           {
             name : "elevatorOpenDoors",
+            bBlocking : true,
             func : function()
             {
               var args = Array.prototype.slice.call(arguments);
@@ -108,6 +116,7 @@ qx.Class.define("playground.c.builtin.Elevator",
           },
           {
             name : "elevatorCloseDoors",
+            bBlocking : true,
             func : function()
             {
               var args = Array.prototype.slice.call(arguments);
@@ -117,6 +126,7 @@ qx.Class.define("playground.c.builtin.Elevator",
           },
           {
             name : "elevatorGetEvent",
+            bBlocking : true,
             func : function()
             {
               var args = Array.prototype.slice.call(arguments);
@@ -157,7 +167,7 @@ qx.Class.define("playground.c.builtin.Elevator",
                   return info.name;
                 }
               });
-            declarator.setBuiltIn(info.func);
+            declarator.setBuiltIn(info.func, info.bBlocking);
 
             // Add the declarator to the symbol table entry
             entry.setSpecAndDecl( [ declarator ]);
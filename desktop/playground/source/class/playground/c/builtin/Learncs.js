@@ -26,7 +26,7 @@ qx.Class.define("playground.c.builtin.Learncs",
   
   statics :
   {
-    include : function(name, line)
+    include : function(name, line, bDeclareOnly)
     {
       var             rootSymtab;
       var             mem;
@@ -40,11 +40,13 @@ qx.Class.define("playground.c.builtin.Learncs",
         rootSymtab = playground.c.lib.Symtab.getByName("*");
 
         //
-        // ... then add built-in functions.
+        // ... then add built-in functions. Both await input, so are marked as
+        // blocking.
         //
         [
           {
             name : "getInteger",
+            bBlocking : true,
             func : function()
             {
               var args = Array.prototype.slice.call(arguments);
@@ -53,6 +55,7 @@ qx.Class.define("playground.c.builtin.Learncs",
           },
           {
             name : "getString",
+            bBlocking : true,
             func : function()
             {
               var args = Array.prototype.slice.call(arguments);
@@ -93,7 +96,7 @@ qx.Class.define("playground.c.builtin.Learncs",
                   return info.name;
                 }
               });
-            declarator.setBuiltIn(info.func);
+            declarator.setBuiltIn(info.func, info.bBlocking);
 
             // Add the declarator to the symbol table entry
             entry.setSpecAndDecl( [ declarator ]);
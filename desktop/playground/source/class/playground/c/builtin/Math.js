@@ -26,7 +26,7 @@ qx.Class.define("playground.c.builtin.Math",
   
   statics :
   {
-    include : function(name, line)
+    include : function(name, line, bDeclareOnly)
     {
       var             rootSymtab;
       var             mem;
@@ -211,8 +211,9 @@ qx.Class.define("playground.c.builtin.Math",
             var             declarator;
             var             node;
 
-            // If there's an initialization function...
-            if (info.init)
+            // If there's an initialization function, and we're not only
+            // declaring the functions...
+            if (info.init && ! bDeclareOnly)
             {
               // ... then call it
               info.init();
@@ -450,8 +451,11 @@ qx.Class.define("playground.c.builtin.Math",
               ]);
             entry.calculateOffset();
             
-            // Save the constant's value
-            mem.set(entry.getAddr(), def.type, def.value);
+            // Save the constant's value, unless only declaring it
+            if (! bDeclareOnly)
+            {
+              mem.set(entry.getAddr(), def.type, def.value);
+            }
           });
       }
       catch(e)
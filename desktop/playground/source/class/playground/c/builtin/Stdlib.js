@@ -32,10 +32,22 @@ qx.Class.define("playground.c.builtin.Stdlib",
     // (inclusive).
     _RandMax : 0x7ffffffe,
 
+    /**
+     * Free heap blocks, ordered by address. Adjacent free blocks are always
+     * coalesced into a single block.
+     */
     __freeBlocks : [],
-    __usedBlocks : [],
 
-    include : function(name, line)
+    /** Allocated heap blocks, indexed by starting address */
+    __usedBlocks : {},
+
+    /** Number of heap bytes currently allocated */
+    __heapInUse : 0,
+
+    /** Greatest number of heap bytes allocated at once, during this run */
+    __heapPeak : 0,
+
+    include : function(name, line, bDeclareOnly)
     {
       var             mem;
       var             rootSymtab;
@@ -135,8 +147,10 @@ qx.Class.define("playground.c.builtin.Stdlib",
                   }
                 ];
               
-              // Initially, there's nothing on the used block list
-              playground.c.builtin.Stdlib.__usedBlocks = [];
+              // Initially, there are no used blocks
+              playground.c.builtin.Stdlib.__usedBlocks = {};
+              playground.c.builtin.Stdlib.__heapInUse = 0;
+              playground.c.builtin.Stdlib.__heapPeak = 0;
             }
           },
           {
@@ -147,6 +161,14 @@ qx.Class.define("playground.c.builtin.Stdlib",
               playground.c.builtin.Stdlib.rand.apply(null, args);
             }
           },
+          {
+            name : "realloc",
+            func : function()
+            {
+              var args = Array.prototype.slice.call(arguments);
+              playground.c.builtin.Stdlib.realloc.apply(null, args);
+            }
+          },
           {
             name : "srand",
             func : function()
@@ -162,8 +184,9 @@ qx.Class.define("playground.c.builtin.Stdlib",
             var             declarator;
             var             node;
 
-            // If there's an initialization function...
-            if (info.init)
+            // If there's an initialization function, and we're not only
+            // declaring the functions...
+            if (info.init && ! bDeclareOnly)
             {
               // ... then call it
               info.init();
@@ -251,8 +274,11 @@ qx.Class.define("playground.c.builtin.Stdlib",
               ]);
             entry.calculateOffset();
             
-            // Save the constant's value
-            mem.set(entry.getAddr(), def.type, def.value);
+            // Save the constant's value, unless only declaring it
+            if (! bDeclareOnly)
+            {
+              mem.set(entry.getAddr(), def.type, def.value);
+            }
           });
       }
       catch(e)
@@ -265,19 +291,29 @@ qx.Class.define("playground.c.builtin.Stdlib",
 
     finalize : function()
     {
-      if (playground.c.builtin.Stdlib.__usedBlocks.length > 0)
-      {
-        playground.c.builtin.Stdlib.__usedBlocks.forEach(
+      var             usedBlocks = playground.c.builtin.Stdlib.__usedBlocks;
+
+      // Report each block that was not freed, in address order
+      Object.keys(usedBlocks)
+        .map(
+          function(start)
+          {
+            return usedBlocks[start];
+          })
+        .sort(
+          function(a, b)
+          {
+            return a.start - b.start;
+          })
+        .forEach(
           function(block)
           {
             playground.c.Main.output(
               "*** Unfreed memory allocated at line " + block.line + ": " + 
                 block.size + " bytes, at address " +
-                (playground.view.c.MemoryWord.addrBase == 16 ? "0x" : "") +
-                block.start.toString(playground.view.c.MemoryWord.addrBase) + 
+                playground.c.builtin.Stdlib.__formatAddress(block.start) +
                 "\n");
           });
-      }
     },
 
     /**
@@ -349,34 +385,22 @@ qx.Class.define("playground.c.builtin.Stdlib",
      */
     atof : function(success, failure, str)
     {
-      var             i;
-      var             memBytes;
-      var             jStr = [];
-      var             converted;
-      var             specOrDecl;
+      var             jStr;
 
-      // Get memory as an array
       if (! this._mem)
       {
         this._mem = playground.c.machine.Memory.getInstance();
       }
 
-      memBytes = this._mem.toArray(0);
-
-      // Copy the null-terminated format string (which is represented as the
-      // ASCII character codes of each character) from the given address, one
-      // character at a time, into an array.
-      for (i = str; memBytes[i] != 0 && i < memBytes.length; i++)
-      {
-        jStr.push(memBytes[i]);
-      }
+      // Retrieve the null-terminated string from the given address
+      jStr = this._mem.getString(str);
       
       playground.c.builtin.Stdlib._commonFunction(
         success,
         failure,
         function()
         {
-          return parseFloat(String.fromCharCode.apply(null, jStr));
+          return parseFloat(jStr);
         },
         "atof() called with something other than " +
           "a string containing a number",
@@ -391,34 +415,22 @@ qx.Class.define("playground.c.builtin.Stdlib",
      */
     atoi : function(success, failure, str)
     {
-      var             i;
-      var             memBytes;
-      var             jStr = [];
-      var             converted;
-      var             specOrDecl;
+      var             jStr;
 
-      // Get memory as an array
       if (! this._mem)
       {
         this._mem = playground.c.machine.Memory.getInstance();
       }
 
-      memBytes = this._mem.toArray(0);
-
-      // Copy the null-terminated format string (which is represented as the
-      // ASCII character codes of each character) from the given address, one
-      // character at a time, into an array.
-      for (i = str; memBytes[i] != 0 && i < memBytes.length; i++)
-      {
-        jStr.push(memBytes[i]);
-      }
+      // Retrieve the null-terminated string from the given address
+      jStr = this._mem.getString(str);
       
       playground.c.builtin.Stdlib._commonFunction(
         success,
         failure,
         function()
         {
-          return parseInt(String.fromCharCode.apply(null, jStr), 10);
+          return parseInt(jStr, 10);
         },
         "atoi() called with something other than " +
           "a string containing a number",
@@ -433,34 +445,22 @@ qx.Class.define("playground.c.builtin.Stdlib",
      */
     atol : function(success, failure, str)
     {
-      var             i;
-      var             memBytes;
-      var             jStr = [];
-      var             converted;
-      var             specOrDecl;
+      var             jStr;
 
-      // Get memory as an array
       if (! this._mem)
       {
         this._mem = playground.c.machine.Memory.getInstance();
       }
 
-      memBytes = this._mem.toArray(0);
-
-      // Copy the null-terminated format string (which is represented as the
-      // ASCII character codes of each character) from the given address, one
-      // character at a time, into an array.
-      for (i = str; memBytes[i] != 0 && i < memBytes.length; i++)
-      {
-        jStr.push(memBytes[i]);
-      }
+      // Retrieve the null-terminated string from the given address
+      jStr = this._mem.getString(str);
       
       playground.c.builtin.Stdlib._commonFunction(
         success,
         failure,
         function()
         {
-          return parseInt(String.fromCharCode.apply(null, jStr), 10);
+          return parseInt(jStr, 10);
         },
         "atol() called with something other than " +
           "a string containing a number",
@@ -475,7 +475,6 @@ qx.Class.define("playground.c.builtin.Stdlib",
       playground.c.builtin.Stdlib.malloc(
         function(value)
         {
-          var             i;
           var             addr = value.value;
 
           // Get memory as an array
@@ -484,10 +483,10 @@ qx.Class.define("playground.c.builtin.Stdlib",
             this._mem = playground.c.machine.Memory.getInstance();
           }
 
-          // Fill each byte with null
-          for (i = 0; i < numBytes; i++)
+          // Fill each byte with null, unless the allocation failed
+          if (addr)
           {
-            this._mem.set(addr++, "char", 0);
+            this._mem.fill(addr, 0, numBytes);
           }
           
           // Return the value provided by malloc()
@@ -504,30 +503,15 @@ qx.Class.define("playground.c.builtin.Stdlib",
 
     free : function(success, failure, addr)
     {
-      var             j;
-      var             usedlist = playground.c.builtin.Stdlib.__usedBlocks;
+      var             block;
+      var             Stdlib = playground.c.builtin.Stdlib;
 
-      // Find the address to be freed in the used block list
-      for (j = 0; j < usedlist.length; j++)
+      // Find the block being freed
+      block = Stdlib.__usedBlocks[addr];
+      if (! block)
       {
-        // Did we find the block being freed?
-        if (usedlist[j].start === addr)
-        {
-          // No need to search further
-          break;
-        }
-      }
-      
-      // Did we find the block being freed?
-      if (j == usedlist.length)
-      {
-        // Nope. Fail the request.
-        failure(new playground.c.lib.RuntimeError(
-                  playground.c.lib.Node._currentNode,
-                  "Attempting to free() address " + 
-                    (playground.view.c.MemoryWord.addrBase == 16 ? "0x" : "") +
-                    addr.toString(playground.view.c.MemoryWord.addrBase) +
-                    " which is not currently malloced."));
+        // It's not allocated. Fail the request.
+        failure(Stdlib.__notMalloced("free", addr));
         return;
       }
       
@@ -549,12 +533,13 @@ qx.Class.define("playground.c.builtin.Stdlib",
           getUnsigned     : function() { return true; },
           getSize         : function() { return 1; },
           getPointerCount : function() { return 0; },
-          getArraySizes   : function() { return [ usedlist[j].origNumBytes ]; },
+          getArraySizes   : function() { return [ block.origNumBytes ]; },
           getIsParameter  : function() { return false; }
         });
 
-      // Remove this block from the used list
-      usedlist.splice(j, 1);
+      // This block is no longer in use. Return it to the free list.
+      delete Stdlib.__usedBlocks[addr];
+      Stdlib.__releaseBlock(block.start, block.size);
           
       // We successfully freed the block
       success();
@@ -564,112 +549,28 @@ qx.Class.define("playground.c.builtin.Stdlib",
 
     malloc : function(success, failure, numBytes)
     {
-      var             i;
-      var             j;
-      var             start = 0; // null
-      var             origNumBytes = numBytes;
-      var             usedBlock;
-      var             specAndDecl = [];
-      var             freelist = playground.c.builtin.Stdlib.__freeBlocks;
-      var             usedlist = playground.c.builtin.Stdlib.__usedBlocks;
-      var             WORDSIZE = playground.c.machine.Memory.WORDSIZE;
+      var             start;
+      var             size;
+      var             mem = playground.c.machine.Memory.getInstance();
+      var             Stdlib = playground.c.builtin.Stdlib;
 
-      // Ensure that blocks are always allocated on word boundaries by
-      // enlarging each request to be a multiple of WORDSIZE bytes.
-      if (numBytes % WORDSIZE !== 0)
-      {
-        numBytes += WORDSIZE - numBytes % WORDSIZE;
-      }
+      // Ensure that blocks are always allocated on word boundaries
+      size = Stdlib.__roundUp(numBytes);
 
-      // Find the first free block that's large enough for the required number
-      // of bytes.
-      for (i = 0; i < freelist.length; i++)
+      // Find a free block that's large enough, and take the required number
+      // of bytes from it. If there is none, start is null.
+      start = Stdlib.__allocBlock(size);
+      if (start)
       {
-        // Is there room in this block?
-        if (freelist[i].size > numBytes)
-        {
-          // Yup. Save this address
-          start = freelist[i].start;
-          
-          // Reduce this block's size by the number of bytes being allocated
-          freelist[i].size -= numBytes;
-          
-          // Increase its starting address too
-          freelist[i].start += numBytes;
-          
-          // Create a used block entry
-          usedBlock =
-            {
-              start        : start,
-              size         : numBytes,
-              origNumBytes : origNumBytes,
-              line         : playground.c.lib.Node._currentNode.line
-            };
-
-          // Add a 'used' block to the used block list. See where to insert it.
-          for (j = 0; j < usedlist.length - 1; j++)
-          {
-            // Does it fit here?
-            if (usedlist[j].start < start && usedlist[j + 1].start > start)
-            {
-              // Yes. Insert it
-              usedlist.splice(j + 1, 0, usedBlock);
-              
-              // Note that we've inserted it
-              usedBlock = null;
-              
-              // No need to search further
-              break;
-            }
-          }
-          
-          // Did we insert the used block?
-          if (usedBlock)
-          {
-            // No. It must go at the very end
-            usedlist.push(usedBlock);
-          }
-          
-          // Get the memory singleton
-          if (! this._mem)
-          {
-            this._mem = playground.c.machine.Memory.getInstance();
-          }
-
-          this._mem.setSymbolInfo(
-            start,
-            {
-              getName         : function() 
-              {
-                return "malloc at line " +
-                  playground.c.lib.Node._currentNode.line;
-              },
-              getType         : function() { return "char"; },
-              getUnsigned     : function() { return true; },
-              getSize         : function() { return 1; },
-              getPointerCount : function() { return 0; },
-              getArraySizes   : function() { return [ origNumBytes ]; },
-              getIsParameter  : function() { return false; }
-            });
-        }
+        // The block may have been in use before. Its contents are not
+        // initialized.
+        mem.markUninitialized(start, size);
+        Stdlib.__addUsedBlock(start, size, numBytes);
       }
-      
-      // If we get here, there is no memory of the required size
-      // available. 'start' is still NULL. Regardless of whether we found, or
-      // didn't find, a memory block to return, give 'em the current 'start'
-      // pointer.
-      specAndDecl.push(new playground.c.lib.Declarator(
-                         playground.c.lib.Node._currentNode,
-                         "pointer"));
-      specAndDecl.push(new playground.c.lib.Specifier(
-                         playground.c.lib.Node._currentNode,
-                         "void"));
 
-      success(
-        {
-          value       : start,
-          specAndDecl : specAndDecl
-        });
+      // Regardless of whether we found, or didn't find, a memory block to
+      // return, give 'em the current 'start' pointer.
+      success(Stdlib.__pointerResult(start));
     },
     
     rand : function(success, failure)
@@ -688,6 +589,115 @@ qx.Class.define("playground.c.builtin.Stdlib",
         "int");
     },
 
+    realloc : function(success, failure, addr, numBytes)
+    {
+      var             i;
+      var             next;
+      var             block;
+      var             start;
+      var             size;
+      var             freelist;
+      var             mem = playground.c.machine.Memory.getInstance();
+      var             Stdlib = playground.c.builtin.Stdlib;
+
+      // realloc(NULL, n) is equivalent to malloc(n)
+      if (! addr)
+      {
+        Stdlib.malloc(success, failure, numBytes);
+        return;
+      }
+
+      // Find the block being reallocated
+      block = Stdlib.__usedBlocks[addr];
+      if (! block)
+      {
+        // It's not allocated. Fail the request.
+        failure(Stdlib.__notMalloced("realloc", addr));
+        return;
+      }
+
+      // realloc(p, 0) frees the block and returns NULL
+      if (numBytes === 0)
+      {
+        Stdlib.free(
+          function()
+          {
+            success(Stdlib.__pointerResult(0));
+          },
+          failure,
+          addr);
+        return;
+      }
+
+      size = Stdlib.__roundUp(numBytes);
+      freelist = Stdlib.__freeBlocks;
+
+      // If it's shrinking, return the excess to the free list
+      if (size <= block.size)
+      {
+        if (size < block.size)
+        {
+          Stdlib.__releaseBlock(block.start + size, block.size - size);
+        }
+
+        Stdlib.__addUsedBlock(block.start, size, numBytes);
+        success(Stdlib.__pointerResult(block.start));
+        return;
+      }
+
+      // If the free block immediately following this one is large enough,
+      // grow in place.
+      i = Stdlib.__findFreeIndex(block.start);
+      next = freelist[i];
+      if (next &&
+          next.start == block.start + block.size &&
+          next.size >= size - block.size)
+      {
+        next.start += size - block.size;
+        next.size -= size - block.size;
+        if (next.size === 0)
+        {
+          freelist.splice(i, 1);
+        }
+        Stdlib.__countAllocated(size - block.size);
+
+        // The added bytes are not initialized
+        mem.markUninitialized(block.start + block.origNumBytes,
+                              size - block.origNumBytes);
+
+        Stdlib.__addUsedBlock(block.start, size, numBytes);
+        success(Stdlib.__pointerResult(block.start));
+        return;
+      }
+
+      // Otherwise, allocate a new block. If there's no room, the original
+      // block is left untouched and NULL is returned.
+      start = Stdlib.__allocBlock(size);
+      if (! start)
+      {
+        success(Stdlib.__pointerResult(0));
+        return;
+      }
+
+      // Copy the original contents. Moving them retains knowledge of which
+      // bytes have not been initialized. The bytes beyond them are not
+      // initialized.
+      mem.markUninitialized(start + block.origNumBytes,
+                            size - block.origNumBytes);
+      for (i = 0; i < block.origNumBytes; i++)
+      {
+        mem.move(block.start + i, "unsigned char",
+                 start + i, "unsigned char");
+      }
+
+      // Release the original block, and use the new one.
+      delete Stdlib.__usedBlocks[block.start];
+      mem.removeSymbolInfo(block.start);
+      Stdlib.__releaseBlock(block.start, block.size);
+      Stdlib.__addUsedBlock(start, size, numBytes);
+      success(Stdlib.__pointerResult(start));
+    },
+
     srand : function(success, failure, seed)
     {
       playground.c.builtin.Stdlib._commonFunction(
@@ -701,6 +711,308 @@ qx.Class.define("playground.c.builtin.Stdlib",
         },
         "Internal error: rand() failed",
         "void");
+    },
+
+    /**
+     * Round a requested allocation size up to a multiple of the word size,
+     * so that blocks are always allocated on word boundaries
+     *
+     * @param numBytes {Number}
+     *   The requested number of bytes
+     *
+     * @return {Number}
+     *   The number of bytes to allocate
+     */
+    __roundUp : function(numBytes)
+    {
+      var             WORDSIZE = playground.c.machine.Memory.WORDSIZE;
+
+      // Even an empty block must have a unique address
+      if (numBytes === 0)
+      {
+        return WORDSIZE;
+      }
+
+      if (numBytes % WORDSIZE !== 0)
+      {
+        numBytes += WORDSIZE - numBytes % WORDSIZE;
+      }
+
+      return numBytes;
+    },
+
+    /**
+     * Find the index in the free list of the first free block beginning
+     * above a given address
+     *
+     * @param addr {Number}
+     *   The address to search for
+     *
+     * @return {Number}
+     *   The index at which a free block beginning at addr would be inserted
+     */
+    __findFreeIndex : function(addr)
+    {
+      var             mid;
+      var             low = 0;
+      var             high = playground.c.builtin.Stdlib.__freeBlocks.length;
+      var             freelist = playground.c.builtin.Stdlib.__freeBlocks;
+
+      // Binary search the address-ordered free list
+      while (low < high)
+      {
+        mid = (low + high) >> 1;
+        if (freelist[mid].start <= addr)
+        {
+          low = mid + 1;
+        }
+        else
+        {
+          high = mid;
+        }
+      }
+
+      return low;
+    },
+
+    /**
+     * Take a block of memory from the first free block large enough to
+     * hold it
+     *
+     * @param size {Number}
+     *   The number of bytes to allocate, a multiple of the word size
+     *
+     * @return {Number}
+     *   The address of the allocated block, or 0 (NULL) if there is no
+     *   free block large enough.
+     */
+    __allocBlock : function(size)
+    {
+      var             i;
+      var             start;
+      var             freelist = playground.c.builtin.Stdlib.__freeBlocks;
+
+      for (i = 0; i < freelist.length; i++)
+      {
+        // Is there room in this block?
+        if (freelist[i].size >= size)
+        {
+          // Yup. Take the requested bytes from its beginning.
+          start = freelist[i].start;
+          freelist[i].start += size;
+          freelist[i].size -= size;
+
+          // If that consumed the whole block, remove it from the free list
+          if (freelist[i].size === 0)
+          {
+            freelist.splice(i, 1);
+          }
+
+          playground.c.builtin.Stdlib.__countAllocated(size);
+          return start;
+        }
+      }
+
+      // There's no block large enough
+      return 0;
+    },
+
+    /**
+     * Return a block of memory to the free list, coalescing it with any
+     * adjacent free blocks
+     *
+     * @param start {Number}
+     *   The address of the block being released
+     *
+     * @param size {Number}
+     *   The number of bytes in the block
+     */
+    __releaseBlock : function(start, size)
+    {
+      var             i;
+      var             prev;
+      var             next;
+      var             freelist = playground.c.builtin.Stdlib.__freeBlocks;
+
+      playground.c.builtin.Stdlib.__countAllocated(-size);
+
+      // Find where this block belongs in the address-ordered list
+      i = playground.c.builtin.Stdlib.__findFreeIndex(start);
+      prev = freelist[i - 1];
+      next = freelist[i];
+
+      // Does it abut the preceding free block?
+      if (prev && prev.start + prev.size == start)
+      {
+        // Yup. Extend that block.
+        prev.size += size;
+
+        // Does the following free block now abut it too?
+        if (next && prev.start + prev.size == next.start)
+        {
+          // Yup. Merge them.
+          prev.size += next.size;
+          freelist.splice(i, 1);
+        }
+      }
+      else if (next && start + size == next.start)
+      {
+        // It abuts the following free block. Extend that block downward.
+        next.start = start;
+        next.size += size;
+      }
+      else
+      {
+        // It's not adjacent to any free block. Insert it.
+        freelist.splice(i, 0, { start : start, size : size });
+      }
+    },
+
+    /**
+     * Account for a change in the number of heap bytes allocated, and
+     * maintain the peak
+     *
+     * @param size {Number}
+     *   The number of bytes newly allocated, or, if negative, released
+     */
+    __countAllocated : function(size)
+    {
+      var             Stdlib = playground.c.builtin.Stdlib;
+
+      Stdlib.__heapInUse += size;
+      if (Stdlib.__heapInUse > Stdlib.__heapPeak)
+      {
+        Stdlib.__heapPeak = Stdlib.__heapInUse;
+      }
+    },
+
+    /**
+     * Retrieve the greatest number of heap bytes that were allocated at
+     * once, including the allocator's rounding of each request, since the
+     * program began running.
+     *
+     * @return {Number}
+     *   The peak heap usage, in bytes
+     */
+    getPeakHeapUsage : function()
+    {
+      return playground.c.builtin.Stdlib.__heapPeak;
+    },
+
+    /**
+     * Record a block as allocated, and label it in the memory template view
+     *
+     * @param start {Number}
+     *   The address of the block
+     *
+     * @param size {Number}
+     *   The number of bytes in the block
+     *
+     * @param origNumBytes {Number}
+     *   The number of bytes requested by the program
+     */
+    __addUsedBlock : function(start, size, origNumBytes)
+    {
+      playground.c.builtin.Stdlib.__usedBlocks[start] =
+        {
+          start        : start,
+          size         : size,
+          origNumBytes : origNumBytes,
+          line         : playground.c.lib.Node._currentNode.line
+        };
+
+      playground.c.machine.Memory.getInstance().setSymbolInfo(
+        start,
+        {
+          getName         : function() 
+          {
+            return "malloc at line " +
+              playground.c.lib.Node._currentNode.line;
+          },
+          getType         : function() { return "char"; },
+          getUnsigned     : function() { return true; },
+          getSize         : function() { return 1; },
+          getPointerCount : function() { return 0; },
+          getArraySizes   : function() { return [ origNumBytes ]; },
+          getIsParameter  : function() { return false; }
+        });
+    },
+
+    /**
+     * Create the error for an attempt to free or reallocate memory which is
+     * not currently allocated
+     *
+     * @param name {String}
+     *   The name of the function being called
+     *
+     * @param addr {Number}
+     *   The address provided to that function
+     *
+     * @return {playground.c.lib.RuntimeError}
+     *   The error, to be passed to the failure function
+     */
+    __notMalloced : function(name, addr)
+    {
+      return new playground.c.lib.RuntimeError(
+        playground.c.lib.Node._currentNode,
+        "Attempting to " + name + "() address " + 
+          playground.c.builtin.Stdlib.__formatAddress(addr) +
+          " which is not currently malloced.");
+    },
+
+    /**
+     * Format an address for a message, in the base in which the memory view
+     * displays addresses. In a non-gui environment, use base 10.
+     *
+     * @param addr {Number}
+     *   The address to be formatted
+     *
+     * @return {String}
+     *   The formatted address
+     */
+    __formatAddress : function(addr)
+    {
+      var             base;
+
+      try
+      {
+        // If gui environment, obtain base from memory view
+        base = playground.view.c.MemoryWord.addrBase;
+      }
+      catch(e)
+      {
+        // Otherwise, assume base 10
+        base = 10;
+      }
+
+      return (base == 16 ? "0x" : "") + addr.toString(base);
+    },
+
+    /**
+     * Create the return value of a function returning void *
+     *
+     * @param addr {Number}
+     *   The address to return
+     *
+     * @return {Map}
+     *   The value and its specifier/declarator list
+     */
+    __pointerResult : function(addr)
+    {
+      var             specAndDecl = [];
+
+      specAndDecl.push(new playground.c.lib.Declarator(
+                         playground.c.lib.Node._currentNode,
+                         "pointer"));
+      specAndDecl.push(new playground.c.lib.Specifier(
+                         playground.c.lib.Node._currentNode,
+                         "void"));
+
+      return (
+        {
+          value       : addr,
+          specAndDecl : specAndDecl
+        });
     }
   },
   
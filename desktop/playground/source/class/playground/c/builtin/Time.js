@@ -26,7 +26,7 @@ qx.Class.define("playground.c.builtin.Time",
   
   statics :
   {
-    include : function(name, line)
+    include : function(name, line, bDeclareOnly)
     {
       var             mem;
       var             rootSymtab;
@@ -58,8 +58,9 @@ qx.Class.define("playground.c.builtin.Time",
             var             declarator;
             var             node;
 
-            // If there's an initialization function...
-            if (info.init)
+            // If there's an initialization function, and we're not only
+            // declaring the functions...
+            if (info.init && ! bDeclareOnly)
             {
               // ... then call it
               info.init();
@@ -156,8 +157,11 @@ qx.Class.define("playground.c.builtin.Time",
               ]);
             entry.calculateOffset();
             
-            // Save the constant's value
-            mem.set(entry.getAddr(), def.type, def.value);
+            // Save the constant's value, unless only declaring it
+            if (! bDeclareOnly)
+            {
+              mem.set(entry.getAddr(), def.type, def.value);
+            }
           });
 
         // Define types
@@ -53,6 +53,7 @@ qx.Class.define("playground.c.lib.Declarator",
     __numElem      : null,
     __functionNode : null,
     __builtIn      : null,
+    __bBlocking    : false,
     __constant     : null,
     
     /**
@@ -147,8 +148,16 @@ qx.Class.define("playground.c.lib.Declarator",
 
     /**
      * Set a builtIn function
+     *
+     * @param func {Function}
+     *   The function implementing the built-in
+     *
+     * @param bBlocking {Boolean?}
+     *   Whether the function may wait (e.g., for input) before calling its
+     *   success or failure function. Calls to any other built-in may be
+     *   compiled to complete synchronously.
      */
-    setBuiltIn : function(func)
+    setBuiltIn : function(func, bBlocking)
     {
       // Ensure we have a valid value
       if (! (func instanceof Function))
@@ -162,6 +171,7 @@ qx.Class.define("playground.c.lib.Declarator",
       
       // Save the new value
       this.__builtIn = func;
+      this.__bBlocking = !! bBlocking;
     },
 
     /**
@@ -172,6 +182,14 @@ qx.Class.define("playground.c.lib.Declarator",
       return this.__builtIn;
     },
 
+    /**
+     * Determine whether a built-in function may wait before completing
+     */
+    isBuiltInBlocking : function()
+    {
+      return this.__bBlocking;
+    },
+
     /**
      * Set the constantness. This is for array parameters (which may not
      * be altered), and later for constant pointers, e.g., int * const p;
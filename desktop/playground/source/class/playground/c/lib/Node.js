@@ -10,6 +10,8 @@
 /*
 @ignore(require)
 @ignore(qx.bConsole)
+@ignore(setTimeout)
+@ignore(clearTimeout)
  */
 
 /**
@@ -22,6 +24,7 @@ if (typeof qx === "undefined" || qx.bConsole)
   qx = require("qooxdoo");
   qx.bConsole = true;
   require("./Symtab");
+  require("./Scheduler");
   require("./NodeArray");
   require("./Specifier");
   require("./Declarator");
@@ -111,7 +114,7 @@ qx.Class.define("playground.c.lib.Node",
     /** Maximum number of recursive calls before unwind */
     _unwindInit : 0,            // initialized in defer
 
-    /** Number of recursive calls remaining before we must unwind via timeout */
+    /** Number of recursive calls remaining before we must unwind the stack */
     _unwindCount : 0,           // initialized in defer
 
     /** Depth of function call, for activation record name */
@@ -172,6 +175,86 @@ qx.Class.define("playground.c.lib.Node",
     getNull : function(line)
     {
       return new playground.c.lib.Node("_null_", null, line);
+    },
+
+    /**
+     * Determine whether a node's compiled executor may be used in place of
+     * process(). The compiled executors bypass the stop, unwind, and
+     * debugger handling at the top of process(), so they may be used only
+     * when none of that handling is required for this node.
+     *
+     * @param node {playground.c.lib.Node}
+     *   The node about to be executed
+     *
+     * @return {Boolean}
+     *   true if the node's compiled executor may be used; false if the node
+     *   must be processed by process().
+     */
+    _canRunCompiled : function(node)
+    {
+      var             Node = playground.c.lib.Node;
+      var             line;
+      var             lastLine;
+      var             application;
+      var             editor;
+      var             breakpoints;
+
+      // If a stop was requested, or it's time to unwind the stack, let
+      // process() handle it.
+      if (Node._bStop || Node._unwindCount <= 0)
+      {
+        return false;
+      }
+
+      // A node with a synchronous evaluator executes its entire subtree in
+      // one step, so all lines spanned by that subtree must be considered.
+      lastLine = node._eval ? node._lastLine : node.line;
+
+      // If the line number hasn't changed, or this is a null node (which
+      // process() doesn't consider to be at any line), there's no debugger
+      // work to do
+      if ((node.line === Node._prevLine && lastLine <= node.line) ||
+          node.type == "_null_")
+      {
+        return true;
+      }
+
+      // Determine whether we're in the GUI, with its memory template view.
+      // If not, there's no debugger.
+      application = qx.core.Init && qx.core.Init.getApplication();
+      if (! application || ! application.memTemplate)
+      {
+        return true;
+      }
+
+      // If we're single-stepping, a debugger button listener is still
+      // active, or the memory template view timer has not yet been started,
+      // then process() must handle the line change.
+      if (Node._bStep ||
+          Node._stepListenerId ||
+          Node._continueListenerId ||
+          Node._stopListenerId ||
+          ! Node._memoryViewTimer)
+      {
+        return false;
+      }
+
+      // Is there a breakpoint at any of the lines about to be executed?
+      editor = application.getUserData("sourceeditor");
+      breakpoints = editor.getBreakpoints();
+      for (line = node.line; line <= lastLine; line++)
+      {
+        if (breakpoints[line - 1])
+        {
+          // Yup. process() will stop there.
+          return false;
+        }
+      }
+
+      // No debugger action is required. Track the new line, as process()
+      // would have.
+      Node._prevLine = lastLine;
+      return true;
     }
   },
   
@@ -179,7 +262,16 @@ qx.Class.define("playground.c.lib.Node",
   {
     /** The symbol table associated with this specific node */
     _symtab : null,
-    
+
+    /** The compiled executor for this node, if any. See compile(). */
+    _exec : null,
+
+    /** The synchronous evaluator for this node, if any. See compile(). */
+    _eval : null,
+
+    /** The last source line spanned by this node's subtree */
+    _lastLine : 0,
+
     /**
      * Display an error message regarding this node
      *
@@ -555,7 +647,6 @@ qx.Class.define("playground.c.lib.Node",
       var             addr;
       var             name;
       var             offset;
-      var             intSize;
       var             depth;
       var             subnode;
       var             entry;
@@ -600,6 +691,17 @@ qx.Class.define("playground.c.lib.Node",
       var             WORDSIZE = playground.c.machine.Memory.WORDSIZE;
 
 
+      // If this node has been compiled, and there's nothing that requires
+      // the full interpreter, use its compiled executor.
+      if (bExecuting && this._exec &&
+          playground.c.lib.Node._canRunCompiled(this))
+      {
+        --playground.c.lib.Node._unwindCount;
+        playground.c.lib.Node._currentNode = this;
+        this._exec(data, success, failure);
+        return;
+      }
+
       // Function to process all initializers after completion of reserving
       // memory for variables. Doing this as a post-processing step prevents
       // function calls in initializers from messing up the stack while the
@@ -679,8 +781,9 @@ qx.Class.define("playground.c.lib.Node",
         playground.c.lib.Node._unwindCount =
           playground.c.lib.Node._unwindInit;
 
-        // Unwind the stack by executing via timeout to continue shortly.
-        window.setTimeout(
+        // Unwind the stack, and continue shortly. The scheduler decides
+        // whether it's also time to yield to the browser.
+        playground.c.lib.Scheduler.continueLater(
           function()
           {
             try
@@ -692,7 +795,7 @@ qx.Class.define("playground.c.lib.Node",
               failure(e);
             }
           }.bind(this),
-          0);
+          playground.c.lib.Node._unwindInit + 1);
         return;
       }
 
@@ -700,30 +803,42 @@ qx.Class.define("playground.c.lib.Node",
       {
         function displayMemoryTemplateView()
         {
+          var             mem;
           var             model;
           var             oldModel;
           var             memData;
 
-          // Retrieve the old model from the memory template view
-          oldModel = memTemplate.getModel();
+          mem = playground.c.machine.Memory.getInstance();
 
-          // Retrieve the data in memory, ...
-          memData = playground.c.machine.Memory.getInstance().getDataModel();
+          // In a Web Worker, the memory template view is in the user
+          // interface thread, so send it a snapshot of memory. Otherwise, if
+          // only the contents of memory have changed, update just the
+          // modified words of the old model. Otherwise...
+          if (memTemplate.setSnapshot)
+          {
+            memTemplate.setSnapshot(mem.getSnapshot());
+          }
+          else if (! (oldModel = memTemplate.getModel()) ||
+                   ! mem.updateDataModel(oldModel))
+          {
+            // ... retrieve the data in memory, ...
+            memData = mem.getDataModel();
 
-          // ... convert it to a qx.data.Array, ...
-          model = qx.data.marshal.Json.createModel(memData);
+            // ... convert it to a qx.data.Array, ...
+            model = qx.data.marshal.Json.createModel(memData);
 
-          // ... and update the memory template view.
-          memTemplate.setModel(model);
+            // ... and update the memory template view.
+            memTemplate.setModel(model);
 
-          // Explicitly dispose the old model
-          oldModel && oldModel.dispose();
+            // Explicitly dispose the old model
+            oldModel && oldModel.dispose();
+          }
 
           // Cancel the timer that will redisplay the memory template view
-          window.clearTimeout(playground.c.lib.Node._memoryViewTimer);
+          clearTimeout(playground.c.lib.Node._memoryViewTimer);
 
           // Start the timer to redisplay the memory template view
-          playground.c.lib.Node._memoryViewTimer = window.setTimeout(
+          playground.c.lib.Node._memoryViewTimer = setTimeout(
             displayMemoryTemplateView,
             2000);
         }
@@ -741,7 +856,7 @@ qx.Class.define("playground.c.lib.Node",
           if (! playground.c.lib.Node._memoryViewTimer)
           {
             // ... then do so now
-            playground.c.lib.Node._memoryViewTimer = window.setTimeout(
+            playground.c.lib.Node._memoryViewTimer = setTimeout(
               displayMemoryTemplateView,
               0);
           }
@@ -814,6 +929,13 @@ qx.Class.define("playground.c.lib.Node",
             // Set program state
             qx.core.Init.getApplication().setProgramState("stopped");
 
+            // If symbol information was not being maintained for the memory
+            // template view, reconstruct it now.
+            if (playground.c.lib.Node.__mem.isViewDetached())
+            {
+              playground.c.lib.Node.__mem.restoreSymbolInfo();
+            }
+
             // Display the memory template view
             displayMemoryTemplateView();
 
@@ -1196,48 +1318,8 @@ qx.Class.define("playground.c.lib.Node",
             bExecuting,
             function(v)
             {
-              var             origSpecAndDecl;
-
-              value1 = this.getExpressionValue(v, data);
-
-              // Save the original specifier/declarator list
-              origSpecAndDecl = value1.specAndDecl.slice(0);
-
-              // Pull the first specifier/declarator off of the list. We'll
-              // replace it with one containing the (possibly unaltered)
-              // promoted type.
-              specOrDecl = value1.specAndDecl.shift();
-
-              // Is this a declarator?
-              if (specOrDecl instanceof playground.c.lib.Declarator)
-              {
-                // Yup. We're going to push an address
-                type = "pointer";
-              }
-              else
-              {
-                // It's a specifier. Get a new specifier with a (possibly)
-                // increased size appropriate as a promoted argument.
-                specOrDecl = specOrDecl.promote();
-
-                // Get the memory access type from this specifier
-                type = specOrDecl.getCType();
-              }
-
-              // Put the (possibly altered) specifier/declarator back onto the
-              // list of specifiers/declarators
-              value1.specAndDecl.unshift(specOrDecl);
-
               // Save this argument
-              data.args.unshift(value1.value);
-              data.argTypes.unshift(origSpecAndDecl);
-
-              // If this is not a built-in function...
-              if (! data.isBuiltin)
-              {
-                // ... then push the arguments onto the stack
-                playground.c.lib.Node.__mem.stackPush(type, value1.value);
-              }
+              this.__pushArgument(v, data);
               
               if (--i >= 0)
               {
@@ -1359,89 +1441,19 @@ qx.Class.define("playground.c.lib.Node",
           bExecuting,
           function(v)
           {
-            value1 = v;
-            
-            // Figure out where the specifier/declarator list is, and retrieve
-            // it.
-            if (value1 instanceof playground.c.lib.SymtabEntry)
-            {
-              specAndDecl = value1.getSpecAndDecl();
-            }
-            else
-            {
-              specAndDecl = value1.specAndDecl;
-              
-              // If we got the address of an array, reduce it to just array
-              if (specAndDecl.length >= 2 &&
-                  specAndDecl[0].getType() == "address" &&
-                  specAndDecl[1].getType() == "array")
-              {
-                // Remove the 'address' declarator
-                specAndDecl.shift();
-              }
-            }
-
-            // Look at the first specifier/declarator to ensure this can be
-            // indexed
-            specOrDecl = specAndDecl[0];
-
-            // Ensure this an array or a pointer
-            type = specOrDecl.getType();
-            switch(type)
-            {
-            case "array" :
-            case "pointer" :
-              break;
-
-            default :
-              this._throwIt(new playground.c.lib.RuntimeError(
-                              this,
-                              "Can't access an array element of something " +
-                                "that is not an array"),
-                            success,
-                            failure);
-              return;
-            }
+            var             base;
 
-            // If we got a symbol table entry...
-            if (value1 instanceof playground.c.lib.SymtabEntry)
+            // Ensure that it can be indexed, and find its elements' size
+            try
             {
-              // ... then retrieve the symbol's address
-              addr = value1.getAddr();
-
-              // If this is a pointer...
-              if (type == "pointer" || value1.getIsParameter())
-              {
-                // ... then we need to get the address that the pointer points
-                // to.
-                addr = playground.c.lib.Node.__mem.get(addr, "pointer", true); 
-              }
+              base = this.__elementBase(v);
             }
-            else
+            catch(e)
             {
-              // We already have an address
-              addr = value1.value;
+              failure(e);
+              return;
             }
 
-            // Figure out the size of each array element
-            // First, get a copy of the specifier/declarator list
-            specAndDecl = specAndDecl.slice(0);
-
-            // Strip off the initial (pointer or array) entry to find out how
-            // many bytes a value of the remaining specifier/declarator
-            // consumes
-            specAndDecl.shift();
-
-            // Determine the memory type of the value
-            specOrDecl = specAndDecl[0];
-            type =
-              specOrDecl instanceof playground.c.lib.Declarator
-              ? "pointer"
-              : specAndDecl[0].getCType();
-
-            // Calculate the byte count
-            offset = specAndDecl[0].calculateByteCount(1, specAndDecl, 0);
-
             // Get the index
             this.children[1].process(
               data,
@@ -1449,36 +1461,19 @@ qx.Class.define("playground.c.lib.Node",
               function(v)
               {
                 value2 = this.getExpressionValue(v, data);
-                
-                // We'd better have a specifier to say what type this is.
-                specOrDecl = value2.specAndDecl[0];
-                if (! (specOrDecl instanceof playground.c.lib.Specifier) ||
-                    specOrDecl.getType() != "int")
+
+                // Calculate the address of the element
+                try
+                {
+                  value3 = this.__elementAddress(base, value2);
+                }
+                catch(e)
                 {
-                  this._throwIt(new playground.c.lib.RuntimeError(
-                                  this,
-                                  "Array index must evaluate to an integer"),
-                                success,
-                                failure);
+                  failure(e);
                   return;
                 }
 
-                // Multiply together the byte count of each element, and the
-                // desired index, to yield a byte offset to the element's
-                // value
-                offset *= value2.value;
-
-                // Prepend a special "address" declarator
-                specAndDecl.unshift(new playground.c.lib.Declarator(this,
-                                                                    "address"));
-
-                // The return value will be the value at the calculated
-                // address plus the offset.
-                success(
-                  {
-                  value       : addr + offset,
-                  specAndDecl : specAndDecl
-                  });
+                success(value3);
               }.bind(this),
               failure);
           }.bind(this),
@@ -1786,89 +1781,10 @@ qx.Class.define("playground.c.lib.Node",
               bExecuting,
               function(v)
               {
-                var             oldType;
-                var             newType;
-                var             typeSize;
-
                 value1 = this.getExpressionValue(v, data);
-                
-                // Determine the type of the original value
-                specOrDecl = value1.specAndDecl[0];
-                if (specOrDecl instanceof playground.c.lib.Declarator)
-                {
-                  // We found a declarator, meaning the original type was
-                  // either a pointer or an array, both of which we take to be
-                  // pointer.
-                  oldType = "pointer";
-                }
-                else
-                {
-                  // Get the type from this specifier
-                  oldType = specOrDecl.getCType();
-                }
-                
-                // Determine the type in memory
-                specOrDecl = castData.specAndDecl[0];
-                if (specOrDecl instanceof playground.c.lib.Declarator)
-                {
-                  // We found a declarator, meaning the new type is
-                  // either a pointer or an array, both of which we take to be
-                  // pointer.
-                  newType = "pointer";
-                }
-                else
-                {
-                  // Get the type from this specifier
-                  newType = specOrDecl.getCType();
-                }
-                
-                // Determine the value's original size in bytes
-                typeSize = playground.c.machine.Memory.typeSize[oldType];
-                
-                // If it's less than the word size, we'll sign-extend.
-                if (typeSize < playground.c.machine.Memory.WORDSIZE)
-                {
-                  // Convert that size to a number of bits
-                  typeSize *= 8;
-
-                  // If the value's high bit is on...
-                  if (value1.value & (1 << (typeSize - 1)))
-                  {
-                    // ... then fill the register with 1s
-                    playground.c.lib.Node.__mem.setReg("R1", "long", -1);
-                  }
-                  else
-                  {
-                    // otherwise, fill the register with 0s.
-                    playground.c.lib.Node.__mem.setReg("R1", "long", 0);
-                  }
-                }
 
-                // If the old type's size is bigger than the new type's size...
-                if (playground.c.machine.Memory.typeSize[oldType] >
-                    playground.c.machine.Memory.typeSize[newType])
-                {
-                  // ... then reduce the size by writing the value to memory
-                  // using the value's original specifier/declarator list and
-                  // reading it back using the cast's specifier/declarator
-                  // list.
-                  playground.c.lib.Node.__mem.setReg("R1",
-                                                     oldType, 
-                                                     value1.value);
-                  value1.value = playground.c.lib.Node.__mem.getReg("R1",
-                                                                    newType);
-                }
-                
-                // Save the value as its new type, then retrieve it, to do the
-                // actual conversion (if necessary)
-                playground.c.lib.Node.__mem.setReg("R1", newType, value1.value);
-                value1.value = playground.c.lib.Node.__mem.getReg("R1",
-                                                                  newType);
-                
-                // Assign the cast's specifier/declarator list to the value
-                value1.specAndDecl = castData.specAndDecl;
-                
-                success(value1);
+                // Convert it to the new type
+                success(this.__cast(castData, value1));
               }.bind(this),
               failure);
           }.bind(this),
@@ -2254,108 +2170,16 @@ qx.Class.define("playground.c.lib.Node",
           bExecuting,
           function(v)
           {
-            var             typeDescription;
-
-            value = v;
-
-            // If we found a symbol, get its address and type
-            if (value instanceof playground.c.lib.SymtabEntry)
-            {
-              // Find the address from which we will retrieve the pointer
-              addr = value.getAddr();
-
-              // Obtain the specifier/declarator list
-              specAndDecl = value.getSpecAndDecl().slice(0);
-
-              // Get the address contained in this pointer
-              if (specAndDecl[0].getType() != "array")
-              {
-                addr = playground.c.lib.Node.__mem.get(addr, "pointer", true);
-              }
-            }
-            else
-            {
-              // Find the address from which we will retrieve the pointer
-              addr = value.value;
-
-              // Obtain the specifier/declarator list
-              specAndDecl = value.specAndDecl.slice(0);
-            }
-
-            if (false)
-            {
-              specAndDecl.forEach(
-                function(specOrDecl)
-                {
-                  specOrDecl.display();
-                });
-              console.log("\n");
-            }
-
-            // Pull the first specifier/declarator off of the list
-            specOrDecl = specAndDecl.shift();
-            type = specOrDecl.getType();
-
-            // Ensure that we can dereference this thing. To be able to, it
-            // must be either a pointer whose value must be retrieved, or
-            // already an adderess.
-            //
-            // Also, if it's an address, it must be the address of a pointer
-            // if we are to dereference it.
-            // FIXME: This means that we can't do something like the following:
-            //
-            //   int i;
-            //   *&i = 23;
-            //
-            // which should work, but breaks test t052 if we don't require 
-            // the address of a pointer. See test exclude test x066 which
-            // demonstrates the problem. See also Issue #42.
-            //
-            if ((type != "pointer" && type != "address" && type != "array") ||
-                (type == "address" && specAndDecl[0].getType() != "pointer"))
+            // Obtain the address to which it points
+            try
             {
-              // If it's not an address type...
-              if (type != "address")
-              {
-                // ... then get the full specifier/declarator list back
-                specAndDecl.unshift(specOrDecl);
-              }
-
-              // Get a description of the type they're trying to dereference
-              typeDescription = 
-                playground.c.lib.SymtabEntry.getInfo(specAndDecl).description;
-
-              failure(
-                new playground.c.lib.RuntimeError(
-                  this,
-                  "You have attempted to dereference a value whose " +
-                    "type does not indicate that it is an address. " +
-                    "Its type is '" + typeDescription + "'"));
-              return;
+              value3 = this.__dereference(v);
             }
-            
-            // We don't currently support pointers to functions
-            if (type == "pointer" && specAndDecl[0].getType() == "function")
+            catch(e)
             {
-              this._throwIt(new playground.c.lib.RuntimeError(
-                              this,
-                              "Dereferencing pointers to function is " +
-                              "currently not supported."),
-                            success,
-                            failure);
+              failure(e);
               return;
             }
-            
-            // Prepend an "address" declarator
-            specAndDecl.unshift(
-              new playground.c.lib.Declarator(this, "address"));
-
-            // Prepare the return value. Get the value of the pointer.
-            value3 = 
-              {
-                specAndDecl : specAndDecl,
-                value       : addr
-              };
 
             // Complete the operation
             success(value3);
@@ -2995,372 +2819,64 @@ qx.Class.define("playground.c.lib.Node",
           break;
         }
         
-        // Get a quick reference to memory
-        mem = playground.c.lib.Node.__mem;
+        this.__callFunction(data, success, failure);
+        break;
 
-        // Save the stack pointer, so we can restore it after the function call
-        origSp = mem.getReg("SP", "unsigned int");
+      case "function_decl" :
+        /*
+         * function_decl
+         *   0 : direct_declarator
+         *   1 : parameter_type_list
+         *   2 : identifier_list // K&R only; not implemented; always null
+         */
+        // Only applicable before executing
+        if (bExecuting)
+        {
+          success();
+          break;
+        }
         
-        // Retrieve the symbol table entry for this function
+        // Process the direct declarator. It may add a declarator.
         this.children[0].process(
           data,
           bExecuting,
-          function(v)
+          function()
           {
-            var             type;
+            var             i;
+            var             bDefinition = false;
+            var             forwardDeclSymtab = null;
 
-            value1 = v;
-            
-            // Ensure that we got a symbol table entry.
-            if (! (value1 instanceof playground.c.lib.SymtabEntry))
+            // Find our enclosing function definition
+            for (subnode = this.parent; subnode; subnode = subnode.parent)
             {
-                  failure(
-                    new playground.c.lib.RuntimeError(
-                      this,
-                      "This appears to be attempting to call a function, " +
-                      "but the identifier  being called is not defined as " +
-                      "a function."));
-                  return;
+              if (subnode.type == "function_definition")
+              {
+                bDefinition = true;
+                break;
+              }
             }
 
-            // Get the address of that entry, which is the node for the called
-            // function, or the reference of a built-in function.
-            value2 = value1.getAddr(); // THIS RETURNS A NODE
-
-            // Save any old argument array and built-in indicator
-            oldArgs = data.args;
-            oldArgTypes = data.argTypes;
-            oldIsBuiltin = data.isBuiltin;
-
-            // Get the type of this (supposed) function
-            type = value1.getSpecAndDecl()[0].getType();
-
-            // Prepare to save function arguments, for type checking and use
-            // by builtins.
-            data.args = [];
-            data.argTypes = [];
-
-            // Prepare to save arguments in a JS array as well as on the
-            // stack, in case this is a built-in function being called.
-            if (type == "builtIn")
-            {
-              data.isBuiltin = true;
-            }
-            else if (type != "function")
-            {
-              failure(
-                new playground.c.lib.RuntimeError(
-                  this,
-                  "Attempting to call function '" +
-                  value1.getName() +
-                  "' but '" +
-                  value1.getName() +
-                  "' is not declared as a function."));
-              return;
-            }
-            else
+            // If we found subnode, this is a function definition. Otherwise,
+            // it's a forward declaration.
+            if (subnode)
             {
-              // In case this is a non-builtIn embedded in a builtIn, remove
-              // any arguments from the data objects.
-              delete data.isBuiltin;
+              // We've now found a function definition. Retrieve or create the
+              // symbol table for this function's parameters. If there had been
+              // a forward declaration, we'll find the symbol table already
+              // existing. Otherwise, we'll create it new.
+              symtab = playground.c.lib.Symtab.getByName(
+                data.entry.getName(),
+                playground.c.lib.Symtab.getCurrent());
 
-              // Ensure that this function has been defined, not just declared
-              if (! value2 || value1.getLine() > this.line)
+              if (! symtab)
               {
-                // Nope, it hasn't.
-                failure(
-                  new playground.c.lib.RuntimeError(
-                    this,
-                    "Function '" + value1.getName() + 
-                    "' has not been defined."));
-                return;
+                // There was no forward declaration. Create a new symbol table.
+                symtab = new playground.c.lib.Symtab(
+                  playground.c.lib.Symtab.getCurrent(), 
+                  data.entry.getName(),
+                  this.line);
               }
-              
-              // Get the stack pointer's current value
-              sp = playground.c.lib.Node.__mem.getReg("SP", "unsigned int");
-
-              // This is a real function (not built-in). Begin the activation
-              // record
-              mem.beginActivationRecord(sp);
-
-              // Name this activation record
-              declarator = value2.children[1];
-              function_decl = declarator.children[0];
-              depth = ++playground.c.lib.Node._depth;
-              mem.nameActivationRecord("Stack: Activation Record " + 
-                                       depth + ": " + 
-                                       function_decl.children[0].value);
-            }
-            
-            // Push the arguments onto the stack
-            this.children[1].process(
-              data,
-              bExecuting,
-              function()
-              {
-                var             terminal;
-                var             error;
-                var             symbols;
-                var             functionName;
-                var             incompatible;
-
-                // Is this a built-in function, or a user-generated one?
-                if (value1.getSpecAndDecl()[0].getType() == "builtIn")
-                {
-                  // Prepend failure and then the success functions
-                  data.args.unshift(failure);
-                  data.args.unshift(
-                    function(ret)
-                    {
-                      // Save the return value
-                      value3 = ret;
-
-                      // Restore the old argument array and built-in
-                      // indicator, if they existed
-                      data.args = oldArgs;
-                      data.argTypes = oldArgTypes;
-                      data.isBuiltin = oldIsBuiltin;
-
-                      // Restore the stack pointer
-                      mem.setReg("SP", "unsigned int", origSp);
-                      success(value3);
-                    });
-                  
-                  // Call the function now
-                  value2.apply(null, data.args);
-                }
-                else
-                {
-                  // Confirm that argument types match the formal parameter
-                  // declarations. First, retrieve the function's symtab
-                  symtab = value2._symtab;
-                  
-                  // Get the function name, by stripping off the leading "path"
-                  functionName = symtab.getName().split("/");
-                  functionName = functionName[functionName.length - 1];
-                  
-                  // Get the list of symbols from this symtab
-                  symbols = symtab.getSymbols();
-                  
-                  // Ensure that the number of arguments matches the number of
-                  // declared parameters.
-                  if (symbols.length > data.argTypes.length)
-                  {
-                    error =
-                      "The function " + functionName + " expects " +
-                      symbols.length + 
-                      (symbols.length == 1 ? " argument" : " arguments") +
-                      ", but received only " +
-                      data.argTypes.length;
-                  }
-                  else if (symbols.length < data.argTypes.length)
-                  {
-                    error =
-                      "The function " + functionName + " expects only " +
-                      symbols.length + 
-                      (symbols.length == 1 ? " argument" : " arguments") +
-                      ", but received " +
-                      data.argTypes.length;
-                  }
-                  else
-                  {
-                    // Compare each argument's type agains each symbol's type
-                    incompatible = symbols.filter(
-                      function(entry, i)
-                      {
-                        var             incompatible = [];
-                        var             thisSpecAndDecl;
-                        var             otherSpecAndDecl;
-
-                        // Get this parameter's specifier/declarator list
-                        thisSpecAndDecl = entry.getSpecAndDecl();
-
-                        // Get the argument's specifier/declarator list
-                        otherSpecAndDecl = data.argTypes[i];
-
-                        // Specifier/declarator lists must be the same length
-                        if (thisSpecAndDecl.length != otherSpecAndDecl.length)
-                        {
-                          // Add an entry to show that they're incompatible
-                          incompatible.push(1); 
-                        }
-                        else
-                        {
-                          // Compare each specifier/declarator. If any are not
-                          // compatible, then the list is incompatible.
-                          incompatible =
-                            thisSpecAndDecl.filter(
-                              function(specOrDecl, i)
-                              {
-                                var             incompatible;
-                                incompatible = 
-                                  ! specOrDecl.isCompatible(
-                                    otherSpecAndDecl[i],
-                                    otherSpecAndDecl.length == 1);
-                                return incompatible;
-                              });
-                        }
-
-                        if (incompatible.length > 0)
-                        {
-                          error =
-                            "The type of argument " + (i + 1) + 
-                            " to function " + functionName +
-                            " is " +
-                            "incompatible with the declaration " +
-                            "of parameter " + entry.getName() + 
-                            "\n" +
-                            "  Argument type: " + 
-                            playground.c.lib.SymtabEntry.getInfo(
-                              otherSpecAndDecl).description +
-                            "\n" +
-                            "  Expected type for " +  entry.getName() + ": " + 
-                            playground.c.lib.SymtabEntry.getInfo(
-                            thisSpecAndDecl).description;
-                        }
-                      }.bind(this));
-                  }
-
-                  if (false)
-                  {
-                    // If not compatible, display a warning.
-                    // FIXME: this should be an error, not a warning. We'll
-                    // leave it as a warning until feeling sure that it doesn't
-                    // generate messages when it shouldn't.
-                    if (error)
-                    {
-                      error = "Line " + this.line + ": " + error + "\n";
-
-                      try
-                      {
-                        terminal = 
-                          qx.core.Init.getApplication().getUserData(
-                            "terminal");
-                        terminal.addOutput(error);
-                      }
-                      catch(e)
-                      {
-                        console.log(error);
-                      }
-                    }
-                  }
-                  else
-                  {
-                    if (error)
-                    {
-                      failure(new playground.c.lib.RuntimeError(this, error));
-                      return;
-                    }
-                  }
-
-                  // Push the return address (our current line number) onto
-                  // the stack
-                  sp = mem.stackPush("unsigned int", this.line);
-
-                  // Add "symbol info" to show that this was a return address
-                  intSize = playground.c.machine.Memory.typeSize["int"];
-                  mem.setSymbolInfo(
-                    sp,
-                    {
-                      getName         : function() 
-                      {
-                        return "return to line #"; 
-                      },
-                      getType         : function() { return "int"; },
-                      getUnsigned     : function() { return false; },
-                      getSize         : function() { return intSize; },
-                      getPointerCount : function() { return 0; },
-                      getArraySizes   : function() { return []; },
-                      getIsParameter  : function() { return false; }
-                    });
-
-                  // Process that function. Save its return value in value3
-                  value2.process(
-                    data,
-                    bExecuting,
-                    function(v)
-                    {
-                      value3 = v;
-                      
-                      // We're finished with this activation record.
-                      mem.endActivationRecord();
-
-                      // We've completed a level of function call. Reduce depth.
-                      playground.c.lib.Node._depth--;
-
-                      // Restore the old argument array and built-in
-                      // indicator, if they exist.
-                      data.args = oldArgs;
-                      data.argTypes = oldArgTypes;
-                      data.isBuiltin = oldIsBuiltin;
-
-                      // Restore the stack pointer
-                      mem.setReg("SP", "unsigned int", origSp);
-                      success(value3);
-                    }.bind(this),
-                    failure);
-                }
-              }.bind(this),
-              failure);
-          }.bind(this),
-          failure);
-        break;
-
-      case "function_decl" :
-        /*
-         * function_decl
-         *   0 : direct_declarator
-         *   1 : parameter_type_list
-         *   2 : identifier_list // K&R only; not implemented; always null
-         */
-        // Only applicable before executing
-        if (bExecuting)
-        {
-          success();
-          break;
-        }
-        
-        // Process the direct declarator. It may add a declarator.
-        this.children[0].process(
-          data,
-          bExecuting,
-          function()
-          {
-            var             i;
-            var             bDefinition = false;
-            var             forwardDeclSymtab = null;
-
-            // Find our enclosing function definition
-            for (subnode = this.parent; subnode; subnode = subnode.parent)
-            {
-              if (subnode.type == "function_definition")
-              {
-                bDefinition = true;
-                break;
-              }
-            }
-
-            // If we found subnode, this is a function definition. Otherwise,
-            // it's a forward declaration.
-            if (subnode)
-            {
-              // We've now found a function definition. Retrieve or create the
-              // symbol table for this function's parameters. If there had been
-              // a forward declaration, we'll find the symbol table already
-              // existing. Otherwise, we'll create it new.
-              symtab = playground.c.lib.Symtab.getByName(
-                data.entry.getName(),
-                playground.c.lib.Symtab.getCurrent());
-
-              if (! symtab)
-              {
-                // There was no forward declaration. Create a new symbol table.
-                symtab = new playground.c.lib.Symtab(
-                  playground.c.lib.Symtab.getCurrent(), 
-                  data.entry.getName(),
-                  this.line);
-              }
-              else
+              else
               {
                 // There was a forward declaration. Save its symbol table, so
                 // we can later compare its symbols to what we find in the
@@ -4367,12 +3883,12 @@ console.log("\n\n");
 
                 // Complete the operation, coercing to the appropriate type
                 specOrDecl = 
-                  new playground.c.lib.Specifier(this, "int", "unsigned");
+                  new playground.c.lib.Specifier(this, "int", null, "unsigned");
 
                 success(
                   { 
                     value       : value1.value << value2.value,
-                    specAndDecl : [ specAndDecl ]
+                    specAndDecl : [ specOrDecl ]
                   });
               }.bind(this),
               failure);
@@ -5149,7 +4665,7 @@ console.log("\n\n");
 
                 // Create a specifier for the value
                 specOrDecl = 
-                  new playground.c.lib.Specifier(this, "int", "unsigned");
+                  new playground.c.lib.Specifier(this, "int", null, "unsigned");
 
                 success(
                   { 
@@ -5315,47 +4831,8 @@ console.log("\n\n");
         break;
 
       case "string_literal" :
-        // Have we already allocated space for this string?
-        if (! this._mem)
-        {
-          // Nope. Allocate the space now
-          this._mem =
-            playground.c.lib.Symtab.allocGlobalSpace(this.value.length + 1,
-                                                     "string",
-                                                     this.line);
-          
-          // Write the string, as character codes, into the allocated memory
-          this.value.split("").forEach(
-            function(ch, i)
-            {
-              playground.c.lib.Node.__mem.set(this._mem + i, 
-                                              "char",
-                                              this.value.charCodeAt(i));
-            },
-            this);
-
-          // Null terminate the string
-          playground.c.lib.Node.__mem.set(this._mem + this.value.length, 
-                                          "char",
-                                          0);
-        }
-        
-        // Create an initially-empty specifier/declarator list
-        specAndDecl = [];
-
-        // Create a declarator to indicate that it's a pointer, and add it to
-        // the specifier/declarator list
-        specAndDecl.push(new playground.c.lib.Declarator(this, "pointer"));
-
-        // Create a specifier to indicate that it's a char *
-        specAndDecl.push(new playground.c.lib.Specifier(this, "int", "char"));
-
         // Return the pointer to the string in global memory
-        success(
-          {
-            value       : this._mem, 
-            specAndDecl : specAndDecl
-          });
+        success(this.__stringLiteral());
         break;
 
       case "struct" :
@@ -5679,43 +5156,21 @@ console.log("\n\n");
           bExecuting,
           function(v)
           {
-            var             symtab;
+            var             base;
 
-            value1 = v;
-            
-            // If we got a symbol, retrieve its address. Otherwise, we already
-            // have an address.
-            if (value1 instanceof playground.c.lib.SymtabEntry)
+            // Find its address, and the symbol table of its members
+            try
             {
-              value1 =
-                {
-                  specAndDecl : v.getSpecAndDecl(),
-                  value       : v.getAddr()
-                };
+              base = this.__structureBase(v);
             }
-
-            // Get the symbol table of the struct/union members. It's in the
-            // specifier.
-            specAndDecl = value1.specAndDecl[value1.specAndDecl.length - 1];
-            symtab = specAndDecl.getStructSymtab();
-            
-            // If we didn't find a struct/union symbol table...
-            if (! symtab)
+            catch(e)
             {
-              // ... then this identifier is not a struct/union
-              failure(new playground.c.lib.RuntimeError(
-                        this,
-                        "The dot following '" + v.getName() + "' " +
-                        "indicates that you are trying to reference " +
-                        "a structure or union member,\n" +
-                        "but variable '" + v.getName() + "' " +
-                        "is not declared as a " +
-                        "structure or union."));
+              failure(e);
               return;
             }
 
             // Push the struct symbol table onto the symtab stack
-            playground.c.lib.Symtab.pushStack(symtab);
+            playground.c.lib.Symtab.pushStack(base.symtab);
 
             // Process the struct/union member
             this.children[1].process(
@@ -5727,43 +5182,18 @@ console.log("\n\n");
                 // it off of the symtab stack.
                 playground.c.lib.Symtab.popStack();
 
-                // We must have received a symtab entry.
-                if (! (v instanceof playground.c.lib.SymtabEntry))
+                // Find the address of the member
+                try
                 {
-                  failure(new playground.c.lib.RuntimeError(
-                            this,
-                            "A structure or union reference must have a " +
-                            "member name to the right of the dot."));
-                  return;
+                  value3 = this.__memberAddress(base, v);
                 }
-
-                // The entry must be in the struct/union symtab
-                if (v.getSymtab() != symtab)
+                catch(e)
                 {
-                  failure(new playground.c.lib.RuntimeError(
-                            this,
-                            "Unrecognized struct or union member: " +
-                            v.getName()));
+                  failure(e);
                   return;
                 }
 
-                // Get this member's offset from the beginning of the struct,
-                // and add it to the previously-determined address.
-                value1.value += v.getOffset();
-                value1.specAndDecl = v.getSpecAndDecl();
-                
-                // We're providing the address of this member. Indicate such.
-                // Prepend an "address" declarator if there isn't already one
-                // at the beginning of the specifier/declarator list
-                specOrDecl = value1.specAndDecl[0];
-                if (! (specOrDecl instanceof playground.c.lib.Declarator) ||
-                    specAndDecl.getType() != "address")
-                {
-                  value1.specAndDecl.unshift(
-                    new playground.c.lib.Declarator(this, "address"));
-                }
-
-                success(value1);
+                success(value3);
               }.bind(this),
               failure);
           }.bind(this),
@@ -6463,410 +5893,3016 @@ console.log("\n\n");
     },
 
     /**
-     * Helper funciton for assignments.
+     * Execute this node. If the node has been compiled and nothing requires
+     * the full interpreter, its compiled executor is called directly;
+     * otherwise this is equivalent to process() with bExecuting set.
      *
      * @param data {Map}
-     *   The data map currently in use for recursive calls to process()
+     *   Data used for sub-node processing, as required per node type
      *
-     * @param fOp {Function}
-     *   Function to produce the result for assignment. It takes two
-     *   arguments: the old (original) value of the lhs, and the new value.
-     * 
-     * @param bUseOld {Boolean}
-     *   true if the old value of the right-hand side is used;
-     *   false if it is not used
-     * 
      * @param success {Function}
      *   Function to call upon successful completion of this call
-     * 
+     *
      * @param failure {Function}
      *   Function to call upon failed completion of this call
+     */
+    execute : function(data, success, failure)
+    {
+      if (this._exec && playground.c.lib.Node._canRunCompiled(this))
+      {
+        --playground.c.lib.Node._unwindCount;
+        playground.c.lib.Node._currentNode = this;
+        this._exec(data, success, failure);
+        return;
+      }
+
+      this.process(data, true, success, failure);
+    },
+
+    /**
+     * Execute all sub-nodes of a node, in order. This is the compiled
+     * counterpart of __processSubnodes().
+     */
+    __executeSubnodes : function(data, success, failure)
+    {
+      var             i = 0;
+      var             children = this.children;
+      var             next;
+
+      if (children.length === 0)
+      {
+        success();
+        return;
+      }
+
+      next = function(ret)
+      {
+        if (++i < children.length)
+        {
+          children[i].execute(data, next, failure);
+        }
+        else
+        {
+          success(ret);
+        }
+      };
+
+      children[0].execute(data, next, failure);
+    },
+
+    /**
+     * Compile this node, and recursively all of its children, into executor
+     * closures. This is done once, after the symbol tables have been built,
+     * so that the frequently-executed node types need not be re-dispatched
+     * through the large switch in process() on every visit.
      *
-     * @param bUnary {Boolean}
-     *   true if this is a unary operator (pre/post-increment/decrement)
-     *   false otherwise
-     *
-     * @param bPostOp {Boolean}
-     *   true if this is a post-increment or post-decrement operation;
-     *   false otherwise
+     * Expressions, including assignments and function calls, and the
+     * statements which execute them (compound statements, if, loops, and
+     * return) are given a compiled executor. Where one shares nontrivial
+     * logic with process(), both call the same helper (e.g.,
+     * __assignHelper(), __callFunction()). All other node types, such as
+     * declarations, and any node visited while the debugger requires it,
+     * continue to be handled by process(), which remains the reference
+     * implementation. Each compiled executor must therefore produce exactly
+     * the same results as process() does.
      *
-     * @return {Map}
-     *   Upon success, a map containing the resulting value and its type is
-     *   returned. Upon failure (lhs is not an lvalue), null is returned.
+     * Compilation also determines whether each subtree can suspend, i.e.,
+     * whether anything within it may need to wait. Only statements, and
+     * calls to user functions or to built-in functions which may block
+     * (e.g., for input), can suspend. A node of a compilable type all of
+     * whose children cannot suspend is given a synchronous evaluator,
+     * _eval(), which returns its value directly (and throws upon error), so
+     * that the entire subtree is executed as a single step without any
+     * continuation closures or unwinding. If there is a breakpoint at any
+     * line spanned by such a subtree, execute() leaves it to process(), so
+     * that the debugger stops there.
      */
-    __assignHelper : function(data, fOp, bUseOld, 
-                              success, failure, bUnary, bPostOp)
+    compile : function()
     {
-      var             i;
-      var             type;
       var             value;
-      var             value1;
-      var             value3;
-      var             addr;
-      var             str;
-      var             size;
-      var             initializerList;
       var             specOrDecl;
-      var             specAndDecl;
-      var             bFirst;
-
-      // Retrieve the lvalue
-      this.children[0].process(
-        data,
-        true,
-        function(v)
+      var             intSpec;
+      var             combine;
+      var             bCanSuspend = false;
+      var             mem = playground.c.lib.Node.__mem;
+      var             NumberType = playground.c.lib.Node.NumberType;
+
+      // Relational and equality operators, producing an int 0 or 1
+      var             relational =
         {
-          // If it was a symbol table entry...
-          if (! (v instanceof playground.c.lib.SymtabEntry) &&
-              v.specAndDecl[0].getType() != "address")
-          {
-            failure(
-              new playground.c.lib.RuntimeError(
-                this,
-                "The left hand side of an assignment must be " +
-                "a variable, pointer dereference, " +
-                "or array element reference"));
-            return;
-          }
+          "equal"         : function(a, b) { return a === b; },
+          "not-equal"     : function(a, b) { return a !== b; },
+          "less-than"     : function(a, b) { return a < b; },
+          "less-equal"    : function(a, b) { return a <= b; },
+          "greater-than"  : function(a, b) { return a > b; },
+          "greater-equal" : function(a, b) { return a >= b; }
+        };
 
-          // Retrieve the value
-          value1 = this.getExpressionValue(v, data, true);
+      // Multiplicative operators, producing a value of the coerced type
+      var             multiplicative =
+        {
+          "multiply" : [ "multiply (*)", function(a, b) { return a * b; } ],
+          "divide"   : [ "divide (/)",   function(a, b) { return a / b; } ],
+          "mod"      : [ "mod (%)",      function(a, b) { return a % b; } ]
+        };
 
-          // Get a shallow copy of the specifier/declarator list
-          specAndDecl = value1.specAndDecl.slice(0);
+      // Additive operators, which also implement pointer arithmetic. The
+      // second element is the sign applied to the right operand.
+      var             additive =
+        {
+          "add"      : [ "add (+)",         1 ],
+          "subtract" : [ "subtraction (-)", -1 ]
+        };
 
-          // Only loop a maximum of one time
-          bFirst = true;
+      // Bit-wise operators, requiring integer operands
+      var             bitwise =
+        {
+          "bit-and"      : [ "bit-wise AND (&)",
+                             function(a, b) { return a & b; } ],
+          "bit-or"       : [ "bit-wise OR (|)",
+                             function(a, b) { return a | b; } ],
+          "exclusive-or" : [ "exclusive-or (^)",
+                             function(a, b) { return a ^ b; } ]
+        };
 
-          do
-          {
-            // Get the first specifier/declarator
-            specOrDecl = specAndDecl[0];
+      // Shift operators, producing an unsigned int
+      var             shift =
+        {
+          "left-shift"  : function(a, b) { return a << b; },
+          "right-shift" : function(a, b) { return a >> b; }
+        };
 
-            // Determine the memory type to use for saving the value
-            switch(specOrDecl.getType())
-            {
-            case "pointer" :
-            case "function" :
-              type = "pointer";
-              break;
+      // Unary arithmetic operators, producing a value of the operand's type
+      var             unary =
+        {
+          "negative"   : function(a) { return - a; },
+          "bit_invert" : function(a) { return ~ a; }
+        };
 
-            case "array" :      // should only happen in initializers
-              // Find out the type based on the next specifier/declarator
-              specAndDecl.shift();
-              continue;
+      // Assignment operators. The first element produces the value to be
+      // assigned, from the old and new values; the second indicates whether
+      // the old value is used.
+      var             assignment =
+        {
+          "assign"             : [ function(a, b) { return b; },      false ],
+          "add-assign"         : [ function(a, b) { return a + b; },  true ],
+          "subtract-assign"    : [ function(a, b) { return a - b; },  true ],
+          "multiply-assign"    : [ function(a, b) { return a * b; },  true ],
+          "divide-assign"      : [ function(a, b) { return a / b; },  true ],
+          "mod-assign"         : [ function(a, b) { return a % b; },  true ],
+          "left-shift-assign"  : [ function(a, b) { return a << b; }, true ],
+          "right-shift-assign" : [ function(a, b) { return a >> b; }, true ],
+          "bit-and-assign"     : [ function(a, b) { return a & b; },  true ],
+          "bit-or-assign"      : [ function(a, b) { return a | b; },  true ],
+          "xor-assign"         : [ function(a, b) { return a ^ b; },  true ]
+        };
 
-            case "address" :
-              // Find out the type based on the next specifier/declarator
-              if (bFirst)
-              {
-                bFirst = false;
-                specAndDecl.shift();
-                continue;
-              }
+      // Increment and decrement operators. The first element produces the
+      // new value, from the old value and the size of the increment; the
+      // second indicates whether the old value is the result.
+      var             incDec =
+        {
+          "pre_increment_op"  : [ function(a, b) { return a + b; }, false ],
+          "pre_decrement_op"  : [ function(a, b) { return a - b; }, false ],
+          "post_increment_op" : [ function(a, b) { return a + b; }, true ],
+          "post_decrement_op" : [ function(a, b) { return a - b; }, true ]
+        };
 
-              // There were two "address" declarators in a row. It's a pointer.
-              type = "pointer";
-              break;
+      // Compile the children first, noting the last line spanned by this
+      // subtree and whether any child can suspend.
+      this._lastLine = this.line;
+      this.children.forEach(
+        function(subnode)
+        {
+          if (subnode)
+          {
+            subnode.compile();
 
-            case "builtIn" :
-              failure(
-                new playground.c.lib.RuntimeError(
-                  this,
-                  "You are attempting to assign to an existing " +
-                  "function name, i.e., the left hand side of an assignment " +
-                  "can not be the name of a function."));
-              return;
+            if (subnode._lastLine > this._lastLine)
+            {
+              this._lastLine = subnode._lastLine;
+            }
 
-            default :
-              if (specOrDecl instanceof playground.c.lib.Specifier)
-              {
-                type = specOrDecl.getCType();
-              }
-              else
-              {
-                throw new Error("Internal error: unexpected type: " + 
-                                specOrDecl.getType());
-              }
-              break;
+            if (! subnode._eval)
+            {
+              bCanSuspend = true;
             }
+          }
+        },
+        this);
 
-            // Normal exit from the loop
-            break;
-          } while (true);
+      // Generate a compiled executor for those types that we handle
+      switch(this.type)
+      {
+      case "_null_" :
+        this._eval = function(data)
+        {
+          return undefined;
+        };
+        break;
 
-          // Get a copy of the original specifier/declarator list again
-          specAndDecl = value1.specAndDecl.slice(0);
+      case "constant" :
+        // Convert the value to a valid C value, once, as process() does on
+        // each visit, and create its specifier.
+        mem.setReg("R1", this.numberType, this.value);
+        value = mem.getReg("R1", this.numberType);
+        this.value = value;
 
-          // Retrieve the current value
-          if (type != "struct" && type != "union" && type != "enum")
-          {
-            value =
-              playground.c.lib.Node.__mem.get(value1.value, type, bUseOld);
-          }
+        specOrDecl = new playground.c.lib.Specifier(this);
+        switch(this.numberType)
+        {
+        case NumberType.Int :
+          specOrDecl.setType("int");
+          break;
 
-          // Determine the value to assign there. If it's a unary operator
-          // (pre/post increment/decrement), then use the retrieved
-          // value. Otherwise, get the value from the rhs of the expression.
-          if (bUnary)
-          {
-            // Assume amount to increment by is 1
-            size = 1;
+        case NumberType.Uint :
+          specOrDecl.setType("int");
+          specOrDecl.setSigned("unsigned");
+          break;
+
+        case NumberType.Long :
+          specOrDecl.setType("int");
+          specOrDecl.setSize("long");
+          break;
+
+        case NumberType.ULong :
+          specOrDecl.setType("int");
+          specOrDecl.setSigned("unsigned");
+          specOrDecl.setSize("long");
+          break;
+
+        case NumberType.Float :
+          specOrDecl.setType("float");
+          break;
 
-            // If the value being assigned to is a pointer...
-            if (value1.specAndDecl[0].getType() == "pointer")
+        default :
+          // Leave it to process() to report the error
+          return;
+        }
+
+        this._eval = function(data)
+        {
+          return (
             {
-              // ... then figure out the size of what's pointed to
-              specAndDecl = value1.specAndDecl.slice(1);
-              size = specAndDecl[0].calculateByteCount(1, specAndDecl, 0);
-            }
+              value       : value,
+              specAndDecl : [ specOrDecl ]
+            });
+        };
+        break;
 
-            value3 = 
-              { 
-                value       : size,
-                specAndDecl : [ new playground.c.lib.Specifier(this, "int") ]
-              };
-            
-            saveAndReturn.bind(this)(success);
-            return;
+      case "identifier" :
+        this._eval = function(data)
+        {
+          var             symtab;
+          var             entry;
+
+          // Obtain the symbol table entry for this identifier
+          symtab = playground.c.lib.Symtab.getCurrent();
+          entry = symtab && symtab.get(this.value, false);
+          if (! entry)
+          {
+            throw new playground.c.lib.RuntimeError(
+              this,
+              "Undeclared variable: " + this.value);
           }
-          
-          // Not unary. See if we're handling an initializer list
-          if (this.children[1].type == "initializer_list")
+          return entry;
+        };
+        break;
+
+      case "primary_expression" :
+        if (! bCanSuspend)
+        {
+          this._eval = function(data)
           {
-            // Get a reference to the initializer list, for quick access
-            initializerList = this.children[1].children;
+            return this.children[0]._eval(data);
+          };
+          break;
+        }
 
-            if (initializerList.length > 0)
-            {
-              i = 0;
-              initializerList[i].process(
-                data,
-                true,
-                function(v)
-                {
-                  var             fSelf = arguments.callee;
+        this._exec = function(data, success, failure)
+        {
+          this.children[0].execute(data, success, failure);
+        };
+        break;
 
-                  initializeValue.call(
-                    this,
-                    function()
-                    {
-                      if (++i < initializerList.length)
-                      {
-                        initializerList[i].process(
-                          data,
-                          true,
-                          fSelf.bind(this),
-                          failure);
-                      }
-                      else
-                      {
-                        success();
-                      }
-                    }.bind(this),
-                    v);
-                }.bind(this),
-                failure);
-            }
-            else
-            {
-              success();
-            }
-            
-            return;
-          }
+      case "expression" :
+        if (! bCanSuspend)
+        {
+          this._eval = function(data)
+          {
+            var             i;
+            var             ret;
 
-          // See if we're initializing a char array from a character string
-          if (v instanceof playground.c.lib.SymtabEntry &&
-              v.getSpecAndDecl().length == 2 &&
-              v.getSpecAndDecl() &&
-              (specOrDecl = v.getSpecAndDecl()[0]) &&
-              specOrDecl.getType() == "array" &&
-              (specOrDecl = v.getSpecAndDecl()[1]) &&
-              specOrDecl.getType() == "int" &&
-              specOrDecl.getSize() == "char" &&
-              this.children[1].children.length == 1 &&
-              this.children[1].children[0].type == "string_literal")
-          {
-            // We are. Copy the string in to the array address.
-            // Get a reference to the string, for faster reference
-            str = this.children[1].children[0].value;
-
-            // If we're initializing an array and the initializer is too long...
-            specOrDecl = v.getSpecAndDecl()[0];
-            if (specOrDecl.getType() == "array" &&
-                str.length > specOrDecl.getArrayCount())
+            for (i = 0; i < this.children.length; i++)
             {
-              // ... then generate a run-time error
-              failure(
-                new playground.c.lib.RuntimeError(
-                  this,
-                  "Array size is " + specOrDecl.getArrayCount() + ", " +
-                  "initializer length (including null terminator) is " + 
-                  (str.length + 1) +
-                  ". Initializers do not fit in array."));
-              return;
+              ret = this.children[i]._eval(data);
             }
-            
-            // Copy the string to memory
-            addr = v.getAddr();
-            str.split("").forEach(
-              function(c, i)
-              {
-                playground.c.lib.Node.__mem.set(addr + i, 
-                                                "char", 
-                                                c.charCodeAt(0));
-              });
 
-            // Null terminate the string
-            playground.c.lib.Node.__mem.set(addr + str.length, "char", 0);
-            success();
-            return;
-          }
+            return ret;
+          };
+          break;
+        }
 
-          // No initializers.
-          this.children[1].process(
-            data,
-            true,
-            initializeValue.bind(this, success),
-            failure);
-          return;
+        this._exec = this.__executeSubnodes;
+        break;
 
-          // ----------------------------------------------------------- //
-          // utility functions
-          // ----------------------------------------------------------- //
+      case "statement_list" :
+        this._exec = function(data, success, failure)
+        {
+          var             oldEntry = data.entry;
+          var             oldSpecifiers = data.specifiers;
+          var             oldSpecAndDecl = data.specAndDecl;
 
-          function initializeValue(succ, v)
-          {
-            var             specAndDecl;
+          // Ensure that symbols don't get defined in "identifier"
+          delete data.entry;
+          delete data.specifiers;
+          delete data.specAndDecl;
 
-            if (typeof v != "undefined")
+          this.__executeSubnodes(
+            data,
+            function()
             {
-              value3 = this.getExpressionValue(v, data);
+              // Restore overwritten data members
+              data.entry = oldEntry;
+              data.specifiers = oldSpecifiers;
+              data.specAndDecl = oldSpecAndDecl;
 
-              // If the value being assigned to is a pointer and the
-              // RHS's type is some sort of int...
-              if (value1.specAndDecl[0].getType() == "pointer")
-              {
-                // ... then figure out the size of what's pointed to
-                specAndDecl = value1.specAndDecl.slice(1);
-                size = specAndDecl[0].calculateByteCount(1, specAndDecl, 0);
-              }
-              else if (value1.specAndDecl[0].getType() == "array")
+              success();
+            },
+            failure);
+        };
+        break;
+
+      case "if" :
+        this._exec = function(data, success, failure)
+        {
+          this.children[0].execute(
+            data,
+            function(v)
+            {
+              // Process the 'if' or 'else' statement, as appropriate
+              if (this.getExpressionValue(v, data).value)
               {
-                size = playground.c.machine.Memory.typeSize[type];
+                this.children[1].execute(data, success, failure);
               }
               else
               {
-                // otherwise, get the size of the thing itself.
-                specAndDecl = value1.specAndDecl.slice(0);
-                size = specAndDecl[0].calculateByteCount(1, specAndDecl, 0);
+                this.children[2].execute(data, success, failure);
               }
+            }.bind(this),
+            failure);
+        };
+        break;
 
-              saveAndReturn.bind(this)(succ);
-            }
-            else
+      case "equal" :
+      case "not-equal" :
+      case "less-than" :
+      case "less-equal" :
+      case "greater-than" :
+      case "greater-equal" :
+        // The result is always an int. Values' specifiers are never
+        // modified, so one specifier can be shared by all results.
+        intSpec = new playground.c.lib.Specifier(this, "int");
+        value = relational[this.type];
+
+        combine = function(value1, value2)
+        {
+          return (
             {
-              succ();
-            }
+              value       : value(value1.value, value2.value) ? 1 : 0,
+              specAndDecl : [ intSpec ]
+            });
+        };
+
+        this.__compileBinary(combine, bCanSuspend);
+        break;
+
+      case "multiply" :
+      case "divide" :
+      case "mod" :
+        value = multiplicative[this.type];
+
+        combine = function(value1, value2)
+        {
+          var             specAndDecl;
+          var             result;
+
+          // Complete the operation, coercing to the appropriate type
+          specAndDecl = this.__coerce(value1.specAndDecl,
+                                      value2.specAndDecl,
+                                      value[0]);
+          result = value[1](value1.value, value2.value);
+
+          if (specAndDecl[0].getType() == "int")
+          {
+            result = Math.floor(result);
+          }
+          else if (this.type == "mod")
+          {
+            // Can't do this op on anything but an int
+            throw new playground.c.lib.RuntimeError(
+              this,
+              "Operation requires two integer values.");
           }
-          function saveAndReturn(succ)
-          {
-            // Ensure they're not writing to a constant
-            if (! data.bIsInitializer && 
-                [
-                  "constant",
-                  "enum_value"
-                ].indexOf(value1.specAndDecl[0].getConstant()) != -1)
+
+          return (
             {
-              // They are! Bad programmer! Bad!
-              if (value1.specAndDecl[0] instanceof playground.c.lib.Specifier)
-              {
-                if (value1.specAndDecl[0].getConstant() == "constant")
-                {
-                  failure(new playground.c.lib.RuntimeError(
-                            this,
-                            "Can not alter a const variable."));
-                }
-                else
-                {
-                  failure(new playground.c.lib.RuntimeError(
-                            this,
-                            "Can not alter an enum value."));
-                }
-              }
-              else
+              value       : result,
+              specAndDecl : specAndDecl
+            });
+        };
+
+        this.__compileBinary(combine, bCanSuspend);
+        break;
+
+      case "add" :
+      case "subtract" :
+        value = additive[this.type];
+
+        combine = function(value1, value2)
+        {
+          var             byteCount;
+          var             specAndDecl;
+          var             pointer;
+          var             offset;
+          var             f;
+
+          // If one value is a pointer (or array) and the other is an int,
+          // this is pointer arithmetic. Offset the address by the size of
+          // the pointed-to item.
+          if ((value1.specAndDecl[0].getType() == "pointer" ||
+               value1.specAndDecl[0].getType() == "array") &&
+              value2.specAndDecl[0].getType() == "int")
+          {
+            pointer = value1;
+            offset = value2;
+          }
+          else if ((value2.specAndDecl[0].getType() == "pointer" ||
+                    value2.specAndDecl[0].getType() == "array") &&
+                   value1.specAndDecl[0].getType() == "int")
+          {
+            pointer = value2;
+            offset = value1;
+          }
+
+          if (pointer)
+          {
+            specAndDecl = pointer.specAndDecl.slice(1);
+            byteCount = specAndDecl[0].calculateByteCount(1, specAndDecl, 0);
+
+            return (
               {
-                // They're trying to modify a constant pointer
-                failure(new playground.c.lib.RuntimeError(
-                          this,
-                          "Can not alter an array address " +
-                            "or constant pointer"));
-              }
+                value       : (pointer.value +
+                               value[1] * offset.value * byteCount),
+                specAndDecl : pointer.specAndDecl.slice(0)
+              });
+          }
 
-              return;
-            }
+          // It's not pointer arithmetic. Complete the operation, coercing
+          // to the appropriate type
+          specAndDecl = this.__coerce(value1.specAndDecl,
+                                      value2.specAndDecl,
+                                      value[0]);
+          f = specAndDecl[0].getType() == "int"
+                ? Math.floor
+                : function (n) { return n; };
 
-            // If this is a write to a structure or union...
-            if (type == "struct" || type == "union")
+          return (
             {
-              // then we want to just return its address. First, clone the
-              // specifier/declarator list.
-              specAndDecl = specAndDecl.slice(0);
-              
-              // Prepend an "address" declarator"
-              specAndDecl.unshift(
-                new playground.c.lib.Declarator(this, "address"));
+              value       : f(value1.value + value[1] * value2.value),
+              specAndDecl : specAndDecl
+            });
+        };
 
-              // Return the address of the struct
-              succ(
-                {
-                  value       : value1.value,
-                  specAndDecl : specAndDecl
-                });
-              
-              return;
-            }
+        this.__compileBinary(combine, bCanSuspend);
+        break;
+
+      case "bit-and" :
+      case "bit-or" :
+      case "exclusive-or" :
+        value = bitwise[this.type];
+
+        combine = function(value1, value2)
+        {
+          var             specAndDecl;
+
+          // Complete the operation, coercing to the appropriate type
+          specAndDecl = this.__coerce(value1.specAndDecl,
+                                      value2.specAndDecl,
+                                      value[0]);
 
-            // Save the value at its new address
-            playground.c.lib.Node.__mem.set(
-              value1.value,
-              type,
-              fOp(value, value3.value));
+          // Ensure we ended up with an int. Can't do this op otherwise.
+          if (specAndDecl[0].getType() != "int")
+          {
+            throw new playground.c.lib.RuntimeError(
+              this,
+              "Operation requires two integer values.");
+          }
 
-            // If this is not a post-increment or post-decrement...
-            if (! bPostOp)
+          return (
             {
-              // ... then retrieve and return the altered value
-              value =
-                playground.c.lib.Node.__mem.get(value1.value, type, bUseOld);
-            }
+              value       : value[1](value1.value, value2.value),
+              specAndDecl : specAndDecl
+            });
+        };
 
-            // Clone the specifier/declarator list
-            specAndDecl = specAndDecl.slice(0);
-            
-            // If this is a unary operator on a pointer...
-            if (bUnary && value1.specAndDecl[0].getType() == "pointer")
+        this.__compileBinary(combine, bCanSuspend);
+        break;
+
+      case "left-shift" :
+      case "right-shift" :
+        intSpec = new playground.c.lib.Specifier(this, "int", null, "unsigned");
+        value = shift[this.type];
+
+        combine = function(value1, value2)
+        {
+          return (
             {
-              // ... then prepend an "pointer" declarator
-              specAndDecl.unshift(
-                new playground.c.lib.Declarator(this, "pointer"));
-            }
+              value       : value(value1.value, value2.value),
+              specAndDecl : [ intSpec ]
+            });
+        };
+
+        this.__compileBinary(combine, bCanSuspend);
+        break;
 
-            // Increment the address by the size of this element, in case
-            // we're in an initializer list.
-            value1.value += size;
+      case "negative" :
+      case "bit_invert" :
+        value = unary[this.type];
 
-            // Retrieve the value and return it
-            succ(
+        this.__compileUnary(
+          function(value1)
+          {
+            return (
               {
-                value       : value,
-                specAndDecl : specAndDecl.slice(0)
+                value       : value(value1.value),
+                specAndDecl : value1.specAndDecl
               });
-          }
+          },
+          bCanSuspend);
+        break;
 
-        }.bind(this),
-        failure);
+      case "positive" :
+        this.__compileUnary(
+          function(value1)
+          {
+            return value1;
+          },
+          bCanSuspend);
+        break;
+
+      case "not" :
+        intSpec = new playground.c.lib.Specifier(this, "int");
+
+        this.__compileUnary(
+          function(value1)
+          {
+            return (
+              {
+                value       : (! value1.value) ? 1 : 0,
+                specAndDecl : [ intSpec ]
+              });
+          },
+          bCanSuspend);
+        break;
+
+      case "and" :
+      case "or" :
+        // The right operand is evaluated only if the left operand doesn't
+        // determine the result: if it's true for "and", or false for "or".
+        intSpec = new playground.c.lib.Specifier(this, "int");
+        value = (this.type == "and");
+
+        if (! bCanSuspend)
+        {
+          this._eval = function(data)
+          {
+            var             value1;
+            var             value2;
+
+            value1 =
+              this.getExpressionValue(this.children[0]._eval(data), data);
+            if ((!! value1.value) != value)
+            {
+              return { value : value ? 0 : 1, specAndDecl : [ intSpec ] };
+            }
+
+            value2 =
+              this.getExpressionValue(this.children[1]._eval(data), data);
+            return (
+              {
+                value       : value2.value ? 1 : 0,
+                specAndDecl : [ intSpec ]
+              });
+          };
+          break;
+        }
+
+        this._exec = function(data, success, failure)
+        {
+          this.children[0].execute(
+            data,
+            function(v)
+            {
+              var             value1 = this.getExpressionValue(v, data);
+
+              if ((!! value1.value) != value)
+              {
+                success({ value : value ? 0 : 1, specAndDecl : [ intSpec ] });
+                return;
+              }
+
+              this.children[1].execute(
+                data,
+                function(v)
+                {
+                  var             value2 = this.getExpressionValue(v, data);
+
+                  success(
+                    {
+                      value       : value2.value ? 1 : 0,
+                      specAndDecl : [ intSpec ]
+                    });
+                }.bind(this),
+                failure);
+            }.bind(this),
+            failure);
+        };
+        break;
+
+      case "trinary" :
+        if (! bCanSuspend)
+        {
+          this._eval = function(data)
+          {
+            var             value1;
+
+            value1 =
+              this.getExpressionValue(this.children[0]._eval(data), data);
+            return this.children[value1.value ? 1 : 2]._eval(data);
+          };
+          break;
+        }
+
+        this._exec = function(data, success, failure)
+        {
+          this.children[0].execute(
+            data,
+            function(v)
+            {
+              // Evaluate the second or third operand, as appropriate
+              if (this.getExpressionValue(v, data).value)
+              {
+                this.children[1].execute(data, success, failure);
+              }
+              else
+              {
+                this.children[2].execute(data, success, failure);
+              }
+            }.bind(this),
+            failure);
+        };
+        break;
+
+      case "assign" :
+      case "add-assign" :
+      case "subtract-assign" :
+      case "multiply-assign" :
+      case "divide-assign" :
+      case "mod-assign" :
+      case "left-shift-assign" :
+      case "right-shift-assign" :
+      case "bit-and-assign" :
+      case "bit-or-assign" :
+      case "xor-assign" :
+        // Leave it to process() to report an address-of operator on the left
+        // hand side of an assignment
+        if (this.type == "assign" && this.children[0].type == "address_of")
+        {
+          break;
+        }
+
+        value = assignment[this.type];
+
+        if (! bCanSuspend)
+        {
+          this._eval = function(data)
+          {
+            var             v = this.children[0]._eval(data);
+            var             target = this.__assignTarget(v, data, value[1]);
+
+            // A char array assigned a character string gets a copy of it
+            if (this.__assignString(v))
+            {
+              return undefined;
+            }
+
+            return this.__assignValue(
+              target, data, value[0], this.children[1]._eval(data));
+          };
+          break;
+        }
+
+        this._exec = function(data, success, failure)
+        {
+          this.__assignHelper(data, value[0], value[1], success, failure);
+        };
+        break;
+
+      case "pre_increment_op" :
+      case "pre_decrement_op" :
+      case "post_increment_op" :
+      case "post_decrement_op" :
+        value = incDec[this.type];
+
+        if (! bCanSuspend)
+        {
+          this._eval = function(data)
+          {
+            var             v = this.children[0]._eval(data);
+            var             target = this.__assignTarget(v, data, true);
+
+            return this.__assignIncrement(target, data, value[0], value[1]);
+          };
+          break;
+        }
+
+        this._exec = function(data, success, failure)
+        {
+          this.__assignHelper(
+            data, value[0], true, success, failure, true, value[1]);
+        };
+        break;
+
+      case "address_of" :
+        this.__compileUnary(
+          function(value)
+          {
+            var             addr;
+            var             specAndDecl;
+
+            // If we found a symbol, retrieve its address and a copy of its
+            // specifier/declarator list. Otherwise, it must already be an
+            // address.
+            if (value instanceof playground.c.lib.SymtabEntry)
+            {
+              addr = value.getAddr();
+              specAndDecl = value.getSpecAndDecl();
+            }
+            else
+            {
+              addr = value.value;
+              specAndDecl = value.specAndDecl;
+            }
+
+            // Prepend two "address" declarators to preclude immediate
+            // dereferencing. (If the first declarator is already "address",
+            // then only prepend one instead of two.)
+            if (specAndDecl[0].getType() != "address")
+            {
+              specAndDecl.unshift(
+                new playground.c.lib.Declarator(this, "address"));
+            }
+            specAndDecl.unshift(
+              new playground.c.lib.Declarator(this, "address"));
+
+            return (
+              {
+                value       : addr,
+                specAndDecl : specAndDecl
+              });
+          },
+          bCanSuspend,
+          true);
+        break;
+
+      case "dereference" :
+        this.__compileUnary(this.__dereference, bCanSuspend, true);
+        break;
+
+      case "array_expression" :
+        if (! bCanSuspend)
+        {
+          this._eval = function(data)
+          {
+            var             base;
+
+            base = this.__elementBase(this.children[0]._eval(data));
+            return this.__elementAddress(
+              base,
+              this.getExpressionValue(this.children[1]._eval(data), data));
+          };
+          break;
+        }
+
+        this._exec = function(data, success, failure)
+        {
+          // Get the base address
+          this.children[0].execute(
+            data,
+            function(v)
+            {
+              var             base;
+
+              try
+              {
+                base = this.__elementBase(v);
+              }
+              catch(e)
+              {
+                failure(e);
+                return;
+              }
+
+              // Get the index, and calculate the address of the element
+              this.children[1].execute(
+                data,
+                function(v)
+                {
+                  var             result;
+                  var             value2 = this.getExpressionValue(v, data);
+
+                  try
+                  {
+                    result = this.__elementAddress(base, value2);
+                  }
+                  catch(e)
+                  {
+                    failure(e);
+                    return;
+                  }
+
+                  success(result);
+                }.bind(this),
+                failure);
+            }.bind(this),
+            failure);
+        };
+        break;
+
+      case "structure_reference" :
+        if (! bCanSuspend)
+        {
+          this._eval = function(data)
+          {
+            var             v;
+            var             base;
+
+            base = this.__structureBase(this.children[0]._eval(data));
+
+            // Look up the member in the structure's symbol table
+            playground.c.lib.Symtab.pushStack(base.symtab);
+            v = this.children[1]._eval(data);
+            playground.c.lib.Symtab.popStack();
+
+            return this.__memberAddress(base, v);
+          };
+          break;
+        }
+
+        this._exec = function(data, success, failure)
+        {
+          // Get the address of the structure or union
+          this.children[0].execute(
+            data,
+            function(v)
+            {
+              var             base;
+
+              try
+              {
+                base = this.__structureBase(v);
+              }
+              catch(e)
+              {
+                failure(e);
+                return;
+              }
+
+              // Look up the member in the structure's symbol table
+              playground.c.lib.Symtab.pushStack(base.symtab);
+              this.children[1].execute(
+                data,
+                function(v)
+                {
+                  var             result;
+
+                  playground.c.lib.Symtab.popStack();
+
+                  try
+                  {
+                    result = this.__memberAddress(base, v);
+                  }
+                  catch(e)
+                  {
+                    failure(e);
+                    return;
+                  }
+
+                  success(result);
+                }.bind(this),
+                failure);
+            }.bind(this),
+            failure);
+        };
+        break;
+
+      case "cast_expression" :
+        if (! bCanSuspend)
+        {
+          this._eval = function(data)
+          {
+            var             castData = this.children[0]._eval(data);
+            var             v = this.children[1]._eval(data);
+
+            return this.__cast(castData, this.getExpressionValue(v, data));
+          };
+          break;
+        }
+
+        this._exec = function(data, success, failure)
+        {
+          // Get the cast data from the type name, and then the value to be
+          // cast
+          this.children[0].execute(
+            data,
+            function(castData)
+            {
+              this.children[1].execute(
+                data,
+                function(v)
+                {
+                  var             value1 = this.getExpressionValue(v, data);
+
+                  success(this.__cast(castData, value1));
+                }.bind(this),
+                failure);
+            }.bind(this),
+            failure);
+        };
+        break;
+
+      case "type_name" :
+        // The type is determined by process(), which caches it. If it
+        // already has been, it can be used as is.
+        if (this.data)
+        {
+          this._eval = function(data)
+          {
+            return this.data;
+          };
+        }
+        break;
+
+      case "string_literal" :
+        this._eval = this.__stringLiteral;
+        break;
+
+      case "argument_expression_list" :
+        // The arguments are saved in reverse order, as process() does
+        if (! bCanSuspend)
+        {
+          this._eval = function(data)
+          {
+            var             i;
+
+            for (i = this.children.length - 1; i >= 0; i--)
+            {
+              this.__pushArgument(this.children[i]._eval(data), data);
+            }
+
+            return undefined;
+          };
+        }
+        break;
+
+      case "function_call" :
+        // A call to a built-in function which does not block completes
+        // before returning, so needn't suspend its caller
+        if (! bCanSuspend && this.__isNonBlockingBuiltIn())
+        {
+          this._eval = this.__callBuiltIn;
+          break;
+        }
+
+        this._exec = this.__callFunction;
+        break;
+
+      case "return" :
+        // A return without an expression returns 127
+        intSpec = new playground.c.lib.Specifier(
+          this, "int", "char", "unsigned");
+
+        this._exec = function(data, success, failure)
+        {
+          this.children[0].execute(
+            data,
+            function(v)
+            {
+              if (typeof v != "undefined")
+              {
+                v = this.getExpressionValue(v, data);
+              }
+              else
+              {
+                v = { value : 127, specAndDecl : [ intSpec ] };
+              }
+
+              // Return via throwing an error, to unwrap intervening call
+              // frames. This isn't really a failure.
+              failure(new playground.c.lib.Return(this, v));
+            }.bind(this),
+            failure);
+        };
+        break;
+
+      case "compound_statement" :
+        // The symbol table is retrieved from the node, where it's saved
+        // each time the symbol tables are built
+        if (! this._symtab)
+        {
+          break;
+        }
+
+        this._exec = function(data, success, failure)
+        {
+          var             next;
+          var             symtab = this._symtab;
+          var             oldInitializers = data.initializers;
+
+          // Push this symbol table onto the stack, as if we'd just created
+          // it, and save the new frame pointer
+          playground.c.lib.Symtab.pushStack(symtab);
+          symtab.setFramePointer(
+            mem.getReg("SP", "unsigned int") - symtab.getSize());
+
+          // Call each initializer enqueued by the declaration list, once the
+          // activation record is complete, and then execute the statements
+          next = function()
+          {
+            var             f = data.initializers.shift();
+
+            if (typeof f == "function")
+            {
+              f(next, failure);
+              return;
+            }
+
+            // Restore the old initializer list
+            data.initializers = oldInitializers;
+
+            this.children[1].execute(
+              data,
+              function()
+              {
+                // Revert to the prior scope
+                playground.c.lib.Symtab.popStack();
+                success();
+              },
+              failure);
+          }.bind(this);
+
+          // Process the declaration list first, enqueuing initializers
+          data.initializers = [];
+          this.children[0].execute(data, next, failure);
+        };
+        break;
+
+      case "for" :
+        this._exec = function(data, success, failure)
+        {
+          var             symtab;
+          var             symtab2;
+          var             fCondition;
+          var             fPostBody;
+          var             fBody;
+          var             fCatchContinue;
+
+          this._tryIt(
+            function(succ, fail)
+            {
+              // Save current symbol table so we know where to pop to upon
+              // break
+              symtab = playground.c.lib.Symtab.getCurrent();
+
+              // Evaluate the 'while' condition. If there is none, it's true.
+              fCondition = function()
+              {
+                this.children[1].execute(
+                  data,
+                  function(v)
+                  {
+                    if (typeof v != "undefined" &&
+                        ! this.getExpressionValue(v, data).value)
+                    {
+                      success();
+                      return;
+                    }
+
+                    // It's true. Process the statement block.
+                    this._tryIt(fBody, fCatchContinue, succ, fail);
+                  }.bind(this),
+                  fail);
+              }.bind(this);
+
+              // Process the statement block, saving the current symbol
+              // table so we know where to pop to upon continue
+              fBody = function(succ, fail)
+              {
+                symtab2 = playground.c.lib.Symtab.getCurrent();
+                this.children[2].execute(data, fPostBody, fail);
+              }.bind(this);
+
+              // Upon continue, restore the symbol table, and proceed as if
+              // the statement block had completed
+              fCatchContinue = function(error, succ, fail)
+              {
+                if (! (error instanceof playground.c.lib.Continue))
+                {
+                  this._throwIt(error, succ, fail);
+                  return;
+                }
+
+                while (playground.c.lib.Symtab.getCurrent() != symtab2)
+                {
+                  playground.c.lib.Symtab.popStack();
+                }
+                fPostBody();
+              }.bind(this);
+
+              // After each iteration, return to the 'while' condition
+              fPostBody = function()
+              {
+                this.children[3].execute(data, fCondition, fail);
+              }.bind(this);
+
+              // Begin with the initialization
+              this.children[0].execute(data, fCondition, fail);
+            }.bind(this),
+            function(error, succ, fail)
+            {
+              this.__catchBreak(error, symtab, succ, fail);
+            }.bind(this),
+            success,
+            failure);
+        };
+        break;
+
+      case "do-while" :
+        this._exec = function(data, success, failure)
+        {
+          var             symtab;
+          var             symtab2;
+          var             fIterate;
+          var             fCondition;
+          var             fBody;
+          var             fCatchContinue;
+
+          this._tryIt(
+            function(succ, fail)
+            {
+              // Save current symbol table so we know where to pop to upon
+              // break
+              symtab = playground.c.lib.Symtab.getCurrent();
+
+              // Process the statement block, and then the condition
+              fIterate = function()
+              {
+                this._tryIt(fBody, fCatchContinue, fCondition, fail);
+              }.bind(this);
+
+              // Process the statement block, saving the current symbol
+              // table so we know where to pop to upon continue
+              fBody = function(succ, fail)
+              {
+                symtab2 = playground.c.lib.Symtab.getCurrent();
+                this.children[0].execute(data, succ, fail);
+              }.bind(this);
+
+              // Upon continue, restore the symbol table, and proceed as if
+              // the statement block had completed
+              fCatchContinue = function(error, succ, fail)
+              {
+                if (! (error instanceof playground.c.lib.Continue))
+                {
+                  this._throwIt(error, succ, fail);
+                  return;
+                }
+
+                while (playground.c.lib.Symtab.getCurrent() != symtab2)
+                {
+                  playground.c.lib.Symtab.popStack();
+                }
+                succ();
+              }.bind(this);
+
+              // Iterate again while the condition is true
+              fCondition = function()
+              {
+                this.children[1].execute(
+                  data,
+                  function(v)
+                  {
+                    if (this.getExpressionValue(v, data).value)
+                    {
+                      fIterate();
+                    }
+                    else
+                    {
+                      succ();
+                    }
+                  }.bind(this),
+                  fail);
+              }.bind(this);
+
+              fIterate();
+            }.bind(this),
+            function(error, succ, fail)
+            {
+              this.__catchBreak(error, symtab, succ, fail);
+            }.bind(this),
+            success,
+            failure);
+        };
+        break;
+
+      default :
+        // All other node types are handled by process()
+        break;
+      }
+
+      // If we generated a synchronous evaluator, the compiled executor
+      // simply calls it, so that the whole subtree is executed in one step.
+      if (this._eval)
+      {
+        this._exec = function(data, success, failure)
+        {
+          var             v;
+
+          try
+          {
+            v = this._eval(data);
+          }
+          catch(e)
+          {
+            failure(e);
+            return;
+          }
+
+          success(v);
+        };
+      }
+    },
+
+    /**
+     * Generate the compiled executor for a binary operator node. If neither
+     * operand can suspend, a synchronous evaluator is generated instead.
+     *
+     * @param combine {Function}
+     *   Function, called in the context of this node, which is passed the
+     *   values of the two operands and returns the result value, or throws
+     *   an error.
+     *
+     * @param bCanSuspend {Boolean}
+     *   Whether either operand can suspend
+     */
+    __compileBinary : function(combine, bCanSuspend)
+    {
+      if (! bCanSuspend)
+      {
+        this._eval = function(data)
+        {
+          var             value1;
+          var             value2;
+
+          value1 = this.getExpressionValue(this.children[0]._eval(data), data);
+          value2 = this.getExpressionValue(this.children[1]._eval(data), data);
+          return combine.call(this, value1, value2);
+        };
+        return;
+      }
+
+      this._exec = function(data, success, failure)
+      {
+        this.children[0].execute(
+          data,
+          function(v)
+          {
+            var             value1 = this.getExpressionValue(v, data);
+
+            this.children[1].execute(
+              data,
+              function(v)
+              {
+                var             result;
+                var             value2 = this.getExpressionValue(v, data);
+
+                try
+                {
+                  result = combine.call(this, value1, value2);
+                }
+                catch(e)
+                {
+                  failure(e);
+                  return;
+                }
+
+                success(result);
+              }.bind(this),
+              failure);
+          }.bind(this),
+          failure);
+      };
+    },
+
+    /**
+     * Generate the compiled executor for a unary operator node. If the
+     * operand can't suspend, a synchronous evaluator is generated instead.
+     *
+     * @param combine {Function}
+     *   Function, called in the context of this node, which is passed the
+     *   value of the operand and returns the result value, or throws an
+     *   error.
+     *
+     * @param bCanSuspend {Boolean}
+     *   Whether the operand can suspend
+     *
+     * @param bNoValue {Boolean?}
+     *   Whether the operand is to be passed to combine as is (e.g., as a
+     *   symbol table entry) rather than as its value
+     */
+    __compileUnary : function(combine, bCanSuspend, bNoValue)
+    {
+      // Create a function which retrieves the operand's value, if required
+      var operand = function(v, data)
+      {
+        return bNoValue ? v : this.getExpressionValue(v, data);
+      };
+
+      if (! bCanSuspend)
+      {
+        this._eval = function(data)
+        {
+          return combine.call(
+            this,
+            operand.call(this, this.children[0]._eval(data), data));
+        };
+        return;
+      }
+
+      this._exec = function(data, success, failure)
+      {
+        this.children[0].execute(
+          data,
+          function(v)
+          {
+            var             result;
+
+            try
+            {
+              result = combine.call(this, operand.call(this, v, data));
+            }
+            catch(e)
+            {
+              failure(e);
+              return;
+            }
+
+            success(result);
+          }.bind(this),
+          failure);
+      };
+    },
+
+    /**
+     * Helper function for function calls. The function is called, and
+     * success is passed its return value.
+     *
+     * @param data {Map}
+     *   The data map currently in use for recursive calls to process()
+     *
+     * @param success {Function}
+     *   Function to call upon successful completion of this call
+     *
+     * @param failure {Function}
+     *   Function to call upon failed completion of this call
+     */
+    __callFunction : function(data, success, failure)
+    {
+      var             sp;
+      var             origSp;
+      var             depth;
+      var             symtab;
+      var             declarator;
+      var             function_decl;
+      var             value1;
+      var             value2;
+      var             value3;
+      var             oldArgs;
+      var             oldArgTypes;
+      var             oldIsBuiltin;
+      var             mem;
+
+      // Get a quick reference to memory
+      mem = playground.c.lib.Node.__mem;
+
+      // Save the stack pointer, so we can restore it after the function call
+      origSp = mem.getReg("SP", "unsigned int");
+      
+      // Retrieve the symbol table entry for this function
+      this.children[0].execute(
+        data,
+        function(v)
+        {
+          var             type;
+
+          value1 = v;
+          
+          // Ensure that we got a function, and get its type
+          try
+          {
+            type = this.__functionType(value1);
+          }
+          catch(e)
+          {
+            failure(e);
+            return;
+          }
+
+          // Get the address of that entry, which is the node for the called
+          // function, or the reference of a built-in function.
+          value2 = value1.getAddr(); // THIS RETURNS A NODE
+
+          // Save any old argument array and built-in indicator
+          oldArgs = data.args;
+          oldArgTypes = data.argTypes;
+          oldIsBuiltin = data.isBuiltin;
+
+          // Prepare to save function arguments, for type checking and use
+          // by builtins.
+          data.args = [];
+          data.argTypes = [];
+
+          // Prepare to save arguments in a JS array as well as on the
+          // stack, in case this is a built-in function being called.
+          if (type == "builtIn")
+          {
+            data.isBuiltin = true;
+          }
+          else
+          {
+            // In case this is a non-builtIn embedded in a builtIn, remove
+            // any arguments from the data objects.
+            delete data.isBuiltin;
+
+            // Ensure that this function has been defined, not just declared
+            if (! value2 || value1.getLine() > this.line)
+            {
+              // Nope, it hasn't.
+              failure(
+                new playground.c.lib.RuntimeError(
+                  this,
+                  "Function '" + value1.getName() + 
+                  "' has not been defined."));
+              return;
+            }
+            
+            // Get the stack pointer's current value
+            sp = playground.c.lib.Node.__mem.getReg("SP", "unsigned int");
+
+            // This is a real function (not built-in). Begin the activation
+            // record
+            mem.beginActivationRecord(sp);
+
+            // Name this activation record
+            declarator = value2.children[1];
+            function_decl = declarator.children[0];
+            depth = ++playground.c.lib.Node._depth;
+            mem.nameActivationRecord("Stack: Activation Record " + 
+                                     depth + ": " + 
+                                     function_decl.children[0].value);
+          }
+          
+          // Push the arguments onto the stack
+          this.children[1].execute(
+            data,
+            function()
+            {
+              var             terminal;
+              var             error;
+              var             symbols;
+              var             functionName;
+              var             incompatible;
+
+              // Is this a built-in function, or a user-generated one?
+              if (value1.getSpecAndDecl()[0].getType() == "builtIn")
+              {
+                // Prepend failure and then the success functions
+                data.args.unshift(failure);
+                data.args.unshift(
+                  function(ret)
+                  {
+                    // Save the return value
+                    value3 = ret;
+
+                    // Restore the old argument array and built-in
+                    // indicator, if they existed
+                    data.args = oldArgs;
+                    data.argTypes = oldArgTypes;
+                    data.isBuiltin = oldIsBuiltin;
+
+                    // Restore the stack pointer
+                    mem.setReg("SP", "unsigned int", origSp);
+                    success(value3);
+                  });
+                
+                // Call the function now
+                value2.apply(null, data.args);
+              }
+              else
+              {
+                // Confirm that argument types match the formal parameter
+                // declarations. First, retrieve the function's symtab
+                symtab = value2._symtab;
+                
+                // Get the function name, by stripping off the leading "path"
+                functionName = symtab.getName().split("/");
+                functionName = functionName[functionName.length - 1];
+                
+                // Get the list of symbols from this symtab
+                symbols = symtab.getSymbols();
+                
+                // Ensure that the number of arguments matches the number of
+                // declared parameters.
+                if (symbols.length > data.argTypes.length)
+                {
+                  error =
+                    "The function " + functionName + " expects " +
+                    symbols.length + 
+                    (symbols.length == 1 ? " argument" : " arguments") +
+                    ", but received only " +
+                    data.argTypes.length;
+                }
+                else if (symbols.length < data.argTypes.length)
+                {
+                  error =
+                    "The function " + functionName + " expects only " +
+                    symbols.length + 
+                    (symbols.length == 1 ? " argument" : " arguments") +
+                    ", but received " +
+                    data.argTypes.length;
+                }
+                else
+                {
+                  // Compare each argument's type agains each symbol's type
+                  incompatible = symbols.filter(
+                    function(entry, i)
+                    {
+                      var             incompatible = [];
+                      var             thisSpecAndDecl;
+                      var             otherSpecAndDecl;
+
+                      // Get this parameter's specifier/declarator list
+                      thisSpecAndDecl = entry.getSpecAndDecl();
+
+                      // Get the argument's specifier/declarator list
+                      otherSpecAndDecl = data.argTypes[i];
+
+                      // Specifier/declarator lists must be the same length
+                      if (thisSpecAndDecl.length != otherSpecAndDecl.length)
+                      {
+                        // Add an entry to show that they're incompatible
+                        incompatible.push(1); 
+                      }
+                      else
+                      {
+                        // Compare each specifier/declarator. If any are not
+                        // compatible, then the list is incompatible.
+                        incompatible =
+                          thisSpecAndDecl.filter(
+                            function(specOrDecl, i)
+                            {
+                              var             incompatible;
+                              incompatible = 
+                                ! specOrDecl.isCompatible(
+                                  otherSpecAndDecl[i],
+                                  otherSpecAndDecl.length == 1);
+                              return incompatible;
+                            });
+                      }
+
+                      if (incompatible.length > 0)
+                      {
+                        error =
+                          "The type of argument " + (i + 1) + 
+                          " to function " + functionName +
+                          " is " +
+                          "incompatible with the declaration " +
+                          "of parameter " + entry.getName() + 
+                          "\n" +
+                          "  Argument type: " + 
+                          playground.c.lib.SymtabEntry.getInfo(
+                            otherSpecAndDecl).description +
+                          "\n" +
+                          "  Expected type for " +  entry.getName() + ": " + 
+                          playground.c.lib.SymtabEntry.getInfo(
+                          thisSpecAndDecl).description;
+                      }
+                    }.bind(this));
+                }
+
+                if (false)
+                {
+                  // If not compatible, display a warning.
+                  // FIXME: this should be an error, not a warning. We'll
+                  // leave it as a warning until feeling sure that it doesn't
+                  // generate messages when it shouldn't.
+                  if (error)
+                  {
+                    error = "Line " + this.line + ": " + error + "\n";
+
+                    try
+                    {
+                      terminal = 
+                        qx.core.Init.getApplication().getUserData(
+                          "terminal");
+                      terminal.addOutput(error);
+                    }
+                    catch(e)
+                    {
+                      console.log(error);
+                    }
+                  }
+                }
+                else
+                {
+                  if (error)
+                  {
+                    failure(new playground.c.lib.RuntimeError(this, error));
+                    return;
+                  }
+                }
+
+                // Push the return address (our current line number) onto
+                // the stack
+                sp = mem.stackPush("unsigned int", this.line);
+
+                // Add "symbol info" to show that this was a return address
+                mem.setReturnAddressInfo(sp);
+
+                // Process that function. Save its return value in value3
+                value2.execute(
+                  data,
+                  function(v)
+                  {
+                    value3 = v;
+                    
+                    // We're finished with this activation record.
+                    mem.endActivationRecord();
+
+                    // We've completed a level of function call. Reduce depth.
+                    playground.c.lib.Node._depth--;
+
+                    // Restore the old argument array and built-in
+                    // indicator, if they exist.
+                    data.args = oldArgs;
+                    data.argTypes = oldArgTypes;
+                    data.isBuiltin = oldIsBuiltin;
+
+                    // Restore the stack pointer
+                    mem.setReg("SP", "unsigned int", origSp);
+                    success(value3);
+                  }.bind(this),
+                  failure);
+              }
+            }.bind(this),
+            failure);
+        }.bind(this),
+        failure);
+    },
+
+    /**
+     * Helper function for function calls. Ensure that the value being
+     * called is a function.
+     *
+     * @param value1 {playground.c.lib.SymtabEntry|Map}
+     *   The value being called
+     *
+     * @return {String}
+     *   "builtIn" for a built-in function; "function" otherwise
+     *
+     * @throws {playground.c.lib.RuntimeError}
+     *   If the value is not a function
+     */
+    __functionType : function(value1)
+    {
+      var             type;
+
+      // Ensure that we got a symbol table entry.
+      if (! (value1 instanceof playground.c.lib.SymtabEntry))
+      {
+        throw new playground.c.lib.RuntimeError(
+          this,
+          "This appears to be attempting to call a function, " +
+          "but the identifier  being called is not defined as " +
+          "a function.");
+      }
+
+      // Get the type of this (supposed) function
+      type = value1.getSpecAndDecl()[0].getType();
+
+      if (type != "builtIn" && type != "function")
+      {
+        throw new playground.c.lib.RuntimeError(
+          this,
+          "Attempting to call function '" +
+          value1.getName() +
+          "' but '" +
+          value1.getName() +
+          "' is not declared as a function.");
+      }
+
+      return type;
+    },
+
+    /**
+     * Determine, at compile time, whether this function call is of a
+     * built-in function which does not block.
+     *
+     * @return {Boolean}
+     *   true if the function called is a built-in function which completes
+     *   before returning; false otherwise
+     */
+    __isNonBlockingBuiltIn : function()
+    {
+      var             node = this.children[0];
+      var             entry;
+      var             specAndDecl;
+
+      // Find the name of the function being called
+      while (node.type == "primary_expression")
+      {
+        node = node.children[0];
+      }
+
+      if (node.type != "identifier")
+      {
+        return false;
+      }
+
+      // Built-in functions are in the root symbol table
+      entry = playground.c.lib.Symtab.getByName("*").get(node.value, true);
+      specAndDecl = entry && entry.getSpecAndDecl();
+
+      return (
+        !! specAndDecl &&
+        specAndDecl[0] instanceof playground.c.lib.Declarator &&
+        specAndDecl[0].getType() == "builtIn" &&
+        ! specAndDecl[0].isBuiltInBlocking());
+    },
+
+    /**
+     * Helper function for calls to built-in functions which do not block.
+     * This is the synchronous counterpart of __callFunction().
+     *
+     * @param data {Map}
+     *   The data map currently in use for recursive calls to process()
+     *
+     * @return {Map}
+     *   The function's return value
+     *
+     * @throws {Error}
+     *   The error with which the function failed
+     */
+    __callBuiltIn : function(data)
+    {
+      var             entry;
+      var             declarator;
+      var             ret;
+      var             error;
+      var             bDone = false;
+      var             oldArgs = data.args;
+      var             oldArgTypes = data.argTypes;
+      var             oldIsBuiltin = data.isBuiltin;
+      var             mem = playground.c.lib.Node.__mem;
+      var             origSp = mem.getReg("SP", "unsigned int");
+
+      // Retrieve the symbol table entry for this function. Ensure that it's
+      // still the built-in function found at compile time.
+      entry = this.children[0]._eval(data);
+      this.__functionType(entry);
+      declarator = entry.getSpecAndDecl()[0];
+      if (declarator.getType() != "builtIn" ||
+          declarator.isBuiltInBlocking())
+      {
+        throw new Error("Internal error: " + entry.getName() +
+                        " is not a non-blocking built-in function");
+      }
+
+      // Save the arguments in a JS array, for use by the built-in
+      data.args = [];
+      data.argTypes = [];
+      data.isBuiltin = true;
+      this.children[1]._eval(data);
+
+      // Call the function now, with the success and failure functions
+      // prepended to the arguments
+      playground.c.lib.Node._currentNode = this;
+      declarator.getBuiltIn().apply(
+        null,
+        [
+          function(v)
+          {
+            if (! bDone)
+            {
+              bDone = true;
+              ret = v;
+            }
+          },
+          function(e)
+          {
+            if (! bDone)
+            {
+              bDone = true;
+              error = e;
+            }
+          }
+        ].concat(data.args));
+
+      // It must have completed
+      if (! bDone)
+      {
+        throw new Error("Internal error: built-in function " +
+                        entry.getName() + " did not complete");
+      }
+
+      // Restore the old argument array and built-in indicator, if they
+      // existed, and the stack pointer
+      data.args = oldArgs;
+      data.argTypes = oldArgTypes;
+      data.isBuiltin = oldIsBuiltin;
+      mem.setReg("SP", "unsigned int", origSp);
+
+      if (error)
+      {
+        throw error;
+      }
+
+      return ret;
+    },
+
+    /**
+     * Helper function for argument lists. Save an argument for a function
+     * call, and for a function that is not built in, push it onto the stack.
+     *
+     * @param v {playground.c.lib.SymtabEntry|Map}
+     *   The argument
+     *
+     * @param data {Map}
+     *   The data map currently in use for recursive calls to process(). The
+     *   argument is prepended to its args and argTypes arrays.
+     */
+    __pushArgument : function(v, data)
+    {
+      var             type;
+      var             value1;
+      var             specOrDecl;
+      var             origSpecAndDecl;
+
+      value1 = this.getExpressionValue(v, data);
+
+      // Save the original specifier/declarator list
+      origSpecAndDecl = value1.specAndDecl.slice(0);
+
+      // Pull the first specifier/declarator off of the list. We'll replace it
+      // with one containing the (possibly unaltered) promoted type.
+      specOrDecl = value1.specAndDecl.shift();
+
+      // Is this a declarator?
+      if (specOrDecl instanceof playground.c.lib.Declarator)
+      {
+        // Yup. We're going to push an address
+        type = "pointer";
+      }
+      else
+      {
+        // It's a specifier. Get a new specifier with a (possibly) increased
+        // size appropriate as a promoted argument.
+        specOrDecl = specOrDecl.promote();
+
+        // Get the memory access type from this specifier
+        type = specOrDecl.getCType();
+      }
+
+      // Put the (possibly altered) specifier/declarator back onto the list
+      // of specifiers/declarators
+      value1.specAndDecl.unshift(specOrDecl);
+
+      // Save this argument
+      data.args.unshift(value1.value);
+      data.argTypes.unshift(origSpecAndDecl);
+
+      // If this is not a built-in function...
+      if (! data.isBuiltin)
+      {
+        // ... then push the arguments onto the stack
+        playground.c.lib.Node.__mem.stackPush(type, value1.value);
+      }
+    },
+
+    /**
+     * Helper function for string literals. Space for the string is allocated
+     * in global memory, and the string written there, upon first use.
+     *
+     * @return {Map}
+     *   A map containing the address of the string, and its type (char *)
+     */
+    __stringLiteral : function()
+    {
+      var             specAndDecl;
+
+      // Have we already allocated space for this string?
+      if (! this._mem)
+      {
+        // Nope. Allocate the space now
+        this._mem =
+          playground.c.lib.Symtab.allocGlobalSpace(this.value.length + 1,
+                                                   "string",
+                                                   this.line);
+        
+        // Write the string, as null-terminated character codes, into the
+        // allocated memory
+        playground.c.lib.Node.__mem.setBytes(
+          this._mem,
+          this.value.split("").map(
+            function(ch)
+            {
+              return ch.charCodeAt(0);
+            }).concat(0));
+      }
+      
+      // Create an initially-empty specifier/declarator list
+      specAndDecl = [];
+
+      // Create a declarator to indicate that it's a pointer, and add it to
+      // the specifier/declarator list
+      specAndDecl.push(new playground.c.lib.Declarator(this, "pointer"));
+
+      // Create a specifier to indicate that it's a char *
+      specAndDecl.push(new playground.c.lib.Specifier(this, "int", "char"));
+
+      return (
+        {
+          value       : this._mem, 
+          specAndDecl : specAndDecl
+        });
+    },
+
+    /**
+     * Helper function for array element references. Ensure that a value can
+     * be indexed, and determine where its elements begin, and their size.
+     *
+     * @param value1 {playground.c.lib.SymtabEntry|Map}
+     *   The array or pointer being indexed
+     *
+     * @return {Map}
+     *   A map containing the address of the first element (addr), the
+     *   specifier/declarator list of an element (specAndDecl), and the size
+     *   of an element in bytes (size)
+     *
+     * @throws {playground.c.lib.RuntimeError}
+     *   If the value is neither an array nor a pointer
+     */
+    __elementBase : function(value1)
+    {
+      var             addr;
+      var             type;
+      var             specOrDecl;
+      var             specAndDecl;
+
+      // Figure out where the specifier/declarator list is, and retrieve it.
+      if (value1 instanceof playground.c.lib.SymtabEntry)
+      {
+        specAndDecl = value1.getSpecAndDecl();
+      }
+      else
+      {
+        specAndDecl = value1.specAndDecl;
+
+        // If we got the address of an array, reduce it to just array
+        if (specAndDecl.length >= 2 &&
+            specAndDecl[0].getType() == "address" &&
+            specAndDecl[1].getType() == "array")
+        {
+          // Remove the 'address' declarator
+          specAndDecl.shift();
+        }
+      }
+
+      // Look at the first specifier/declarator to ensure this can be indexed
+      specOrDecl = specAndDecl[0];
+
+      // Ensure this an array or a pointer
+      type = specOrDecl.getType();
+      if (type != "array" && type != "pointer")
+      {
+        throw new playground.c.lib.RuntimeError(
+          this,
+          "Can't access an array element of something " +
+            "that is not an array");
+      }
+
+      // If we got a symbol table entry...
+      if (value1 instanceof playground.c.lib.SymtabEntry)
+      {
+        // ... then retrieve the symbol's address
+        addr = value1.getAddr();
+
+        // If this is a pointer...
+        if (type == "pointer" || value1.getIsParameter())
+        {
+          // ... then we need to get the address that the pointer points to.
+          addr = playground.c.lib.Node.__mem.get(addr, "pointer", true);
+        }
+      }
+      else
+      {
+        // We already have an address
+        addr = value1.value;
+      }
+
+      // Strip the initial (pointer or array) entry from a copy of the
+      // specifier/declarator list, to find out how many bytes a value of the
+      // remaining specifier/declarator list consumes
+      specAndDecl = specAndDecl.slice(1);
+
+      return (
+        {
+          addr        : addr,
+          specAndDecl : specAndDecl,
+          size        : specAndDecl[0].calculateByteCount(1, specAndDecl, 0)
+        });
+    },
+
+    /**
+     * Helper function for array element references. Determine the address
+     * of an element.
+     *
+     * @param base {Map}
+     *   The map returned by __elementBase() for the array or pointer being
+     *   indexed. Its specifier/declarator list is used in the result.
+     *
+     * @param value2 {Map}
+     *   The value of the index
+     *
+     * @return {Map}
+     *   The address of the element, and its specifier/declarator list
+     *
+     * @throws {playground.c.lib.RuntimeError}
+     *   If the index is not an integer
+     */
+    __elementAddress : function(base, value2)
+    {
+      var             specOrDecl;
+
+      // We'd better have a specifier to say what type this is.
+      specOrDecl = value2.specAndDecl[0];
+      if (! (specOrDecl instanceof playground.c.lib.Specifier) ||
+          specOrDecl.getType() != "int")
+      {
+        throw new playground.c.lib.RuntimeError(
+          this,
+          "Array index must evaluate to an integer");
+      }
+
+      // Prepend a special "address" declarator
+      base.specAndDecl.unshift(
+        new playground.c.lib.Declarator(this, "address"));
+
+      // The return value will be the base address plus the byte count of
+      // each element multiplied by the desired index.
+      return (
+        {
+          value       : base.addr + base.size * value2.value,
+          specAndDecl : base.specAndDecl
+        });
+    },
+
+    /**
+     * Helper function for pointer dereferences. Determine the address to
+     * which a pointer points.
+     *
+     * @param value {playground.c.lib.SymtabEntry|Map}
+     *   The pointer (or address) being dereferenced
+     *
+     * @return {Map}
+     *   The address to which it points, and its specifier/declarator list
+     *
+     * @throws {playground.c.lib.RuntimeError}
+     *   If the value is not one which can be dereferenced
+     */
+    __dereference : function(value)
+    {
+      var             addr;
+      var             type;
+      var             specOrDecl;
+      var             specAndDecl;
+      var             typeDescription;
+
+      // If we found a symbol, get its address and type
+      if (value instanceof playground.c.lib.SymtabEntry)
+      {
+        // Find the address from which we will retrieve the pointer
+        addr = value.getAddr();
+
+        // Obtain the specifier/declarator list
+        specAndDecl = value.getSpecAndDecl().slice(0);
+
+        // Get the address contained in this pointer
+        if (specAndDecl[0].getType() != "array")
+        {
+          addr = playground.c.lib.Node.__mem.get(addr, "pointer", true);
+        }
+      }
+      else
+      {
+        // Find the address from which we will retrieve the pointer
+        addr = value.value;
+
+        // Obtain the specifier/declarator list
+        specAndDecl = value.specAndDecl.slice(0);
+      }
+
+      // Pull the first specifier/declarator off of the list
+      specOrDecl = specAndDecl.shift();
+      type = specOrDecl.getType();
+
+      // Ensure that we can dereference this thing. To be able to, it must be
+      // either a pointer whose value must be retrieved, or already an
+      // adderess.
+      //
+      // Also, if it's an address, it must be the address of a pointer if we
+      // are to dereference it.
+      // FIXME: This means that we can't do something like the following:
+      //
+      //   int i;
+      //   *&i = 23;
+      //
+      // which should work, but breaks test t052 if we don't require the
+      // address of a pointer. See test exclude test x066 which demonstrates
+      // the problem. See also Issue #42.
+      //
+      if ((type != "pointer" && type != "address" && type != "array") ||
+          (type == "address" && specAndDecl[0].getType() != "pointer"))
+      {
+        // If it's not an address type...
+        if (type != "address")
+        {
+          // ... then get the full specifier/declarator list back
+          specAndDecl.unshift(specOrDecl);
+        }
+
+        // Get a description of the type they're trying to dereference
+        typeDescription =
+          playground.c.lib.SymtabEntry.getInfo(specAndDecl).description;
+
+        throw new playground.c.lib.RuntimeError(
+          this,
+          "You have attempted to dereference a value whose " +
+            "type does not indicate that it is an address. " +
+            "Its type is '" + typeDescription + "'");
+      }
+
+      // We don't currently support pointers to functions
+      if (type == "pointer" && specAndDecl[0].getType() == "function")
+      {
+        throw new playground.c.lib.RuntimeError(
+          this,
+          "Dereferencing pointers to function is currently not supported.");
+      }
+
+      // Prepend an "address" declarator
+      specAndDecl.unshift(new playground.c.lib.Declarator(this, "address"));
+
+      // The result is the value of the pointer.
+      return (
+        {
+          specAndDecl : specAndDecl,
+          value       : addr
+        });
+    },
+
+    /**
+     * Helper function for structure and union member references. Determine
+     * the address of the structure or union, and the symbol table of its
+     * members.
+     *
+     * @param v {playground.c.lib.SymtabEntry|Map}
+     *   The structure or union variable, or the value of an expression
+     *   providing its address
+     *
+     * @return {Map}
+     *   A map containing the address of the structure or union and its
+     *   specifier/declarator list (value), the symbol table of its members
+     *   (symtab), and its struct or union specifier (specifier)
+     *
+     * @throws {playground.c.lib.RuntimeError}
+     *   If the value is not a structure or union
+     */
+    __structureBase : function(v)
+    {
+      var             value1 = v;
+      var             specifier;
+      var             symtab;
+
+      // If we got a symbol, retrieve its address. Otherwise, we already have
+      // an address.
+      if (value1 instanceof playground.c.lib.SymtabEntry)
+      {
+        value1 =
+          {
+            specAndDecl : v.getSpecAndDecl(),
+            value       : v.getAddr()
+          };
+      }
+
+      // Get the symbol table of the struct/union members. It's in the
+      // specifier.
+      specifier = value1.specAndDecl[value1.specAndDecl.length - 1];
+      symtab = specifier.getStructSymtab();
+
+      // If we didn't find a struct/union symbol table...
+      if (! symtab)
+      {
+        // ... then this identifier is not a struct/union
+        throw new playground.c.lib.RuntimeError(
+          this,
+          "The dot following '" + v.getName() + "' " +
+          "indicates that you are trying to reference " +
+          "a structure or union member,\n" +
+          "but variable '" + v.getName() + "' " +
+          "is not declared as a " +
+          "structure or union.");
+      }
+
+      return (
+        {
+          value     : value1,
+          symtab    : symtab,
+          specifier : specifier
+        });
+    },
+
+    /**
+     * Helper function for structure and union member references. Determine
+     * the address of a member.
+     *
+     * @param base {Map}
+     *   The map returned by __structureBase() for the structure or union.
+     *   Its value is altered to become the result.
+     *
+     * @param v {playground.c.lib.SymtabEntry}
+     *   The member's symbol table entry, looked up in the structure or
+     *   union's symbol table
+     *
+     * @return {Map}
+     *   The address of the member, and its specifier/declarator list
+     *
+     * @throws {playground.c.lib.RuntimeError}
+     *   If the member is not one of the structure or union
+     */
+    __memberAddress : function(base, v)
+    {
+      var             value1 = base.value;
+      var             specOrDecl;
+
+      // We must have received a symtab entry.
+      if (! (v instanceof playground.c.lib.SymtabEntry))
+      {
+        throw new playground.c.lib.RuntimeError(
+          this,
+          "A structure or union reference must have a " +
+          "member name to the right of the dot.");
+      }
+
+      // The entry must be in the struct/union symtab
+      if (v.getSymtab() != base.symtab)
+      {
+        throw new playground.c.lib.RuntimeError(
+          this,
+          "Unrecognized struct or union member: " + v.getName());
+      }
+
+      // Get this member's offset from the beginning of the struct, and add
+      // it to the previously-determined address.
+      value1.value += v.getOffset();
+      value1.specAndDecl = v.getSpecAndDecl();
+
+      // We're providing the address of this member. Indicate such. Prepend
+      // an "address" declarator if there isn't already one at the beginning
+      // of the specifier/declarator list
+      specOrDecl = value1.specAndDecl[0];
+      if (! (specOrDecl instanceof playground.c.lib.Declarator) ||
+          base.specifier.getType() != "address")
+      {
+        value1.specAndDecl.unshift(
+          new playground.c.lib.Declarator(this, "address"));
+      }
+
+      return value1;
+    },
+
+    /**
+     * Helper function for casts. Convert a value to a new type.
+     *
+     * @param castData {Map}
+     *   The cast's type, as provided by its type_name node
+     *
+     * @param value1 {Map}
+     *   The value being cast. It is altered to become the result.
+     *
+     * @return {Map}
+     *   The converted value, with the cast's specifier/declarator list
+     */
+    __cast : function(castData, value1)
+    {
+      var             oldType;
+      var             newType;
+      var             typeSize;
+      var             specOrDecl;
+      var             mem = playground.c.lib.Node.__mem;
+      var             Memory = playground.c.machine.Memory;
+
+      // Determine the type of the original value
+      specOrDecl = value1.specAndDecl[0];
+      if (specOrDecl instanceof playground.c.lib.Declarator)
+      {
+        // We found a declarator, meaning the original type was either a
+        // pointer or an array, both of which we take to be pointer.
+        oldType = "pointer";
+      }
+      else
+      {
+        // Get the type from this specifier
+        oldType = specOrDecl.getCType();
+      }
+
+      // Determine the type in memory
+      specOrDecl = castData.specAndDecl[0];
+      if (specOrDecl instanceof playground.c.lib.Declarator)
+      {
+        // We found a declarator, meaning the new type is either a pointer or
+        // an array, both of which we take to be pointer.
+        newType = "pointer";
+      }
+      else
+      {
+        // Get the type from this specifier
+        newType = specOrDecl.getCType();
+      }
+
+      // Determine the value's original size in bytes
+      typeSize = Memory.typeSize[oldType];
+
+      // If it's less than the word size, we'll sign-extend.
+      if (typeSize < Memory.WORDSIZE)
+      {
+        // Convert that size to a number of bits
+        typeSize *= 8;
+
+        // If the value's high bit is on...
+        if (value1.value & (1 << (typeSize - 1)))
+        {
+          // ... then fill the register with 1s
+          mem.setReg("R1", "long", -1);
+        }
+        else
+        {
+          // otherwise, fill the register with 0s.
+          mem.setReg("R1", "long", 0);
+        }
+      }
+
+      // If the old type's size is bigger than the new type's size...
+      if (Memory.typeSize[oldType] > Memory.typeSize[newType])
+      {
+        // ... then reduce the size by writing the value to memory using the
+        // value's original specifier/declarator list and reading it back
+        // using the cast's specifier/declarator list.
+        mem.setReg("R1", oldType, value1.value);
+        value1.value = mem.getReg("R1", newType);
+      }
+
+      // Save the value as its new type, then retrieve it, to do the actual
+      // conversion (if necessary)
+      mem.setReg("R1", newType, value1.value);
+      value1.value = mem.getReg("R1", newType);
+
+      // Assign the cast's specifier/declarator list to the value
+      value1.specAndDecl = castData.specAndDecl;
+
+      return value1;
+    },
+
+    /**
+     * Helper function for loops. Catch a break from the loop, restoring the
+     * symbol table stack to where it was when the loop was entered. Any
+     * other error is re-thrown.
+     *
+     * @param error {Error}
+     *   The error caught
+     *
+     * @param symtab {playground.c.lib.Symtab}
+     *   The current symbol table when the loop was entered
+     *
+     * @param success {Function}
+     *   Function to call upon a break
+     *
+     * @param failure {Function}
+     *   Function to call upon any other error
+     */
+    __catchBreak : function(error, symtab, success, failure)
+    {
+      // Was a break statement executed?
+      if (! (error instanceof playground.c.lib.Break))
+      {
+        // It's not a break. Re-throw the error
+        this._throwIt(error, success, failure);
+        return;
+      }
+
+      // Restore symbol table to where it was when we entered the statement
+      // from which we are breaking
+      while (playground.c.lib.Symtab.getCurrent() != symtab)
+      {
+        playground.c.lib.Symtab.popStack();
+      }
+      success();
+    },
+
+    /**
+     * Helper funciton for assignments.
+     *
+     * @param data {Map}
+     *   The data map currently in use for recursive calls to process()
+     *
+     * @param fOp {Function}
+     *   Function to produce the result for assignment. It takes two
+     *   arguments: the old (original) value of the lhs, and the new value.
+     * 
+     * @param bUseOld {Boolean}
+     *   true if the old value of the right-hand side is used;
+     *   false if it is not used
+     * 
+     * @param success {Function}
+     *   Function to call upon successful completion of this call
+     * 
+     * @param failure {Function}
+     *   Function to call upon failed completion of this call
+     *
+     * @param bUnary {Boolean}
+     *   true if this is a unary operator (pre/post-increment/decrement)
+     *   false otherwise
+     *
+     * @param bPostOp {Boolean}
+     *   true if this is a post-increment or post-decrement operation;
+     *   false otherwise
+     *
+     * @return {Map}
+     *   Upon success, a map containing the resulting value and its type is
+     *   returned. Upon failure (lhs is not an lvalue), null is returned.
+     */
+    __assignHelper : function(data, fOp, bUseOld, 
+                              success, failure, bUnary, bPostOp)
+    {
+      // Retrieve the lvalue
+      this.children[0].execute(
+        data,
+        function(v)
+        {
+          var             i;
+          var             target;
+          var             result;
+          var             bString;
+          var             initializerList;
+          var             next;
+
+          try
+          {
+            // Determine where, and as what type, the value is to be saved
+            target = this.__assignTarget(v, data, bUseOld);
+
+            // If it's a unary operator (pre/post increment/decrement), then
+            // the retrieved value is altered.
+            if (bUnary)
+            {
+              result = this.__assignIncrement(target, data, fOp, bPostOp);
+            }
+          }
+          catch(e)
+          {
+            failure(e);
+            return;
+          }
+
+          if (bUnary)
+          {
+            success(result);
+            return;
+          }
+          
+          // Not unary. See if we're handling an initializer list
+          if (this.children[1].type == "initializer_list")
+          {
+            // Get a reference to the initializer list, for quick access
+            initializerList = this.children[1].children;
+
+            // Assign each initializer in turn. Each assignment advances the
+            // target address past the element assigned.
+            i = 0;
+            next = function()
+            {
+              if (i >= initializerList.length)
+              {
+                success();
+                return;
+              }
+
+              initializerList[i++].execute(
+                data,
+                function(v)
+                {
+                  try
+                  {
+                    this.__assignValue(target, data, fOp, v);
+                  }
+                  catch(e)
+                  {
+                    failure(e);
+                    return;
+                  }
+
+                  next();
+                }.bind(this),
+                failure);
+            }.bind(this);
+
+            next();
+            return;
+          }
+
+          // See if we're initializing a char array from a character string
+          try
+          {
+            bString = this.__assignString(v);
+          }
+          catch(e)
+          {
+            failure(e);
+            return;
+          }
+
+          if (bString)
+          {
+            success();
+            return;
+          }
+
+          // No initializers.
+          this.children[1].execute(
+            data,
+            function(v)
+            {
+              var             result;
+
+              try
+              {
+                result = this.__assignValue(target, data, fOp, v);
+              }
+              catch(e)
+              {
+                failure(e);
+                return;
+              }
+
+              success(result);
+            }.bind(this),
+            failure);
+        }.bind(this),
+        failure);
+    },
+
+    /**
+     * Helper function for assignments. Ensure that a value can be assigned
+     * to, and determine where, and as what memory type, it's saved.
+     *
+     * @param v {playground.c.lib.SymtabEntry|Map}
+     *   The left hand side of the assignment
+     *
+     * @param data {Map}
+     *   The data map currently in use for recursive calls to process()
+     *
+     * @param bUseOld {Boolean}
+     *   true if the old value of the left hand side is used;
+     *   false if it is not used
+     *
+     * @return {Map}
+     *   A map containing the address and specifier/declarator list of the
+     *   left hand side (value1), the memory type (type), the old value
+     *   (value), and bUseOld. It is to be passed to the other assignment
+     *   helpers.
+     *
+     * @throws {playground.c.lib.RuntimeError}
+     *   If the left hand side can not be assigned to
+     */
+    __assignTarget : function(v, data, bUseOld)
+    {
+      var             type;
+      var             value;
+      var             value1;
+      var             specOrDecl;
+      var             specAndDecl;
+      var             bFirst;
+
+      // If it was a symbol table entry...
+      if (! (v instanceof playground.c.lib.SymtabEntry) &&
+          v.specAndDecl[0].getType() != "address")
+      {
+        throw new playground.c.lib.RuntimeError(
+          this,
+          "The left hand side of an assignment must be " +
+          "a variable, pointer dereference, " +
+          "or array element reference");
+      }
+
+      // Retrieve the value
+      value1 = this.getExpressionValue(v, data, true);
+
+      // Get a shallow copy of the specifier/declarator list
+      specAndDecl = value1.specAndDecl.slice(0);
+
+      // Only loop a maximum of one time
+      bFirst = true;
+
+      do
+      {
+        // Get the first specifier/declarator
+        specOrDecl = specAndDecl[0];
+
+        // Determine the memory type to use for saving the value
+        switch(specOrDecl.getType())
+        {
+        case "pointer" :
+        case "function" :
+          type = "pointer";
+          break;
+
+        case "array" :      // should only happen in initializers
+          // Find out the type based on the next specifier/declarator
+          specAndDecl.shift();
+          continue;
+
+        case "address" :
+          // Find out the type based on the next specifier/declarator
+          if (bFirst)
+          {
+            bFirst = false;
+            specAndDecl.shift();
+            continue;
+          }
+
+          // There were two "address" declarators in a row. It's a pointer.
+          type = "pointer";
+          break;
+
+        case "builtIn" :
+          throw new playground.c.lib.RuntimeError(
+            this,
+            "You are attempting to assign to an existing " +
+            "function name, i.e., the left hand side of an assignment " +
+            "can not be the name of a function.");
+
+        default :
+          if (specOrDecl instanceof playground.c.lib.Specifier)
+          {
+            type = specOrDecl.getCType();
+          }
+          else
+          {
+            throw new Error("Internal error: unexpected type: " + 
+                            specOrDecl.getType());
+          }
+          break;
+        }
+
+        // Normal exit from the loop
+        break;
+      } while (true);
+
+      // Retrieve the current value
+      if (type != "struct" && type != "union" && type != "enum")
+      {
+        value = playground.c.lib.Node.__mem.get(value1.value, type, bUseOld);
+      }
+
+      return (
+        {
+          value1  : value1,
+          type    : type,
+          value   : value,
+          bUseOld : bUseOld
+        });
+    },
+
+    /**
+     * Helper function for pre/post-increment/decrement. The value of the
+     * target is altered by one, or for a pointer, by the size of what's
+     * pointed to.
+     *
+     * @param target {Map}
+     *   The map returned by __assignTarget()
+     *
+     * @param data {Map}
+     *   The data map currently in use for recursive calls to process()
+     *
+     * @param fOp {Function}
+     *   Function to produce the new value from the old value and the size
+     *   of the increment
+     *
+     * @param bPostOp {Boolean}
+     *   true if this is a post-increment or post-decrement operation;
+     *   false otherwise
+     *
+     * @return {Map}
+     *   A map containing the resulting value and its type
+     */
+    __assignIncrement : function(target, data, fOp, bPostOp)
+    {
+      var             size;
+      var             specAndDecl;
+      var             value1 = target.value1;
+
+      // Assume amount to increment by is 1
+      size = 1;
+
+      // If the value being assigned to is a pointer...
+      if (value1.specAndDecl[0].getType() == "pointer")
+      {
+        // ... then figure out the size of what's pointed to
+        specAndDecl = value1.specAndDecl.slice(1);
+        size = specAndDecl[0].calculateByteCount(1, specAndDecl, 0);
+      }
+
+      return this.__assignStore(target, data, fOp, size, size, true, bPostOp);
+    },
+
+    /**
+     * Helper function for assignments from a value.
+     *
+     * @param target {Map}
+     *   The map returned by __assignTarget()
+     *
+     * @param data {Map}
+     *   The data map currently in use for recursive calls to process()
+     *
+     * @param fOp {Function}
+     *   Function to produce the result for assignment, from the old value
+     *   and the new value
+     *
+     * @param v {playground.c.lib.SymtabEntry|Map|undefined}
+     *   The right hand side of the assignment. If undefined, nothing is
+     *   assigned.
+     *
+     * @return {Map|undefined}
+     *   A map containing the resulting value and its type, or undefined if
+     *   nothing was assigned
+     */
+    __assignValue : function(target, data, fOp, v)
+    {
+      var             size;
+      var             value3;
+      var             specAndDecl;
+      var             value1 = target.value1;
+
+      if (typeof v == "undefined")
+      {
+        return undefined;
+      }
+
+      value3 = this.getExpressionValue(v, data);
+
+      // If the value being assigned to is a pointer and the RHS's type is
+      // some sort of int...
+      if (value1.specAndDecl[0].getType() == "pointer")
+      {
+        // ... then figure out the size of what's pointed to
+        specAndDecl = value1.specAndDecl.slice(1);
+        size = specAndDecl[0].calculateByteCount(1, specAndDecl, 0);
+      }
+      else if (value1.specAndDecl[0].getType() == "array")
+      {
+        size = playground.c.machine.Memory.typeSize[target.type];
+      }
+      else
+      {
+        // otherwise, get the size of the thing itself.
+        specAndDecl = value1.specAndDecl.slice(0);
+        size = specAndDecl[0].calculateByteCount(1, specAndDecl, 0);
+      }
+
+      return this.__assignStore(target, data, fOp, value3.value, size);
+    },
+
+    /**
+     * Helper function for assignments to a char array from a character
+     * string. If this assignment is one, the string is copied into the
+     * array.
+     *
+     * @param v {playground.c.lib.SymtabEntry|Map}
+     *   The left hand side of the assignment
+     *
+     * @return {Boolean}
+     *   true if the string was copied; false if this assignment is not from
+     *   a character string to a char array
+     *
+     * @throws {playground.c.lib.RuntimeError}
+     *   If the string does not fit in the array
+     */
+    __assignString : function(v)
+    {
+      var             str;
+      var             specOrDecl;
+
+      if (! (v instanceof playground.c.lib.SymtabEntry &&
+             v.getSpecAndDecl().length == 2 &&
+             v.getSpecAndDecl() &&
+             (specOrDecl = v.getSpecAndDecl()[0]) &&
+             specOrDecl.getType() == "array" &&
+             (specOrDecl = v.getSpecAndDecl()[1]) &&
+             specOrDecl.getType() == "int" &&
+             specOrDecl.getSize() == "char" &&
+             this.children[1].children.length == 1 &&
+             this.children[1].children[0].type == "string_literal"))
+      {
+        return false;
+      }
+
+      // We are. Copy the string in to the array address.
+      // Get a reference to the string, for faster reference
+      str = this.children[1].children[0].value;
+
+      // If we're initializing an array and the initializer is too long...
+      specOrDecl = v.getSpecAndDecl()[0];
+      if (specOrDecl.getType() == "array" &&
+          str.length > specOrDecl.getArrayCount())
+      {
+        // ... then generate a run-time error
+        throw new playground.c.lib.RuntimeError(
+          this,
+          "Array size is " + specOrDecl.getArrayCount() + ", " +
+          "initializer length (including null terminator) is " + 
+          (str.length + 1) +
+          ". Initializers do not fit in array.");
+      }
+
+      // Copy the null-terminated string to memory
+      playground.c.lib.Node.__mem.setBytes(
+        v.getAddr(),
+        str.split("").map(
+          function(c)
+          {
+            return c.charCodeAt(0);
+          }).concat(0));
+
+      return true;
+    },
+
+    /**
+     * Helper function for assignments. Save the new value at the target.
+     *
+     * @param target {Map}
+     *   The map returned by __assignTarget()
+     *
+     * @param data {Map}
+     *   The data map currently in use for recursive calls to process()
+     *
+     * @param fOp {Function}
+     *   Function to produce the value to save, from the old value and
+     *   operand
+     *
+     * @param operand {Number}
+     *   The new value, or for a unary operator, the size of the increment
+     *
+     * @param size {Number}
+     *   The size of the element assigned. The target address is advanced by
+     *   it, in case we're in an initializer list.
+     *
+     * @param bUnary {Boolean?}
+     *   true if this is a unary operator (pre/post-increment/decrement)
+     *
+     * @param bPostOp {Boolean?}
+     *   true if this is a post-increment or post-decrement operation
+     *
+     * @return {Map}
+     *   A map containing the resulting value and its type
+     *
+     * @throws {playground.c.lib.RuntimeError}
+     *   If the target is constant
+     */
+    __assignStore : function(target, data, fOp, operand, size,
+                             bUnary, bPostOp)
+    {
+      var             specAndDecl;
+      var             type = target.type;
+      var             value = target.value;
+      var             value1 = target.value1;
+
+      // Ensure they're not writing to a constant
+      if (! data.bIsInitializer && 
+          [
+            "constant",
+            "enum_value"
+          ].indexOf(value1.specAndDecl[0].getConstant()) != -1)
+      {
+        // They are! Bad programmer! Bad!
+        if (value1.specAndDecl[0] instanceof playground.c.lib.Specifier)
+        {
+          if (value1.specAndDecl[0].getConstant() == "constant")
+          {
+            throw new playground.c.lib.RuntimeError(
+              this,
+              "Can not alter a const variable.");
+          }
+          else
+          {
+            throw new playground.c.lib.RuntimeError(
+              this,
+              "Can not alter an enum value.");
+          }
+        }
+        else
+        {
+          // They're trying to modify a constant pointer
+          throw new playground.c.lib.RuntimeError(
+            this,
+            "Can not alter an array address or constant pointer");
+        }
+      }
+
+      // If this is a write to a structure or union...
+      if (type == "struct" || type == "union")
+      {
+        // then we want to just return its address. First, clone the
+        // specifier/declarator list.
+        specAndDecl = value1.specAndDecl.slice(0);
+
+        // Prepend an "address" declarator"
+        specAndDecl.unshift(
+          new playground.c.lib.Declarator(this, "address"));
+
+        // Return the address of the struct
+        return (
+          {
+            value       : value1.value,
+            specAndDecl : specAndDecl
+          });
+      }
+
+      // Save the value at its new address
+      playground.c.lib.Node.__mem.set(value1.value, type, fOp(value, operand));
+
+      // If this is not a post-increment or post-decrement...
+      if (! bPostOp)
+      {
+        // ... then retrieve and return the altered value
+        value =
+          playground.c.lib.Node.__mem.get(value1.value, type, target.bUseOld);
+      }
+
+      // If this is a unary operator on a pointer...
+      if (bUnary && value1.specAndDecl[0].getType() == "pointer")
+      {
+        // ... then the result is a pointer to what's pointed to
+        specAndDecl = value1.specAndDecl.slice(1);
+        specAndDecl.unshift(
+          new playground.c.lib.Declarator(this, "pointer"));
+      }
+      else
+      {
+        // Otherwise, clone the specifier/declarator list
+        specAndDecl = value1.specAndDecl.slice(0);
+      }
+
+      // Increment the address by the size of this element, in case
+      // we're in an initializer list.
+      value1.value += size;
+
+      // Retrieve the value and return it
+      return (
+        {
+          value       : value,
+          specAndDecl : specAndDecl
+        });
     },
 
     /**
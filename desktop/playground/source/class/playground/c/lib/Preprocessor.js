@@ -84,9 +84,19 @@ qx.Class.define("playground.c.lib.Preprocessor",
     },
 
     /**
+     * @param text {String}
+     *   The program text to be preprocessed
+     *
+     * @param callback {Function}
+     *   Function to be called with the preprocessed text
+     *
+     * @param bQuiet {Boolean?}
+     *   If true, warnings are discarded rather than displayed, as when the
+     *   program is being preprocessed only to check its syntax.
+     *
      * @ignore(global)
      */
-    preprocess : function(text, callback)
+    preprocess : function(text, callback, bQuiet)
     {
       var             cpp;
       var             preprocessed;
@@ -100,6 +110,10 @@ qx.Class.define("playground.c.lib.Preprocessor",
       // Add the user-provided callback function to the settings
       statics.settings.completion_func = callback;
 
+      // Display warnings, unless asked not to
+      statics.settings.warn_func =
+        bQuiet ? function() {} : playground.c.lib.Preprocessor._output;
+
       // Get an instance of the C preprocessor, with our specified settings
       cpp = statics._init(statics.settings);
       
@@ -243,6 +257,95 @@ qx.Class.define("playground.c.lib.Preprocessor",
           (idx > 1 && text[idx - 2] == '\\'));
       };
 
+      // Split `text` into groups of lines in which macro substitution may be
+      // done independently. A group ends at a newline only when no
+      // parenthesis or string is open there (as the string is determined by
+      // subs()), and the next text is not a parenthesis, which could begin
+      // the arguments of a macro named at the end of the group.
+      var split_independent = function(text)
+      {
+        var segments = [];
+        var start = 0;
+        var depth = 0;
+        var in_string = false;
+        var c;
+        var j = 0;
+
+        for (var i = 0; i < text.length; ++i)
+        {
+          c = text[i];
+          if (is_string_boundary(text, i))
+          {
+            in_string = !in_string;
+          }
+          else if (in_string)
+          {
+            continue;
+          }
+          else if (c == '(')
+          {
+            ++depth;
+          }
+          else if (c == ')')
+          {
+            --depth;
+          }
+          else if (c == '\n' && depth === 0)
+          {
+            // Find the next text, unless already found for a prior newline
+            if (j <= i)
+            {
+              for (j = i + 1; j < text.length && /\s/.test(text[j]); ++j)
+              {
+                // nothing to do
+              }
+            }
+
+            if (j < text.length && text[j] != '(')
+            {
+              segments.push(text.slice(start, i + 1));
+              start = i + 1;
+            }
+          }
+        }
+
+        segments.push(text.slice(start));
+        return segments;
+      };
+
+      // Check if the character code `c` may appear in an identifier (\w)
+      var is_word_char = function(c)
+      {
+        return (c >= 97 && c <= 122) || // a-z
+          (c >= 65 && c <= 90) ||       // A-Z
+          (c >= 48 && c <= 57) ||       // 0-9
+          c == 95;                      // _
+      };
+
+      // Return the identifier beginning at offset `idx` of `text`, or null
+      // if there is none there.
+      var identifier_at = function(text, idx)
+      {
+        var c = text.charCodeAt(idx);
+        var end;
+
+        // An identifier may not begin with a digit
+        if (!is_word_char(c) || (c >= 48 && c <= 57))
+        {
+          return null;
+        }
+
+        for (end = idx + 1; end < text.length; ++end)
+        {
+          if (!is_word_char(text.charCodeAt(end)))
+          {
+            break;
+          }
+        }
+
+        return text.slice(idx, end);
+      };
+
       // dictionary of default settings, including default error handlers
       var default_settings = {
         signal_char: '#',
@@ -302,11 +405,8 @@ qx.Class.define("playground.c.lib.Preprocessor",
       var block_re = new RegExp("^" + settings.signal_char +
         "(\\w+)[ \t]*(.*?)[ \t]*$", "m");
 
-      // match identifiers according to 6.4.2.1, do not match 'defined',
-      // do not match quote strings either
-      var is_identifier_re = /\b(d(?!efined)|[a-ce-zA-Z_])\w*(?![\w"])/g;
-
-      // same, but checks if the entire string is an identifier
+      // check if the entire string is an identifier according to 6.4.2.1,
+      // but not 'defined'
       var is_identifier_only_re = /^(d(?!efined)|[a-ce-zA-Z_])\w*$/g;
 
       // same, but checks if the entire string is a macro
@@ -317,15 +417,55 @@ qx.Class.define("playground.c.lib.Preprocessor",
       var defined_no_parens_re = /defined\s+([a-zA-Z_]\w*)/g;
 
       // defined (<identifier>)
-      var defined_re = /defined\s*\((\s*[a-zA-Z_]\w*\s*)\)/g;
+      var defined_re = /defined\s*\(\s*([a-zA-Z_]\w*)\s*\)/g;
 
       // __defined_magic_<identifier>_ (a special sentinel value used to
       // temporarily exclude operands to defined from macro substitution.
-      var defined_magic_sentinel_re = /__defined_magic_([a-zA-Z_]\w*)_/;
+      var defined_magic_prefix = '__defined_magic_';
+
+      // One token of an #if expression: an integer literal (with any
+      // L,l,U,u suffix), an identifier, a character constant, or an
+      // operator. Any preceding whitespace is skipped.
+      var expr_token_re = new RegExp(
+        "\\s*(?:" +
+          "(0[xX][0-9a-fA-F]+|[0-9]+)[uUlL]*(?![\\w.])|" +
+          "([a-zA-Z_]\\w*)|" +
+          "'((?:[^'\\\\\\n]|\\\\.)+)'|" +
+          "(<<|>>|<=|>=|==|!=|&&|\\|\\||[-+~!*/%<>&^|?:()])" +
+        ")", "g");
+
+      // Precedence of each binary operator in an #if expression
+      var expr_binary_precedence = {
+        '*': 10,
+        '/': 10,
+        '%': 10,
+        '+': 9,
+        '-': 9,
+        '<<': 8,
+        '>>': 8,
+        '<': 7,
+        '<=': 7,
+        '>': 7,
+        '>=': 7,
+        '==': 6,
+        '!=': 6,
+        '&': 5,
+        '^': 4,
+        '|': 3,
+        '&&': 2,
+        '||': 1
+      };
 
-      // Match hexadecimal, octal and decimal integer literals with or
-      // without L,l,U,u suffix and separate all components.
-      var is_integer_re = /\b(\+|-|)(0|0x|)([1-9a-f][0-9a-f]*|0)([ul]*)\b/ig;
+      // Values of the simple escape sequences in character constants
+      var char_escapes = {
+        'n': 10,
+        't': 9,
+        'r': 13,
+        'a': 7,
+        'b': 8,
+        'f': 12,
+        'v': 11
+      };
 
       // Grab doubly quoted strings
       var is_string_re = /"(.*?)"/g;
@@ -385,10 +525,53 @@ qx.Class.define("playground.c.lib.Preprocessor",
       var state = {};
       var macro_cache = {};
 
-      var eval_mask = null;
+      // Parsed #if expressions, keyed by their text after substitution
+      var expr_cache = {};
+
+      // Results of #if expressions, keyed by their original text. Each is
+      // valid only while the macro definitions remain unchanged.
+      var if_cache = {};
+      var state_version = 0;
+
+      // Check if macro `k` is defined. (Not `k in state`, which would also
+      // find inherited properties such as `constructor`.)
+      var is_defined = function(k)
+      {
+        return Object.prototype.hasOwnProperty.call(state, k);
+      };
+
+      // Return the names which might be macros invoked by the identifier
+      // `ident`, longest first: the identifier itself, and then, since a
+      // space or empty sentinel may immediately follow a simple macro's
+      // name (see _subs_simple), each prefix of it that ends at a sentinel.
+      var macro_candidates = function(ident)
+      {
+        var candidates = [ident];
+        var ends = [];
+        var i;
+
+        if (ident.indexOf('__') == -1)
+        {
+          return candidates;
+        }
+
+        [pseudo_token_space, pseudo_token_empty].forEach(function(sentinel)
+        {
+          for (i = ident.indexOf(sentinel, 1); i != -1;
+               i = ident.indexOf(sentinel, i + 1))
+          {
+            ends.push(i);
+          }
+        });
+
+        ends.sort(function(a, b) { return b - a; });
+        for (i = 0; i < ends.length; ++i)
+        {
+          candidates.push(ident.slice(0, ends[i]));
+        }
 
-      var max_macro_length = 0;
-      var macro_counts_by_length = {};
+        return candidates;
+      };
 
       return {
 
@@ -397,16 +580,15 @@ qx.Class.define("playground.c.lib.Preprocessor",
         clear: function()
         {
           state = {};
-          macro_counts_by_length = {};
           macro_cache = {};
-          max_macro_length = 0;
+          ++state_version;
         },
 
         // ----------------------
         // (public) Check if macro `k` is defined.
         defined: function(k)
         {
-          return k in state;
+          return is_defined(k);
         },
 
         // ----------------------
@@ -448,41 +630,18 @@ qx.Class.define("playground.c.lib.Preprocessor",
           }
 
           state[k] = v || '';
-
-          // macro length table housekeeping
-          macro_counts_by_length[k.length] = (macro_counts_by_length[k.length] ||
-            0) + 1;
-          if (k.length > max_macro_length)
-          {
-            max_macro_length = k.length;
-          }
+          ++state_version;
         },
 
         // ----------------------
         // (public) Undefine `k`. A no-op if `k` is not defined.
         undefine: function(k)
         {
-          if (k in state)
+          if (is_defined(k))
           {
             delete state[k];
-
-            // update macro length table
-            var nl = macro_counts_by_length[k.length] - 1;
-            if (k.length === max_macro_length && !nl)
-            {
-              max_macro_length = 0;
-              for (var i = k.length - 1; i >= 0; --i)
-              {
-                if (macro_counts_by_length[i])
-                {
-                  max_macro_length = i;
-                  break;
-                }
-              }
-            }
-
-            macro_counts_by_length[k.length] = nl;
             delete macro_cache[k];
+            ++state_version;
           }
           else
           {
@@ -874,6 +1033,34 @@ var __PRE__ = "";
         // callbacks from settings are used. Users should never assign a value to
         // `nest_sub`, which is used to keep track of recursive invocations internally.
         subs: function(text, blacklist_in, error, warn, nest_sub)
+        {
+          var segments;
+
+          // Each substitution rebuilds the remainder of the text, so
+          // substituting in a large block of lines at once takes time
+          // proportional to the square of its size. At the top level,
+          // substitute in each independent group of lines separately.
+          if (!nest_sub)
+          {
+            segments = split_independent(text);
+            if (segments.length > 1)
+            {
+              for (var i = 0; i < segments.length; ++i)
+              {
+                segments[i] = this._subs_text(segments[i], blacklist_in,
+                  error, warn);
+              }
+
+              return segments.join('');
+            }
+          }
+
+          return this._subs_text(text, blacklist_in, error, warn, nest_sub);
+        },
+
+        // ----------------------
+        // Substitute macros in `text`, as described for subs().
+        _subs_text: function(text, blacklist_in, error, warn, nest_sub)
         {
           error = error || settings.error_func;
           warn = warn || settings.warn_func;
@@ -897,11 +1084,12 @@ var __PRE__ = "";
           var rex = /\b.|["']/g,
             m_boundary;
 
-          // XXX This scales terribly. Possible optimization:
-          //   use KMP for substring searches
+          // Only an identifier can name a macro, so each identifier is
+          // looked up, in its entirety, in the table of defined macros.
           var pieces = [],
             last = 0,
-            in_string = false;
+            in_string = false,
+            candidates;
 
           while (m_boundary = rex.exec(new_text))
           {
@@ -917,15 +1105,17 @@ var __PRE__ = "";
               continue;
             }
 
-            for (var i = Math.min(new_text.length - idx, max_macro_length); i >=
-              1; --i)
+            var ident = identifier_at(new_text, idx);
+            if (!ident)
             {
-              if (!macro_counts_by_length[i])
-              {
-                continue;
-              }
-              var k = new_text.slice(idx, idx + i);
-              if (k in state)
+              continue;
+            }
+
+            candidates = macro_candidates(ident);
+            for (var i = 0; i < candidates.length; ++i)
+            {
+              var k = candidates[i];
+              if (is_defined(k))
               {
 
                 // if this would be a match, but the macro is blacklisted,
@@ -1034,9 +1224,8 @@ var __PRE__ = "";
           other = other._get_state();
 
           state = other.state;
-          macro_counts_by_length = other.macro_counts_by_length;
           macro_cache = other.macro_cache;
-          max_macro_length = other.max_macro_length;
+          ++state_version;
         },
 
         // ----------------------
@@ -1045,9 +1234,7 @@ var __PRE__ = "";
         {
           return {
             state: state,
-            macro_counts_by_length: macro_counts_by_length,
-            macro_cache: macro_cache,
-            max_macro_length: max_macro_length
+            macro_cache: macro_cache
           };
         },
 
@@ -1417,18 +1604,35 @@ var __PRE__ = "";
         _subs_simple: function(text, macro_name, blacklist_in, error, warn,
           nest_sub, start_idx)
         {
-          // no macro but just a parameterless substitution
-          var rex = new RegExp(macro_name + "(\\b|" + pseudo_token_space +
-            "|" + pseudo_token_empty + ")", 'g');
-
-          rex.lastIndex = start_idx || 0;
-          var m_found = rex.exec(text);
-          if (!m_found || m_found.index != start_idx)
+          // no macro but just a parameterless substitution. The name must
+          // end at a word boundary, or be followed by a space or empty
+          // sentinel, which is then also replaced.
+          start_idx = start_idx || 0;
+          var end = start_idx + macro_name.length;
+          if (text.slice(start_idx, end) != macro_name)
           {
             return null;
           }
 
-          return [state[macro_name], m_found[0].length];
+          if (end < text.length && is_word_char(text.charCodeAt(end)))
+          {
+            if (text.substr(end, pseudo_token_space.length) ==
+              pseudo_token_space)
+            {
+              end += pseudo_token_space.length;
+            }
+            else if (text.substr(end, pseudo_token_empty.length) ==
+              pseudo_token_empty)
+            {
+              end += pseudo_token_empty.length;
+            }
+            else
+            {
+              return null;
+            }
+          }
+
+          return [state[macro_name], end - start_idx];
         },
 
         // ----------------------
@@ -1597,72 +1801,340 @@ var __PRE__ = "";
         },
 
         // ----------------------
-        // Execute a sanitized arithmetic expression given by `scr` and return 
-        // the result. This is not intended to be for 'security'. We do trust any
-        // code that we preprocess. However, it would not be desirable if the
-        // JS environment could be accidentially altered from within 
-        // #if's, so let's try to hide eval()'s power as good as we can.
-        /**
-         * @ignore(global)
-         */
-        _masked_eval: function(scr)
+        // Parse the (substituted) #if expression `text` into a tree, whose
+        // nodes are arrays of a node type followed by its operands. Throws
+        // an Error describing any syntax error.
+        _parse_expression: function(text)
         {
-          // based on http://stackoverflow.com/questions/543533/restricting-eval-to-a-narrow-scope
-          if (!eval_mask)
+          var tokens = [];
+          var pos = 0;
+          var m;
+
+          // Split the expression into tokens
+          expr_token_re.lastIndex = 0;
+          while (pos < text.length)
           {
-            // set up an object to serve as the context for the code
-            // being evaluated. 
-            eval_mask = {};
+            m = expr_token_re.exec(text);
+            if (!m || m.index != pos)
+            {
+              if (/^\s*$/.test(text.slice(pos)))
+              {
+                break;
+              }
+              throw new Error("unexpected '" + trim(text.slice(pos))[0] + "'");
+            }
 
-            // mask global properties 
-            var glob = [];
-            try
+            if (m[1] !== undefined)
             {
-              // browser environment, window object present
-              glob = [window,
-                {
-                  window: 1
-                }
-              ];
+              tokens.push(['num', this._parse_integer(m[1])]);
+            }
+            else if (m[2] !== undefined)
+            {
+              tokens.push(['id', m[2]]);
             }
-            catch (e)
+            else if (m[3] !== undefined)
+            {
+              tokens.push(['num', this._parse_char(m[3])]);
+            }
+            else
             {
-              try
+              tokens.push(['op', m[4]]);
+            }
+
+            pos = expr_token_re.lastIndex;
+          }
+
+          // Parse the tokens. From here on, pos is the index of a token.
+          pos = 0;
+
+          var peek = function(op)
+          {
+            return pos < tokens.length && tokens[pos][0] == 'op' &&
+              tokens[pos][1] == op;
+          };
+
+          var expect = function(op)
+          {
+            if (!peek(op))
+            {
+              throw new Error("expected '" + op + "'");
+            }
+            ++pos;
+          };
+
+          var parse_primary = function()
+          {
+            var tok = tokens[pos++];
+            var name;
+
+            if (!tok)
+            {
+              throw new Error("unexpected end of expression");
+            }
+
+            switch (tok[0])
+            {
+            case 'num':
+              return tok;
+
+            case 'id':
+              name = tok[1];
+
+              // defined NAME, or defined(NAME), which may have been
+              // produced by macro substitution
+              if (name == 'defined')
               {
-                // node.js top-level objects present
-                glob = [global,
-                  {
-                    global: 1,
-                    process: 1,
-                    require: 1,
-                    module: 1,
-                    __filename: 1,
-                    __dirname: 1
-                  }
-                ];
+                var parens = peek('(');
+                if (parens)
+                {
+                  ++pos;
+                }
+                tok = tokens[pos++];
+                if (!tok || tok[0] == 'op')
+                {
+                  throw new Error("expected identifier after defined");
+                }
+                if (parens)
+                {
+                  expect(')');
+                }
+
+                // If defined was produced by substitution, its operand may
+                // have been substituted too, so may no longer be a name.
+                return tok[0] == 'id' ? ['defined', tok[1]] : ['num', 0];
               }
-              catch (e2)
-              {}
+
+              // The operand of defined, protected from substitution
+              if (name.indexOf(defined_magic_prefix) === 0 &&
+                name.length > defined_magic_prefix.length + 1 &&
+                name[name.length - 1] == '_')
+              {
+                return ['defined',
+                  name.slice(defined_magic_prefix.length, -1)];
+              }
+
+              // Any other identifier has the value 0 (6.10.1.4)
+              return ['num', 0];
+
+            case 'op':
+              switch (tok[1])
+              {
+              case '(':
+                var expr = parse_conditional();
+                expect(')');
+                return expr;
+
+              case '+':
+              case '-':
+              case '~':
+              case '!':
+                return ['unary', tok[1], parse_primary()];
+              }
+              break;
             }
 
-            for (var i = 0; i < glob.length; ++i)
+            throw new Error("unexpected '" + tok[1] + "'");
+          };
+
+          // Parse binary operators of at least the given precedence
+          var parse_binary = function(min_precedence)
+          {
+            var left = parse_primary();
+            var op;
+            var precedence;
+
+            while (pos < tokens.length && tokens[pos][0] == 'op')
             {
-              for (var p in glob[i])
+              op = tokens[pos][1];
+              precedence = expr_binary_precedence[op];
+              if (!precedence || precedence < min_precedence)
               {
-                eval_mask[p] = undefined;
+                break;
               }
+
+              ++pos;
+              left = ['binary', op, left, parse_binary(precedence + 1)];
+            }
+
+            return left;
+          };
+
+          var parse_conditional = function()
+          {
+            var condition = parse_binary(1);
+            var if_true;
+
+            if (!peek('?'))
+            {
+              return condition;
             }
 
-            // bring defined() function into scope
-            eval_mask.defined = this.defined;
+            ++pos;
+            if_true = parse_conditional();
+            expect(':');
+            return ['cond', condition, if_true, parse_conditional()];
+          };
+
+          var tree = parse_conditional();
+          if (pos < tokens.length)
+          {
+            throw new Error("unexpected '" + tokens[pos][1] + "'");
           }
 
-          eval_mask.__result__ = false;
+          return tree;
+        },
 
-          // execute script in private context
-          (new Function("with(this) { __result__ = (" + scr + "); }")).call(
-            eval_mask);
-          return eval_mask.__result__;
+        // ----------------------
+        // Return the value of the integer literal `text` (6.4.4.1)
+        _parse_integer: function(text)
+        {
+          if (/^0[xX]/.test(text))
+          {
+            return parseInt(text.slice(2), 16);
+          }
+
+          if (text[0] == '0' && text.length > 1)
+          {
+            if (/[89]/.test(text))
+            {
+              throw new Error("invalid octal constant " + text);
+            }
+            return parseInt(text, 8);
+          }
+
+          return parseInt(text, 10);
+        },
+
+        // ----------------------
+        // Return the value of the character constant whose characters (within
+        // the quotes) are `text` (6.4.4.4). Only the first character of a
+        // multi-character constant is used.
+        _parse_char: function(text)
+        {
+          var m;
+
+          if (text[0] != '\\')
+          {
+            return text.charCodeAt(0);
+          }
+
+          if ((m = /^\\([0-7]{1,3})/.exec(text)))
+          {
+            return parseInt(m[1], 8);
+          }
+
+          if ((m = /^\\x([0-9a-fA-F]+)/.exec(text)))
+          {
+            return parseInt(m[1], 16);
+          }
+
+          if (text[1] in char_escapes)
+          {
+            return char_escapes[text[1]];
+          }
+
+          // \\, \', \", \?
+          return text.charCodeAt(1);
+        },
+
+        // ----------------------
+        // Evaluate an expression tree produced by _parse_expression(). The
+        // operands of &&, ||, and ?: are evaluated only as needed. Throws an
+        // Error upon division by zero.
+        _evaluate: function(tree)
+        {
+          var a;
+          var b;
+
+          switch (tree[0])
+          {
+          case 'num':
+            return tree[1];
+
+          case 'defined':
+            return is_defined(tree[1]) ? 1 : 0;
+
+          case 'unary':
+            a = this._evaluate(tree[2]);
+            switch (tree[1])
+            {
+            case '+':
+              return a;
+            case '-':
+              return -a;
+            case '~':
+              return ~a;
+            case '!':
+              return a ? 0 : 1;
+            }
+            break;
+
+          case 'cond':
+            return this._evaluate(tree[1]) ?
+              this._evaluate(tree[2]) : this._evaluate(tree[3]);
+
+          case 'binary':
+            a = this._evaluate(tree[2]);
+
+            // Short-circuit operators
+            if (tree[1] == '&&')
+            {
+              return a && this._evaluate(tree[3]) ? 1 : 0;
+            }
+            if (tree[1] == '||')
+            {
+              return a || this._evaluate(tree[3]) ? 1 : 0;
+            }
+
+            b = this._evaluate(tree[3]);
+            switch (tree[1])
+            {
+            case '*':
+              return a * b;
+            case '/':
+            case '%':
+              if (b === 0)
+              {
+                throw new Error("division by zero");
+              }
+              if (tree[1] == '%')
+              {
+                return a % b;
+              }
+              // Integer division truncates toward zero
+              a = a / b;
+              return a < 0 ? Math.ceil(a) : Math.floor(a);
+            case '+':
+              return a + b;
+            case '-':
+              return a - b;
+            case '<<':
+              return a << b;
+            case '>>':
+              return a >> b;
+            case '<':
+              return a < b ? 1 : 0;
+            case '<=':
+              return a <= b ? 1 : 0;
+            case '>':
+              return a > b ? 1 : 0;
+            case '>=':
+              return a >= b ? 1 : 0;
+            case '==':
+              return a == b ? 1 : 0;
+            case '!=':
+              return a != b ? 1 : 0;
+            case '&':
+              return a & b;
+            case '^':
+              return a ^ b;
+            case '|':
+              return a | b;
+            }
+            break;
+          }
+
+          throw new Error("internal error: bad expression node " + tree[0]);
         },
 
         // ----------------------
@@ -1671,6 +2143,17 @@ var __PRE__ = "";
         _eval: function(val, error, warn)
         {
           var old_val = val;
+          var tree;
+          var res;
+
+          // The result can't change unless the macro definitions have
+          var cached = if_cache.hasOwnProperty(old_val) ? if_cache[old_val]
+                                                         : null;
+          if (cached && cached.version == state_version)
+          {
+            return cached.result;
+          }
+
           // see 6.10.1.2-3
 
           // string literals are not allowed 
@@ -1685,48 +2168,40 @@ var __PRE__ = "";
             error('assignment operator not allowed in if expression');
           }
 
-          // same for increment/decrement - we need to catch these
-          // cases because they might be used to exploit eval().
+          // same for increment/decrement
           if (val.match(is_increment_re))
           {
             error('--/++ operators not allowed in if expression');
           }
 
-          // XXX handle character constants
-
-          // drop the L,l,U,u suffixes for integer literals
-          val = val.replace(is_integer_re, '$1$2$3');
-
           // macro substitution - but do not touch unary operands to 'defined',
           // this is done by substituting a safe sentinel value (which starts
           // with two underscores and is thus reserved).
           val = val.replace(defined_no_parens_re, 'defined($1)');
-          val = val.replace(defined_re, ' __defined_magic_$1_ ');
+          val = val.replace(defined_re, ' ' + defined_magic_prefix + '$1_ ');
 
           val = this.subs(val,
             {}, error, warn);
 
-          // re-substitute defined() terms and quote the argument
-          val = val.replace(defined_magic_sentinel_re, 'defined("$1")');
-
-          // replace all remaining identifiers with '0'
-          val = val.replace(is_identifier_re, ' 0 ');
-
-          // what remains _should_ be safe to use with eval() since
-          // it doesn't contain any identifiers and is thus not able
-          // to invoke global functions. This version of eval is
-          // even a bit safer and masks all global functions so 
-          // anything we missed should eventually get caught.
-          // See _masked_eval() for the details.
+          // Parse the expression (or reuse a prior parse of the same text),
+          // and evaluate it. Remaining identifiers have the value 0, and
+          // defined() operands are looked up as the expression is evaluated.
           try
           {
-            var res = !! this._masked_eval(val);
+            tree = expr_cache.hasOwnProperty(val) ? expr_cache[val] : null;
+            if (!tree)
+            {
+              tree = expr_cache[val] = this._parse_expression(val);
+            }
+
+            res = !! this._evaluate(tree);
           }
           catch (e)
           {
-            error("error in expression: " + old_val + " (" + e + ")");
+            error("error in expression: " + old_val + " (" + e.message + ")");
           }
 
+          if_cache[old_val] = { version: state_version, result: res };
           return res;
         }
       };
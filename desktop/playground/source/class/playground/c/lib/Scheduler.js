@@ -0,0 +1,232 @@
+/**
+ * Time-sliced scheduling of the continuation-passing interpreter
+ *
+ * Copyright (c) 2013 Derrell Lipman
+ *
+ * License:
+ *   GPL Version 2: http://www.gnu.org/licenses/gpl-2.0.html
+ */
+
+/*
+@ignore(require)
+@ignore(qx.bConsole)
+@ignore(setImmediate)
+@ignore(MessageChannel)
+@ignore(Promise)
+@ignore(performance)
+ */
+
+/**
+ * @ignore(require)
+ * @ignore(qx.bConsole)
+ */
+if (typeof qx === "undefined" || qx.bConsole)
+{
+  qx = require("qooxdoo");
+  qx.bConsole = true;
+}
+
+/**
+ * The interpreter must periodically unwind the JavaScript stack, which
+ * grows with each node processed in continuation-passing style. It formerly
+ * did so with a zero-length timeout every few node visits, but browsers
+ * clamp such timeouts to a minimum of several milliseconds, which dominated
+ * the run time of long loops.
+ *
+ * The stack is now unwound via a microtask, which is not clamped, for as
+ * long as the current time slice has not exceeded its budget. Only once the
+ * budget is exhausted do we yield to the browser (or to Node's event loop),
+ * via a MessageChannel or setImmediate, so that the user interface remains
+ * responsive.
+ */
+qx.Class.define("playground.c.lib.Scheduler",
+{
+  type : "static",
+
+  statics :
+  {
+    /** Number of milliseconds to execute before yielding to the browser */
+    budget : 10,
+
+    /** Time at which the current slice began */
+    __sliceStart : 0,
+
+    /** Time at which we last yielded */
+    __yieldStart : 0,
+
+    /** Channel used for yielding, in the browser */
+    __channel : null,
+
+    /** Functions awaiting a message on the channel */
+    __channelQueue : null,
+
+    /** Statistics gathered since the last reset() */
+    __stats : null,
+
+    /**
+     * Reset the statistics and begin a new time slice. This is called when
+     * a program begins running.
+     */
+    reset : function()
+    {
+      var             Scheduler = playground.c.lib.Scheduler;
+
+      Scheduler.__stats =
+        {
+          slices     : 1,
+          unwinds    : 0,
+          nodes      : 0,
+          yields     : 0,
+          yieldTime  : 0,
+          maxYield   : 0
+        };
+
+      Scheduler.__sliceStart = Scheduler.__now();
+    },
+
+    /**
+     * Unwind the stack, and then call the given function to continue
+     * processing. If the current slice's budget is exhausted, we first
+     * yield to the browser.
+     *
+     * @param f {Function}
+     *   The function to call to continue processing
+     *
+     * @param nodes {Integer}
+     *   The number of node visits since the previous unwind
+     */
+    continueLater : function(f, nodes)
+    {
+      var             now;
+      var             stats;
+      var             Scheduler = playground.c.lib.Scheduler;
+
+      // Ensure we've been initialized
+      if (! Scheduler.__stats)
+      {
+        Scheduler.reset();
+      }
+
+      stats = Scheduler.__stats;
+      ++stats.unwinds;
+      stats.nodes += nodes;
+
+      // Is there still time remaining in this slice?
+      now = Scheduler.__now();
+      if (now - Scheduler.__sliceStart < Scheduler.budget &&
+          typeof Promise != "undefined")
+      {
+        // Yup. Just unwind the stack, without yielding.
+        Promise.resolve().then(f);
+        return;
+      }
+
+      // The budget is exhausted. Yield, and begin a new slice upon return.
+      ++stats.yields;
+      Scheduler.__yieldStart = now;
+      Scheduler.__yield(
+        function()
+        {
+          var             latency;
+
+          // Determine how long we were away
+          Scheduler.__sliceStart = Scheduler.__now();
+          latency = Scheduler.__sliceStart - Scheduler.__yieldStart;
+          stats.yieldTime += latency;
+          if (latency > stats.maxYield)
+          {
+            stats.maxYield = latency;
+          }
+
+          // This begins a new slice
+          ++stats.slices;
+
+          f();
+        });
+    },
+
+    /**
+     * Retrieve the scheduling statistics for the current (or most recent)
+     * program run.
+     *
+     * @return {Map}
+     *   A map containing the number of time slices, node visits, nodes per
+     *   slice, stack unwinds, and yields, and the average and maximum
+     *   latency (in milliseconds) between yielding and being resumed.
+     */
+    getStatistics : function()
+    {
+      var             stats = playground.c.lib.Scheduler.__stats;
+
+      if (! stats)
+      {
+        return null;
+      }
+
+      return (
+        {
+          slices          : stats.slices,
+          nodes           : stats.nodes,
+          nodesPerSlice   : stats.nodes / stats.slices,
+          unwinds         : stats.unwinds,
+          yields          : stats.yields,
+          avgYieldLatency : stats.yields ? stats.yieldTime / stats.yields : 0,
+          maxYieldLatency : stats.maxYield
+        });
+    },
+
+    /**
+     * Get the current time, in milliseconds, with the best available
+     * resolution.
+     */
+    __now : function()
+    {
+      if (typeof performance != "undefined" && performance.now)
+      {
+        return performance.now();
+      }
+
+      return new Date().getTime();
+    },
+
+    /**
+     * Call a function after yielding to the event loop, without incurring
+     * the minimum delay imposed upon timeouts.
+     *
+     * @param f {Function}
+     *   The function to be called
+     */
+    __yield : function(f)
+    {
+      var             Scheduler = playground.c.lib.Scheduler;
+
+      // Under Node, setImmediate does exactly what we want
+      if (typeof setImmediate == "function")
+      {
+        setImmediate(f);
+        return;
+      }
+
+      // In the browser, post a message to ourself
+      if (typeof MessageChannel != "undefined")
+      {
+        if (! Scheduler.__channel)
+        {
+          Scheduler.__channelQueue = [];
+          Scheduler.__channel = new MessageChannel();
+          Scheduler.__channel.port1.onmessage = function()
+          {
+            Scheduler.__channelQueue.shift()();
+          };
+        }
+
+        Scheduler.__channelQueue.push(f);
+        Scheduler.__channel.port2.postMessage(0);
+        return;
+      }
+
+      // Otherwise, fall back to a timeout
+      window.setTimeout(f, 0);
+    }
+  }
+});
@@ -262,6 +262,48 @@ qx.Class.define("playground.c.lib.Symtab",
       return fp;
     },
 
+    /**
+     * Add the symbol information for each symbol table on the stack to
+     * Memory's record. This is used when the memory template view has been
+     * detached, so symbol information was not added by setFramePointer().
+     */
+    restoreSymbolInfo : function()
+    {
+      var             i;
+      var             j;
+      var             depth;
+      var             symtab;
+      var             stack = playground.c.lib.Symtab._symtabStack;
+
+      for (i = 0; i < stack.length; i++)
+      {
+        symtab = stack[i];
+
+        // The root symbol table's symbols are added when the program begins
+        if (! symtab.getParent())
+        {
+          continue;
+        }
+
+        // A symbol table appears on the stack more than once during
+        // recursion. Its frame pointers are stacked with the most recent
+        // first, so find the one for this instance.
+        for (depth = 0, j = i + 1; j < stack.length; j++)
+        {
+          if (stack[j] === symtab)
+          {
+            ++depth;
+          }
+        }
+
+        // Temporarily make that the current frame pointer, so that symbol
+        // addresses are calculated relative to it
+        symtab.__framePointer.unshift(symtab.__framePointer[depth]);
+        symtab.__addFrameSymbols();
+        symtab.__framePointer.shift();
+      }
+    },
+
     /**
      * Push a symbol table onto the stack
      */
@@ -583,11 +625,29 @@ qx.Class.define("playground.c.lib.Symtab",
      */
     setFramePointer : function(fp)
     {
-      var             memory;
-      
       // Push the new frame pointer onto the stack
       this.__framePointer.unshift(fp);
       
+      // If the memory template view is detached, symbol information is
+      // added only upon demand, via restoreSymbolInfo().
+      if (playground.c.machine.Memory.getInstance().isViewDetached())
+      {
+        return;
+      }
+
+      // Add each symbol to memory's record, for later display
+      this.__addFrameSymbols();
+    },
+
+    /**
+     * Add the information for each symbol in this symbol table, at its
+     * address relative to the current frame pointer, to Memory's record,
+     * for later display
+     */
+    __addFrameSymbols : function()
+    {
+      var             memory;
+      
       // Get a reference to the Memory singleton
       memory = playground.c.machine.Memory.getInstance();
 
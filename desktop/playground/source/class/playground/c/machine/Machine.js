@@ -1,6 +1,13 @@
 /**
  * The virtual machine, and facilities for executing instructions thereon
  *
+ * No code generator targets this machine yet. C programs are instead run
+ * by the closures built by playground.c.lib.Node.compile(). Before a
+ * generator could emit instructions for it, the machine needs:
+ *   - instruction fetch from the program region (Memory.get() rejects it)
+ *   - frame-relative and indirect addressing, for locals and pointers
+ *   - a program region larger than 1KB
+ *
  * Copyright (c) 2013 Derrell Lipman
  * 
  * License:
@@ -10,6 +10,7 @@
 /*
 @ignore(require)
 @ignore(ArrayBuffer)
+@ignore(SharedArrayBuffer)
 @ignore(Int8Array)
 @ignore(Int16Array)
 @ignore(Int32Array)
@@ -54,6 +55,13 @@ qx.Class.define("playground.c.machine.Memory",
   {
     /** The array buffer containing the bytes of the machine's memory */
     _memory : null,
+
+    /**
+     * Whether memory is to be allocated in a SharedArrayBuffer, so that
+     * another thread (the user interface, when running in a Web Worker) may
+     * read it directly
+     */
+    bShared : false,
     
     /** The number of registers */
     NUM_REGS : 6,
@@ -88,6 +96,71 @@ qx.Class.define("playground.c.machine.Memory",
       "enum"               : 4
     },
 
+    /**
+     * Map of C types (and their aliases) to integer type codes. These are
+     * the same codes used in instructions. (See
+     * playground.c.machine.Instruction.)
+     */
+    typeCode :
+    {
+      "char"               : 0x00,
+      "signed char"        : 0x00,
+      "unsigned char"      : 0x01,
+      "uchar"              : 0x01,
+      "short"              : 0x02,
+      "signed short"       : 0x02,
+      "unsigned short"     : 0x03,
+      "ushort"             : 0x03,
+      "int"                : 0x04,
+      "signed int"         : 0x04,
+      "enum"               : 0x04,
+      "unsigned int"       : 0x05,
+      "uint"               : 0x05,
+      "long"               : 0x06,
+      "signed long"        : 0x06,
+      "unsigned long"      : 0x07,
+      "ulong"              : 0x07,
+      "null"               : 0x07,
+      "long long"          : 0x08,
+      "llong"              : 0x08,
+      "signed long long"   : 0x08,
+      "unsigned long long" : 0x09,
+      "ullong"             : 0x09,
+      "float"              : 0x0A,
+      "double"             : 0x0B,
+      "pointer"            : 0x0C
+    },
+
+    /** Size of a value of each type, indexed by type code */
+    typeCodeSize : [ 1, 1, 2, 2, 4, 4, 4, 4, 4, 4, 4, 4, 2 ],
+
+    /** Log base 2 of the size of each type, indexed by type code */
+    __typeCodeShift : [ 0, 0, 1, 1, 2, 2, 2, 2, 2, 2, 2, 2, 1 ],
+
+    /** The C type of each type code, for messages */
+    __typeCodeName :
+    [
+      "char",
+      "unsigned char",
+      "short",
+      "unsigned short",
+      "int",
+      "unsigned int",
+      "long",
+      "unsigned long",
+      "long long",
+      "unsigned long long",
+      "float",
+      "double",
+      "pointer"
+    ],
+
+    /**
+     * Granularity of the region table, as a power of two. All regions
+     * accessible via get() and set() begin and end on a multiple of this.
+     */
+    __REGION_PAGE_SHIFT : 10,
+
     /** Ranges of memory */
     info :
     {
@@ -160,6 +233,30 @@ qx.Class.define("playground.c.machine.Memory",
       "R3"  : null
     },
     
+    /**
+     * Symbol information used to label return addresses on the stack, in
+     * the memory template view
+     */
+    returnAddressSymbol :
+    {
+      getName         : function() { return "return to line #"; },
+      getType         : function() { return "int"; },
+      getUnsigned     : function() { return false; },
+      getSize         : function()
+      {
+        return playground.c.machine.Memory.typeSize["int"];
+      },
+      getPointerCount : function() { return 0; },
+      getArraySizes   : function() { return []; },
+      getIsParameter  : function() { return false; }
+    },
+
+    /**
+     * Bitmap indicating bytes of memory that have been initialized. Bit
+     * (addr & 31) of element (addr >> 5) represents the byte at addr.
+     */
+    _memInitialized : null,
+
     virginize : function()
     {
       var             statics = playground.c.machine.Memory;
@@ -170,7 +267,9 @@ qx.Class.define("playground.c.machine.Memory",
         statics.info.rts.start + statics.info.rts.length;
       
       // all memory is uninitialized
-      statics._memInitialized = [];
+      statics._memInitialized =
+        new Uint32Array(
+          Math.ceil((statics.info.rts.start + statics.info.rts.length) / 32));
     },
 
     initRegs : function()
@@ -192,8 +291,65 @@ qx.Class.define("playground.c.machine.Memory",
     __memSize : 0,
     __activationRecordsBegin : null,
 
-    /** Array indicating bytes of memory that have been initialized */
-    _memInitialized : null,
+    /** Symbol information, indexed by address, for globals and statics */
+    __globalSymbolInfo : null,
+
+    /** Symbol information, indexed by address, for heap allocations */
+    __heapSymbolInfo : null,
+
+    /**
+     * Whether the memory template view is detached, i.e., not displayed. In
+     * that case, symbol information for each stack frame is not maintained
+     * as the program runs, but is instead reconstructed, upon demand, by
+     * restoreSymbolInfo().
+     */
+    __bViewDetached : false,
+
+    /** Views into memory for each type, indexed by type code */
+    __views : null,
+
+    /**
+     * Region of memory (1-relative index into __regionEnd; 0 for none)
+     * accessible via get() and set(), indexed by page of memory
+     */
+    __pageRegion : null,
+
+    /** End address (exclusive) of each region in __pageRegion */
+    __regionEnd : null,
+
+    /** Addresses of words modified since the data model was last updated */
+    __dirtyWords : null,
+
+    /** Flag, indexed by word number, indicating that a word is dirty */
+    __bDirtyWord : null,
+
+    /**
+     * Incremented upon any change to symbol information or activation
+     * records, i.e., upon changes which alter the structure of the data model
+     */
+    __modelGeneration : 0,
+
+    /** Structure of memory at the time the data model was last created */
+    __modelSignature : null,
+
+    /**
+     * Information, indexed by address, about each word in the data model
+     * when it was last created: its row index, and the type, size, and
+     * number of elements of the values displayed in it.
+     */
+    __modelRows : null,
+
+    /**
+     * Model generation of the memory from which the most recently loaded
+     * snapshot was taken
+     */
+    __snapshotGeneration : null,
+
+    /**
+     * If the most recently loaded snapshot was of shared memory, which
+     * continues to change, a copy of its words as of when it was loaded
+     */
+    __snapshotWords : null,
 
 
     /**
@@ -222,7 +378,14 @@ qx.Class.define("playground.c.machine.Memory",
      * Initialize the memory module.
      *
      * @ignore(ArrayBuffer)
+     * @ignore(SharedArrayBuffer)
+     * @ignore(Int8Array)
+     * @ignore(Int16Array)
+     * @ignore(Int32Array)
      * @ignore(Uint8Array)
+     * @ignore(Uint16Array)
+     * @ignore(Uint32Array)
+     * @ignore(Float32Array)
      */
     initAll : function()
     {
@@ -236,7 +399,9 @@ qx.Class.define("playground.c.machine.Memory",
         playground.c.machine.Memory.info.rts.length;
 
       // Our simulated machine's memory
-      this._memory = new ArrayBuffer(this.__memSize);
+      this._memory = (playground.c.machine.Memory.bShared
+                      ? new SharedArrayBuffer(this.__memSize)
+                      : new ArrayBuffer(this.__memSize));
 
       // Access the memory array as unsigned chars (octets)
       uint8Arr = new Uint8Array(this._memory);
@@ -247,16 +412,34 @@ qx.Class.define("playground.c.machine.Memory",
     //    uint8Arr[i] = Math.floor(Math.random() * 256);
         uint8Arr[i] = 0x5a;
       }
+
+      // Create a view of all of memory for each type
+      this.__createViews();
+
+      // Build the table of regions accessible via get() and set()
+      this.__initRegionTable([ "defs", "gas", "heap", "rts" ]);
       
-      // Initialize symbol information
-      this._symbolInfo = {};
+      // Initialize symbol information. Symbol information for the stack
+      // is kept with each activation record.
+      this.__globalSymbolInfo = {};
+      this.__heapSymbolInfo = {};
+
+      // Nothing has yet been modified, and there is no data model
+      this.__dirtyWords = [];
+      this.__bDirtyWord =
+        new Uint8Array(this.__memSize / playground.c.machine.Memory.WORDSIZE);
+      this.__modelRows = null;
+      this.__snapshotGeneration = null;
+      this.__snapshotWords = null;
+      ++this.__modelGeneration;
       
       // Initialize the activation record array for command line arguments
       this.__activationRecordsBegin =
         [
           {
-            addr : info.rts.start  + info.rts.length,
-            name : "Stack: Command line arguments"
+            addr       : info.rts.start  + info.rts.length,
+            name       : "Stack: Command line arguments",
+            symbolInfo : {}
           }
         ];
       
@@ -267,6 +450,210 @@ qx.Class.define("playground.c.machine.Memory",
       playground.c.machine.Memory.initRegs();
     },
 
+    /**
+     * Create a view of all of memory for each type, indexed by type code,
+     * so that no view need be created upon each access.
+     *
+     * @ignore(Int8Array)
+     * @ignore(Int16Array)
+     * @ignore(Int32Array)
+     * @ignore(Uint8Array)
+     * @ignore(Uint16Array)
+     * @ignore(Uint32Array)
+     * @ignore(Float32Array)
+     */
+    __createViews : function()
+    {
+      this.__views =
+        [
+          new Int8Array(this._memory),    // char
+          new Uint8Array(this._memory),   // unsigned char
+          new Int16Array(this._memory),   // short
+          new Uint16Array(this._memory),  // unsigned short
+          new Int32Array(this._memory),   // int
+          new Uint32Array(this._memory),  // unsigned int
+          new Int32Array(this._memory),   // long
+          new Uint32Array(this._memory),  // unsigned long
+          new Int32Array(this._memory),   // long long
+          new Uint32Array(this._memory),  // unsigned long long
+          new Float32Array(this._memory), // float
+          new Float32Array(this._memory), // double
+          new Uint16Array(this._memory)   // pointer
+        ];
+    },
+
+    /**
+     * Build the table, indexed by page of memory, of the regions of memory
+     * which may be accessed. The regions must begin and end on a page
+     * boundary.
+     *
+     * @param regions {Array}
+     *   The names of the regions (from Memory.info) which may be accessed
+     */
+    __initRegionTable : function(regions)
+    {
+      var             page;
+      var             start;
+      var             end;
+      var             info = playground.c.machine.Memory.info;
+      var             shift = playground.c.machine.Memory.__REGION_PAGE_SHIFT;
+
+      this.__pageRegion = new Uint8Array(this.__memSize >> shift);
+      this.__regionEnd = [ 0 ];
+
+      regions.forEach(
+        function(region, i)
+        {
+          start = info[region].start;
+          end = start + info[region].length;
+
+          // Ensure the region is page-aligned
+          if (((start >> shift) << shift) != start ||
+              ((end >> shift) << shift) != end)
+          {
+            throw new Error("Programmer error: region " + region +
+                            " is not aligned on a page boundary");
+          }
+
+          // Identify each of this region's pages
+          for (page = start >> shift; page < end >> shift; page++)
+          {
+            this.__pageRegion[page] = i + 1;
+          }
+
+          // Save the region's end address
+          this.__regionEnd.push(end);
+        },
+        this);
+    },
+
+    /**
+     * Determine the region of memory, accessible via get() and set(), in
+     * which an address lies.
+     *
+     * @param addr {Number}
+     *   The address
+     *
+     * @return {Number}
+     *   The region (an index into __regionEnd), or 0 if the address is not
+     *   within an accessible region.
+     */
+    __getRegion : function(addr)
+    {
+      if (! (addr >= 0 && addr < this.__memSize))
+      {
+        return 0;
+      }
+
+      return this.__pageRegion[
+        addr >> playground.c.machine.Memory.__REGION_PAGE_SHIFT];
+    },
+
+    /**
+     * Convert a type to its type code
+     *
+     * @param type {String|Number}
+     *   One of the C data types, or "pointer", or a type code
+     *
+     * @return {Number}
+     *   The type code corresponding to the given type
+     */
+    __getTypeCode : function(type)
+    {
+      var             code;
+
+      code = (typeof type == "number"
+              ? type
+              : playground.c.machine.Memory.typeCode[type]);
+
+      if (typeof code == "undefined" || 
+          ! playground.c.machine.Memory.typeCodeSize[code])
+      {
+        throw new Error("Unrecognized destination type: " + type);
+      }
+
+      return code;
+    },
+
+    /**
+     * Throw an error indicating an access of a multi-byte type at an
+     * address not suitably aligned for that type, or outside of memory.
+     *
+     * @param type {String|Number}
+     *   The type being accessed
+     *
+     * @param addr {Number}
+     *   The address being accessed
+     */
+    __busError : function(type, addr)
+    {
+      if (typeof type == "number")
+      {
+        type = playground.c.machine.Memory.__typeCodeName[type];
+      }
+
+      throw new playground.c.lib.RuntimeError(
+        playground.c.lib.Node._currentNode,
+        "Invalid memory access at " +
+          (this.__getBase() == 16 ? "0x" : "") +
+          addr.toString(this.__getBase()) + 
+          ": " +
+          "\n  Can not access type '" + type + "' at this address. " +
+          "\n  (This is sometimes called a 'Bus Error'.)");
+    },
+
+    /**
+     * Read a typed value from memory, without any checks other than for
+     * alignment.
+     *
+     * @param code {Number}
+     *   The type code of the value
+     *
+     * @param addr {Number}
+     *   The address from which to read the value
+     *
+     * @return {Number}
+     *   The value read from memory
+     */
+    _read : function(code, addr)
+    {
+      var             size = playground.c.machine.Memory.typeCodeSize[code];
+
+      if ((addr & (size - 1)) !== 0 || addr < 0 || addr + size > this.__memSize)
+      {
+        this.__busError(code, addr);
+      }
+
+      return this.__views[code][
+        addr >> playground.c.machine.Memory.__typeCodeShift[code]];
+    },
+
+    /**
+     * Write a typed value to memory, without any checks other than for
+     * alignment.
+     *
+     * @param code {Number}
+     *   The type code of the value
+     *
+     * @param addr {Number}
+     *   The address to which to write the value
+     *
+     * @param value {Number}
+     *   The value to be written
+     */
+    _write : function(code, addr, value)
+    {
+      var             size = playground.c.machine.Memory.typeCodeSize[code];
+
+      if ((addr & (size - 1)) !== 0 || addr < 0 || addr + size > this.__memSize)
+      {
+        this.__busError(code, addr);
+      }
+
+      this.__views[code][
+        addr >> playground.c.machine.Memory.__typeCodeShift[code]] = value;
+    },
+
     /**
      * Retrieve an accessor to typed value from memory
      *
@@ -294,106 +681,30 @@ qx.Class.define("playground.c.machine.Memory",
      */
     _getByType : function(type, addr, numElem)
     {
-      var             base = 
+      var             code;
+      var             index;
+      var             size;
 
       // If the number of elements was not specified, retrieve one element.
       numElem = numElem || 1;
 
-      try
-      {
-        switch(type)
-        {
-        case 0x00 :
-        case "char" :
-        case "signed char" :
-          return new Int8Array(this._memory, addr, numElem);
-
-        case 0x01 :
-        case "unsigned char" :
-        case "uchar" :
-          return new Uint8Array(this._memory, addr, numElem);
-
-        case 0x02 :
-        case "short" :
-        case "signed short" :
-          return new Int16Array(this._memory, addr, numElem);
-
-        case 0x03 :
-        case "unsigned short" :
-        case "ushort" :
-          return new Uint16Array(this._memory, addr, numElem);
-
-        case 0x04 :
-        case "int" :
-        case "signed int" :
-        case "enum" :
-          return new Int32Array(this._memory, addr, numElem);
-
-        case 0x05 :
-        case "unsigned int" :
-        case "uint" :
-          return new Uint32Array(this._memory, addr, numElem);
-
-        case 0x06 :
-        case "long" :
-        case "signed long" :
-          return new Int32Array(this._memory, addr, numElem);
-
-        case 0x07 :
-        case "unsigned long" :
-        case "ulong" :
-        case "null" :
-          return new Uint32Array(this._memory, addr, numElem);
-
-        case 0x08 :
-        case "long long" :
-        case "llong" :
-        case "signed long long" :
-          return new Int32Array(this._memory, addr, numElem);
-
-        case 0x09 :
-        case "unsigned long long" :
-        case "ullong" :
-          return new Uint32Array(this._memory, addr, numElem);
-
-        case 0x0A :
-        case "float" :
-          return new Float32Array(this._memory, addr, numElem);
-
-        case 0x0B :
-        case "double" :
-          return new Float32Array(this._memory, addr, numElem);
-
-        case 0x0C :
-        case "pointer" :
-          return new Uint16Array(this._memory, addr, numElem);
-
-        default:
-          throw new Error("Unrecognized destination type: " + type);
-        }
-      }
-      catch(e)
+      // Convert the type to a type code, and get the size of that type
+      code = this.__getTypeCode(type);
+      size = playground.c.machine.Memory.typeCodeSize[code];
+
+      // Ensure that the access is properly aligned and within memory
+      if ((addr & (size - 1)) !== 0 ||
+          addr < 0 ||
+          addr + size * numElem > this.__memSize)
       {
-        // Was a RangeError thrown?
-        if (e instanceof RangeError)
-        {
-          // Yup. That was almost certainly a request for 2 or more bytes on
-          // an odd byte boundary.
-          throw new playground.c.lib.RuntimeError(
-            playground.c.lib.Node._currentNode,
-            "Invalid memory access at " +
-              (this.__getBase() == 16 ? "0x" : "") +
-              addr.toString(this.__getBase()) + 
-              ": " +
-              "\n  Can not access type '" + type + "' at this address. " +
-              "\n  (This is sometimes called a 'Bus Error'.)");
-        }
-        else
-        {
-          // rethrow the error
-          throw e;
-        }
+        // That was almost certainly a request for 2 or more bytes on an odd
+        // byte boundary.
+        this.__busError(type, addr);
       }
+
+      // Return the requested portion of the view for this type
+      index = addr >> playground.c.machine.Memory.__typeCodeShift[code];
+      return this.__views[code].subarray(index, index + numElem);
     },
 
     /**
@@ -416,11 +727,12 @@ qx.Class.define("playground.c.machine.Memory",
     get : function(addr, type, bRequireInitialized)
     {
       var             i;
+      var             code;
       var             size;
+      var             region;
       var             hint;
       var             addrMessage;
       var             symtabInfo;
-      var             info = playground.c.machine.Memory.info;
 
       // If we've been asked not to abort on uninitialized memory...
       if (! playground.c.lib.Preprocessor.pragma.debugFlags.uninitializedMemory)
@@ -429,8 +741,9 @@ qx.Class.define("playground.c.machine.Memory",
         bRequireInitialized = false;
       }
 
-      // Determine size to be accessed
-      size = playground.c.machine.Memory.typeSize[type];
+      // Determine the type code, and the size to be accessed
+      code = this.__getTypeCode(type);
+      size = playground.c.machine.Memory.typeCodeSize[code];
 
       // See if they're trying to access a function address
       if (addr instanceof playground.c.lib.Node)
@@ -453,15 +766,11 @@ qx.Class.define("playground.c.machine.Memory",
           "a value.");
       }
 
+      // Determine which region of memory is being accessed
+      region = this.__getRegion(addr);
+
       // Ensure we are accessing a valid region of memory
-      if (! ((addr >= info.defs.start && 
-              addr < info.defs.start + info.defs.length) ||
-             (addr >= info.gas.start && 
-              addr < info.gas.start + info.gas.length) ||
-             (addr >= info.heap.start && 
-              addr < info.heap.start + info.heap.length) ||
-             (addr >= info.rts.start &&
-              addr < info.rts.start  + info.rts.length)))
+      if (! region)
       {
         throw new playground.c.lib.RuntimeError(
           playground.c.lib.Node._currentNode,
@@ -475,21 +784,7 @@ qx.Class.define("playground.c.machine.Memory",
       }
 
       // Ensure that the access remains in one region of memory
-      if ((addr >= info.defs.start && 
-           addr < info.defs.start + info.defs.length &&
-           addr + size > info.defs.start + info.defs.length) ||
-
-          (addr >= info.gas.start && 
-           addr < info.gas.start + info.gas.length &&
-           addr + size > info.gas.start + info.gas.length) ||
-
-          (addr >= info.heap.start && 
-           addr < info.heap.start + info.heap.length &&
-           addr + size > info.heap.start + info.heap.length) ||
-
-          (addr >= info.rts.start &&
-           addr < info.rts.start  + info.rts.length &&
-           addr + size > info.rts.start + info.rts.length))
+      if (addr + size > this.__regionEnd[region])
       {
         throw new playground.c.lib.RuntimeError(
           playground.c.lib.Node._currentNode,
@@ -506,48 +801,53 @@ qx.Class.define("playground.c.machine.Memory",
       // If so requested, test that memory to be accessed has been initialized.
       if (bRequireInitialized)
       {
-        for (i = 0; i < size; i++)
+        i = this.findUninitialized(addr, size);
+        if (i != -1)
         {
-          if (! playground.c.machine.Memory._memInitialized[addr + i])
+          // Create a message containing the address of the problem
+          addrMessage =
+            (this.__getBase() == 16 ? "0x" : "") +
+            (addr + i).toString(this.__getBase());
+
+          // Create the default hint
+          hint = "Reading an uninitialized value from address " + addrMessage;
+
+          // Stack symbol information isn't maintained while the memory
+          // template view is detached. Reconstruct it, to name the variable.
+          if (this.__bViewDetached)
           {
-            // Create a message containing the address of the problem
-            addrMessage =
-              (this.__getBase() == 16 ? "0x" : "") +
-              (addr + i).toString(this.__getBase());
-            
-            // Create the default hint
-            hint = "Reading an uninitialized value from address " + addrMessage;
+            this.restoreSymbolInfo();
+          }
 
-            // See if there's a symbol entry at the current address, or if
-            // not, then at the base address.
-            symtabInfo = this._symbolInfo[addr + i] || this._symbolInfo[addr];
-            if (symtabInfo)
+          // See if there's a symbol entry at the current address, or if
+          // not, then at the base address.
+          symtabInfo =
+            this.__getSymbolInfo(addr + i) || this.__getSymbolInfo(addr);
+          if (symtabInfo)
+          {
+            // Yup, we found one. Create a hint based on that.
+            if (i == 0)
             {
-              // Yup, we found one. Create a hint based on that.
-              if (i == 0)
-              {
-                hint =
-                  " Variable " + symtabInfo.name +
-                  " appears to be uninitialized when reading from it" +
-                  " (at address " + addrMessage + ")";
-              }
-              else
-              {
-                hint +=
-                  " (near variable " + symtabInfo.name + ")";
-              }
+              hint =
+                " Variable " + symtabInfo.name +
+                " appears to be uninitialized when reading from it" +
+                " (at address " + addrMessage + ")";
+            }
+            else
+            {
+              hint +=
+                " (near variable " + symtabInfo.name + ")";
             }
-
-            throw new playground.c.lib.RuntimeError(
-              playground.c.lib.Node._currentNode,
-              hint);
           }
+
+          throw new playground.c.lib.RuntimeError(
+            playground.c.lib.Node._currentNode,
+            hint);
         }
       }
 
-      // Get an appropriate view into the memory, based on the type, and return
-      // that value.
-      return this._getByType(type, addr)[0];
+      // Retrieve the value via the view for this type
+      return this._read(code, addr);
     },
     
     /**
@@ -565,9 +865,8 @@ qx.Class.define("playground.c.machine.Memory",
      */
     set : function(addr, type, value)
     {
-      var             i;
+      var             code;
       var             size;
-      var             info = playground.c.machine.Memory.info;
 
       // See if they're trying to access a function address
       if (addr instanceof playground.c.lib.Node)
@@ -582,18 +881,42 @@ qx.Class.define("playground.c.machine.Memory",
         throw new playground.c.lib.NotYetImplemented("function pointers");
       }
 
-      // Determine size to be accessed
-      size = playground.c.machine.Memory.typeSize[type];
+      // Determine the type code, and the size to be accessed
+      code = this.__getTypeCode(type);
+      size = playground.c.machine.Memory.typeCodeSize[code];
+
+      // Ensure that we're writing within a single valid region of memory
+      this.__checkWrite(addr, size);
+
+      // Mark initialized memory
+      this.markInitialized(addr, size);
+
+      // The data model must be updated to reflect this change
+      this.__markDirty(addr, size);
+
+      // Save the value at that address, via the view for this type
+      this._write(code, addr, value);
+    },
+    
+    /**
+     * Ensure that a range of addresses to be written lies entirely within
+     * one region of memory accessible via set(). An error is thrown if not.
+     *
+     * @param addr {Number}
+     *   The first address to be written
+     *
+     * @param size {Number}
+     *   The number of bytes to be written
+     */
+    __checkWrite : function(addr, size)
+    {
+      var             region;
+
+      // Determine which region of memory is being accessed
+      region = this.__getRegion(addr);
 
       // Ensure we are accessing a valid region of memory
-      if (! ((addr >= info.defs.start && 
-              addr < info.defs.start + info.defs.length) ||
-             (addr >= info.gas.start && 
-              addr < info.gas.start + info.gas.length) ||
-             (addr >= info.heap.start && 
-              addr < info.heap.start + info.heap.length) ||
-             (addr >= info.rts.start &&
-              addr < info.rts.start  + info.rts.length)))
+      if (! region)
       {
         throw new playground.c.lib.RuntimeError(
           playground.c.lib.Node._currentNode,
@@ -607,21 +930,7 @@ qx.Class.define("playground.c.machine.Memory",
       }
 
       // Ensure that the access remains in one region of memory
-      if ((addr >= info.defs.start && 
-           addr < info.defs.start + info.defs.length &&
-           addr + size > info.defs.start + info.defs.length) ||
-
-          (addr >= info.gas.start && 
-           addr < info.gas.start + info.gas.length &&
-           addr + size > info.gas.start + info.gas.length) ||
-
-          (addr >= info.heap.start && 
-           addr < info.heap.start + info.heap.length &&
-           addr + size > info.heap.start + info.heap.length) ||
-
-          (addr >= info.rts.start &&
-           addr < info.rts.start  + info.rts.length &&
-           addr + size > info.rts.start + info.rts.length))
+      if (addr + size > this.__regionEnd[region])
       {
         throw new playground.c.lib.RuntimeError(
           playground.c.lib.Node._currentNode,
@@ -634,18 +943,241 @@ qx.Class.define("playground.c.machine.Memory",
             "'run time stack' region of memory. " +
             "\n  (This is sometimes called a 'Segmentation Fault'.)");
       }
+    },
+
+    /**
+     * Record that the words containing a range of memory have been modified,
+     * so that they will be refreshed by the next updateDataModel().
+     *
+     * @param addr {Number}
+     *   The first address of the range
+     *
+     * @param length {Number}
+     *   The number of bytes in the range
+     */
+    __markDirty : function(addr, length)
+    {
+      var             word;
+      var             last;
+      var             WORDSIZE = playground.c.machine.Memory.WORDSIZE;
+
+      last = Math.floor((addr + length - 1) / WORDSIZE);
+      for (word = Math.floor(addr / WORDSIZE); word <= last; word++)
+      {
+        // Add each word to the dirty list only once
+        if (! this.__bDirtyWord[word])
+        {
+          this.__bDirtyWord[word] = 1;
+          this.__dirtyWords.push(word * WORDSIZE);
+        }
+      }
+    },
+
+    /**
+     * Mark a range of memory as having been initialized
+     *
+     * @param addr {Number}
+     *   The first address of the range
+     *
+     * @param length {Number}
+     *   The number of bytes in the range
+     */
+    markInitialized : function(addr, length)
+    {
+      var             bit;
+      var             count;
+      var             end = addr + length;
+      var             bitmap = playground.c.machine.Memory._memInitialized;
+
+      // Mark the bits, a (possibly partial) bitmap word at a time
+      while (addr < end)
+      {
+        bit = addr & 31;
+        count = Math.min(32 - bit, end - addr);
+        bitmap[addr >> 5] |= (0xffffffff >>> (32 - count)) << bit;
+        addr += count;
+      }
+    },
+
+    /**
+     * Mark a range of memory as not having been initialized
+     *
+     * @param addr {Number}
+     *   The first address of the range
+     *
+     * @param length {Number}
+     *   The number of bytes in the range
+     */
+    markUninitialized : function(addr, length)
+    {
+      var             bit;
+      var             count;
+      var             end = addr + length;
+      var             bitmap = playground.c.machine.Memory._memInitialized;
+
+      // Clear the bits, a (possibly partial) bitmap word at a time
+      while (addr < end)
+      {
+        bit = addr & 31;
+        count = Math.min(32 - bit, end - addr);
+        bitmap[addr >> 5] &= ~((0xffffffff >>> (32 - count)) << bit);
+        addr += count;
+      }
+    },
+
+    /**
+     * Find the first byte, within a range of memory, that has not been
+     * initialized.
+     *
+     * @param addr {Number}
+     *   The first address of the range
+     *
+     * @param length {Number}
+     *   The number of bytes in the range
+     *
+     * @return {Number}
+     *   The offset, from addr, of the first uninitialized byte, or -1 if all
+     *   bytes in the range have been initialized.
+     */
+    findUninitialized : function(addr, length)
+    {
+      var             i;
+      var             bit;
+      var             count;
+      var             mask;
+      var             start = addr;
+      var             end = addr + length;
+      var             bitmap = playground.c.machine.Memory._memInitialized;
+
+      // Test the bits, a (possibly partial) bitmap word at a time
+      while (addr < end)
+      {
+        bit = addr & 31;
+        count = Math.min(32 - bit, end - addr);
+        mask = ((0xffffffff >>> (32 - count)) << bit) >>> 0;
+
+        // Are any of these bits clear?
+        if (((bitmap[addr >> 5] & mask) >>> 0) !== mask)
+        {
+          // Yup. Find the first one.
+          for (i = 0; i < count; i++)
+          {
+            if (! (bitmap[addr >> 5] & (1 << (bit + i))))
+            {
+              return addr + i - start;
+            }
+          }
+        }
+
+        addr += count;
+      }
+
+      return -1;
+    },
+
+    /**
+     * Determine the greatest extent of the stack since memory was last
+     * initialized, as judged by which bytes have been written. (Heap usage
+     * is tracked by the allocator; see Stdlib.getPeakHeapUsage().)
+     *
+     * @return {Number}
+     *   The number of bytes, from the top of the stack region down to the
+     *   lowest byte written
+     */
+    getPeakStackUsage : function()
+    {
+      var             bit;
+      var             word;
+      var             last;
+      var             info = playground.c.machine.Memory.info;
+      var             bitmap = playground.c.machine.Memory._memInitialized;
+
+      // Find the lowest byte written in the stack region
+      last = (info.rts.start + info.rts.length) >> 5;
+      for (word = info.rts.start >> 5; word < last; word++)
+      {
+        if (bitmap[word])
+        {
+          // The lowest set bit is the lowest byte written
+          for (bit = 0; ! (bitmap[word] & (1 << bit)); bit++)
+          {
+            // nothing to do
+          }
+
+          return info.rts.start + info.rts.length - ((word << 5) + bit);
+        }
+      }
+
+      return 0;
+    },
+
+    /**
+     * Write a sequence of bytes to memory. The bytes must all lie within one
+     * region of memory.
+     *
+     * @param addr {Number}
+     *   The address to which the first byte is to be written
+     *
+     * @param bytes {Array}
+     *   The byte values to be written
+     */
+    setBytes : function(addr, bytes)
+    {
+      var             i;
+      var             view;
+
+      // Ensure that we're writing within a single valid region of memory
+      this.__checkWrite(addr, bytes.length);
 
       // Mark initialized memory
-      for (i = 0; i < size; i++)
+      this.markInitialized(addr, bytes.length);
+
+      // The data model must be updated to reflect this change
+      this.__markDirty(addr, bytes.length);
+
+      // Write the bytes
+      view = this.__views[playground.c.machine.Memory.typeCode["char"]];
+      for (i = 0; i < bytes.length; i++)
       {
-        playground.c.machine.Memory._memInitialized[addr + i] = true;
+        view[addr + i] = bytes[i];
       }
+    },
+
+    /**
+     * Set each byte of a range of memory to a given value. The range must
+     * lie within one region of memory.
+     *
+     * @param addr {Number}
+     *   The first address of the range
+     *
+     * @param value {Number}
+     *   The value to which each byte is to be set
+     *
+     * @param length {Number}
+     *   The number of bytes in the range
+     */
+    fill : function(addr, value, length)
+    {
+      var             i;
+      var             view;
+
+      // Ensure that we're writing within a single valid region of memory
+      this.__checkWrite(addr, length);
+
+      // Mark initialized memory
+      this.markInitialized(addr, length);
+
+      // The data model must be updated to reflect this change
+      this.__markDirty(addr, length);
 
-      // Get an appropriate view into the memory, based on the type, and save
-      // the value at that address
-      this._getByType(type, addr)[0] = value;
+      // Write the bytes
+      view = this.__views[playground.c.machine.Memory.typeCode["char"]];
+      for (i = 0; i < length; i++)
+      {
+        view[addr + i] = value;
+      }
     },
-    
+
     /**
      * Push a value onto the stack
      *
@@ -754,16 +1286,18 @@ qx.Class.define("playground.c.machine.Memory",
      */
     move : function(addrSrc, typeSrc, addrDest, typeDest, bForce)
     {
-      var             memSrc;
-      var             memDest;
+      var             codeSrc;
+      var             codeDest;
       var             sizeSrc;
       var             sizeDest;
       var             info = playground.c.machine.Memory.info;
       var             WORDSIZE = playground.c.machine.Memory.WORDSIZE;
 
-      // Determine size to be moved
-      sizeSrc = playground.c.machine.Memory.typeSize[typeSrc];
-      sizeDest = playground.c.machine.Memory.typeSize[typeDest];
+      // Determine the type codes, and the size to be moved
+      codeSrc = this.__getTypeCode(typeSrc);
+      codeDest = this.__getTypeCode(typeDest);
+      sizeSrc = playground.c.machine.Memory.typeCodeSize[codeSrc];
+      sizeDest = playground.c.machine.Memory.typeCodeSize[codeDest];
 
       // Forcing is for internal writes to code space, when we really, really
       // know exactly what we're doing. It bypasses all of the error checks.
@@ -854,7 +1388,7 @@ qx.Class.define("playground.c.machine.Memory",
       }
 
       // Only values of size one can be at odd addresses
-      if (addrSrc % 2 != 0 && typeSrc != "char" && typeSrc != "unsigned char")
+      if (addrSrc % 2 != 0 && sizeSrc != 1)
       {
         throw new Error(
           "Invalid memory access at " +
@@ -865,9 +1399,7 @@ qx.Class.define("playground.c.machine.Memory",
       }
 
       // Only values of size one can be at odd addresses
-      if (addrDest % 2 != 0 &&
-          typeDest != "char" &&
-          typeDest != "unsigned char")
+      if (addrDest % 2 != 0 && sizeDest != 1)
       {
         throw new Error(
           "Invalid memory access at " + 
@@ -877,80 +1409,318 @@ qx.Class.define("playground.c.machine.Memory",
             "an odd address.");
       }
 
-      // Get an appropriate view into the memory, based on the source type
-      memSrc = this._getByType(typeSrc, addrSrc);
-
-      // Get an appropriate view into the memory, based on the destination type
-      memDest = this._getByType(typeDest, addrDest);
-
-      // Now that we have appropriate views into the memory, read and write
-      // the data.
-      memDest[0] = memSrc[0];
+      // Read the data via the view for the source type, and write it via the
+      // view for the destination type.
+      this._write(codeDest, addrDest, this._read(codeSrc, addrSrc));
+
+      // The destination is initialized only if the source was. Registers,
+      // the expression stack, and instruction memory are written without
+      // being tracked, so data moved from them is deemed initialized.
+      if (this.__getRegion(addrSrc) &&
+          this.findUninitialized(addrSrc, sizeSrc) != -1)
+      {
+        this.markUninitialized(addrDest, sizeDest);
+      }
+      else
+      {
+        this.markInitialized(addrDest, sizeDest);
+      }
+
+      // The destination has been modified
+      this.__markDirty(addrDest, sizeDest);
+    },
+    
+    /**
+     * Set the value of a register, used internally by instructions.
+     */
+    setReg : function(registerName, type, value)
+    {
+      // Set the register value, via the view for the destination type
+      this._write(this.__getTypeCode(type),
+                  playground.c.machine.Memory.register[registerName],
+                  value);
+    },
+
+    /**
+     * Retrieve the value of a register, used internally by instructions.
+     */
+    getReg : function(registerName, type)
+    {
+      // Retrieve the register value, via the view for the source type
+      return this._read(this.__getTypeCode(type),
+                        playground.c.machine.Memory.register[registerName]);
+    },
+
+    /**
+     * Create a normal, JavaScript array representation of a region of memory.
+     *
+     * @param startAddr {Number}
+     *   The starting address to be represented in the array
+     *
+     * @param length {Number?}
+     *   The number of bytes of data to be represented in the array. Defaults
+     *   to the remainder of memory.
+     *
+     * @return {Array}
+     *   An array of bytes copied from the simulated machine's memory
+     *
+     * @ignore(Uint8Array)
+     */
+    toArray : function(startAddr, length)
+    {
+      var             i;
+      var             mem;
+      var             ret = [];
+
+      // If length is not specified, set it to the remainder of memory
+      length = (length || 
+                (playground.c.machine.Memory.info.rts.start + 
+                 playground.c.machine.Memory.info.rts.length -
+                 startAddr));
+
+      mem = new Uint8Array(this._memory, startAddr, length);
+      for (i = 0; i < length; i++)
+      {
+        ret.push(mem[i]);
+      }
+      return ret;
+    },
+
+    /**
+     * Find the length of the null-terminated C string at the given address.
+     * The string, including its terminating null byte, must lie within one
+     * region of memory. An error is thrown if not.
+     *
+     * @param addr {Number}
+     *   The address of the first character of the string
+     *
+     * @return {Number}
+     *   The number of characters preceding the terminating null byte
+     */
+    getStringLength : function(addr)
+    {
+      var             i;
+      var             end;
+      var             view;
+
+      // Ensure that the address is valid, and find the end of its region
+      end = this.__getStringRegionEnd(addr);
+
+      // Search, via the persistent unsigned char view, for the null byte
+      view =
+        this.__views[playground.c.machine.Memory.typeCode["unsigned char"]];
+      for (i = addr; i < end && view[i] !== 0; i++)
+      {
+        // nothing to do
+      }
+
+      // Ensure that the string is terminated within its region
+      if (i == end)
+      {
+        throw new playground.c.lib.RuntimeError(
+          playground.c.lib.Node._currentNode,
+          "Invalid memory access at " + 
+            (this.__getBase() == 16 ? "0x" : "") +
+            addr.toString(this.__getBase()) + ": " +
+            "\n  The string at this address has no terminating null " +
+            "character within the bounds of its 'globals and statics', " +
+            "'heap', or 'run time stack' region of memory. " +
+            "\n  (This is sometimes called a 'Segmentation Fault'.)");
+      }
+
+      return i - addr;
+    },
+
+    /**
+     * Determine whether the null-terminated C string at the given address is
+     * identical to a JavaScript string, without retrieving a copy of it.
+     *
+     * @param addr {Number}
+     *   The address of the first character of the C string
+     *
+     * @param str {String}
+     *   The string to compare with
+     *
+     * @return {Boolean}
+     *   true if the C string has the same characters as str; false otherwise
+     */
+    stringEquals : function(addr, str)
+    {
+      var             i;
+      var             end;
+      var             view;
+      var             length = str.length;
+
+      // Ensure that the address is valid, and find the end of its region
+      end = this.__getStringRegionEnd(addr);
+
+      // If str, with a null byte, would not fit in the region, no match.
+      if (addr + length >= end)
+      {
+        return false;
+      }
+
+      // Compare each character, and then ensure the C string ends there
+      view =
+        this.__views[playground.c.machine.Memory.typeCode["unsigned char"]];
+      for (i = 0; i < length; i++)
+      {
+        if (view[addr + i] !== str.charCodeAt(i))
+        {
+          return false;
+        }
+      }
+
+      return view[addr + length] === 0;
+    },
+
+    /**
+     * Ensure that a string's address is within a region of memory that may
+     * be accessed. An error is thrown if not.
+     *
+     * @param addr {Number}
+     *   The address of the first character of the string
+     *
+     * @return {Number}
+     *   The end address (exclusive) of the region containing the string
+     */
+    __getStringRegionEnd : function(addr)
+    {
+      var             region;
+
+      // Determine which region of memory contains the string
+      region = (typeof addr == "number" ? this.__getRegion(addr) : 0);
+
+      // Ensure we are accessing a valid region of memory
+      if (! region)
+      {
+        throw new playground.c.lib.RuntimeError(
+          playground.c.lib.Node._currentNode,
+          "Invalid memory access at " + 
+            (typeof addr == "number"
+             ? (this.__getBase() == 16 ? "0x" : "") +
+               addr.toString(this.__getBase())
+             : String(addr)) + ": " +
+            "\n  The address of the string is not within the " +
+            "'globals and statics', 'heap', or " +
+            "'run time stack' regions of memory. " +
+            "\n  (This is sometimes called a 'Segmentation Fault'.)");
+      }
+
+      return this.__regionEnd[region];
     },
-    
+
     /**
-     * Set the value of a register, used internally by instructions.
+     * Retrieve the null-terminated C string at the given address, as a
+     * JavaScript string. No copy of memory is made beyond the characters of
+     * the string itself.
+     *
+     * @param addr {Number}
+     *   The address of the first character of the string
+     *
+     * @return {String}
+     *   The characters of the string, excluding the terminating null byte
      */
-    setReg : function(registerName, type, value)
+    getString : function(addr)
     {
-      var             mem;
-
-      // Get an appropriate view into the memory, based on the destination types
-      mem = this._getByType(type, 
-                            playground.c.machine.Memory.register[registerName]);
+      var             i;
+      var             length;
+      var             view;
+      var             ret = "";
+      var             CHUNK = 4096;
+
+      // Find the end of the string. This also validates its address.
+      length = this.getStringLength(addr);
+
+      // Convert the characters, via the persistent unsigned char view. Large
+      // strings are converted in pieces, to limit the number of arguments.
+      view =
+        this.__views[playground.c.machine.Memory.typeCode["unsigned char"]];
+      for (i = 0; i < length; i += CHUNK)
+      {
+        ret += String.fromCharCode.apply(
+          null,
+          view.subarray(addr + i, addr + Math.min(i + CHUNK, length)));
+      }
 
-      // Set the register value
-      mem[0] = value;
+      return ret;
     },
 
     /**
-     * Retrieve the value of a register, used internally by instructions.
+     * Write a JavaScript string to memory as a null-terminated C string. The
+     * string, including its terminating null byte, must lie within one region
+     * of memory.
+     *
+     * @param addr {Number}
+     *   The address to which the first character is to be written
+     *
+     * @param str {String}
+     *   The string to be written. Each character is stored as one byte.
      */
-    getReg : function(registerName, type)
+    setString : function(addr, str)
     {
-      var             mem;
+      var             i;
+      var             view;
+      var             length = str.length + 1;
 
-      // Get an appropriate view into the memory, based on the destination type
-      mem = this._getByType(type, 
-                            playground.c.machine.Memory.register[registerName]);
+      // Ensure that we're writing within a single valid region of memory
+      this.__checkWrite(addr, length);
 
-      // Retrieve the register value
-      return mem[0];
+      // Mark initialized memory
+      this.markInitialized(addr, length);
+
+      // The data model must be updated to reflect this change
+      this.__markDirty(addr, length);
+
+      // Write the characters, and the terminating null byte
+      view =
+        this.__views[playground.c.machine.Memory.typeCode["unsigned char"]];
+      for (i = 0; i < str.length; i++)
+      {
+        view[addr + i] = str.charCodeAt(i);
+      }
+      view[addr + i] = 0;
     },
 
     /**
-     * Create a normal, JavaScript array representation of a region of memory.
-     *
-     * @param startAddr {Number}
-     *   The starting address to be represented in the array
+     * Compare two null-terminated C strings, as strcmp() does
      *
-     * @param length {Number?}
-     *   The number of bytes of data to be represented in the array. Defaults
-     *   to the remainder of memory.
+     * @param addr1 {Number}
+     *   The address of the first string
      *
-     * @return {Array}
-     *   An array of bytes copied from the simulated machine's memory
+     * @param addr2 {Number}
+     *   The address of the second string
      *
-     * @ignore(Uint8Array)
+     * @return {Number}
+     *   A negative number, zero, or a positive number if the first string is
+     *   less than, equal to, or greater than the second string, respectively
      */
-    toArray : function(startAddr, length)
+    compareStrings : function(addr1, addr2)
     {
       var             i;
-      var             mem;
-      var             ret = [];
-
-      // If length is not specified, set it to the remainder of memory
-      length = (length || 
-                (playground.c.machine.Memory.info.rts.start + 
-                 playground.c.machine.Memory.info.rts.length -
-                 startAddr));
-
-      mem = new Uint8Array(this._memory, startAddr, length);
-      for (i = 0; i < length; i++)
+      var             c1;
+      var             c2;
+      var             length;
+      var             view;
+
+      // Validate both strings, and compare no further than the shorter one's
+      // terminating null byte
+      length = Math.min(this.getStringLength(addr1),
+                        this.getStringLength(addr2));
+
+      view =
+        this.__views[playground.c.machine.Memory.typeCode["unsigned char"]];
+      for (i = 0; i <= length; i++)
       {
-        ret.push(mem[i]);
+        c1 = view[addr1 + i];
+        c2 = view[addr2 + i];
+        if (c1 != c2)
+        {
+          return c1 - c2;
+        }
       }
-      return ret;
+
+      return 0;
     },
 
     /**
@@ -970,6 +1740,9 @@ qx.Class.define("playground.c.machine.Memory",
       var             region;
       var             info = playground.c.machine.Memory.info;
       
+      // The structure of the data model is changing
+      ++this.__modelGeneration;
+
       // Determine the group name for the memory template view. If there's a
       // symbol table, use its name; otherwise it's created before there's a
       // symbol table.
@@ -982,7 +1755,7 @@ qx.Class.define("playground.c.machine.Memory",
         return;
       }
 
-      this._symbolInfo[addr] = 
+      this.__getSymbolTable(addr)[addr] = 
         {
           addr       : addr,
           name       : (prefix || "") + symbol.getName(),
@@ -1064,15 +1837,160 @@ qx.Class.define("playground.c.machine.Memory",
      */
     removeSymbolInfo : function(addr)
     {
+      // The structure of the data model is changing
+      ++this.__modelGeneration;
+
       if (typeof addr != "undefined")
       {
         // Remove this symbol info
-        delete this._symbolInfo[addr];
+        delete this.__getSymbolTable(addr)[addr];
       }
       else
       {
-        this._symbolInfo = {};
+        this.__globalSymbolInfo = {};
+        this.__heapSymbolInfo = {};
+        this.__activationRecordsBegin.forEach(
+          function(ar)
+          {
+            ar.symbolInfo = {};
+          });
+      }
+    },
+
+    /**
+     * Record that a return address has been pushed onto the stack, so that
+     * it can be labeled as such in the memory template view.
+     *
+     * @param addr {Number}
+     *   The address of the return address
+     */
+    setReturnAddressInfo : function(addr)
+    {
+      var             records = this.__activationRecordsBegin;
+
+      // Save the address with the current activation record, for
+      // restoreSymbolInfo()
+      records[records.length - 1].returnAddr = addr;
+
+      // If the view is detached, there's nothing more to do now
+      if (this.__bViewDetached)
+      {
+        return;
+      }
+
+      this.setSymbolInfo(addr,
+                         playground.c.machine.Memory.returnAddressSymbol);
+    },
+
+    /**
+     * Specify whether the memory template view is detached. While it is,
+     * symbol information for stack frames is not maintained. Upon
+     * reattaching, the symbol information is reconstructed.
+     *
+     * @param bDetached {Boolean}
+     *   true if the view is detached; false if it is attached
+     */
+    setViewDetached : function(bDetached)
+    {
+      var             bWasDetached = this.__bViewDetached;
+
+      this.__bViewDetached = bDetached;
+
+      // If we're reattaching, reconstruct the symbol information
+      if (bWasDetached && ! bDetached)
+      {
+        this.restoreSymbolInfo();
+      }
+    },
+
+    /**
+     * Determine whether the memory template view is detached
+     *
+     * @return {Boolean}
+     *   true if the view is detached, in which case symbol information for
+     *   stack frames is not being maintained.
+     */
+    isViewDetached : function()
+    {
+      return this.__bViewDetached;
+    },
+
+    /**
+     * Reconstruct the symbol information for the currently-active stack
+     * frames, from the activation records and the symbol table stack.
+     */
+    restoreSymbolInfo : function()
+    {
+      // Label the return address in each activation record
+      this.__activationRecordsBegin.forEach(
+        function(ar)
+        {
+          if (typeof ar.returnAddr == "number")
+          {
+            this.setSymbolInfo(ar.returnAddr,
+                               playground.c.machine.Memory.returnAddressSymbol);
+          }
+        },
+        this);
+
+      // Add the symbols of each active symbol table
+      playground.c.lib.Symtab.restoreSymbolInfo();
+    },
+
+    /**
+     * Find the table in which symbol information for an address is kept.
+     * Symbols on the stack are kept in a table in the activation record
+     * containing them, so that the table may be discarded when the
+     * activation record ends.
+     *
+     * @param addr {Number}
+     *   The address of the symbol
+     *
+     * @return {Map}
+     *   The symbol information table, indexed by address
+     */
+    __getSymbolTable : function(addr)
+    {
+      var             i;
+      var             records = this.__activationRecordsBegin;
+      var             info = playground.c.machine.Memory.info;
+
+      if (addr >= info.rts.start && addr < info.rts.start + info.rts.length)
+      {
+        // Find the activation record containing this address. It is
+        // normally the current one, so search from the top of the stack.
+        for (i = records.length - 1; i > 0; i--)
+        {
+          if (addr < records[i].addr)
+          {
+            break;
+          }
+        }
+
+        return records[i].symbolInfo;
+      }
+
+      if (addr >= info.heap.start && addr < info.heap.start + info.heap.length)
+      {
+        return this.__heapSymbolInfo;
       }
+
+      return this.__globalSymbolInfo;
+    },
+
+    /**
+     * Retrieve the symbol information for an address
+     *
+     * @param addr {Number}
+     *   The address of the symbol
+     *
+     * @return {Map|undefined}
+     *   The symbol information saved by setSymbolInfo(), or undefined if
+     *   there is none for this address.
+     */
+    __getSymbolInfo : function(addr)
+    {
+      return this.__getSymbolTable(addr)[addr];
     },
 
     /**
@@ -1085,7 +2003,10 @@ qx.Class.define("playground.c.machine.Memory",
     beginActivationRecord : function(addr)
     {
       // Record the address. The function name will be added later
-      this.__activationRecordsBegin.push({ addr : addr });
+      this.__activationRecordsBegin.push({ addr : addr, symbolInfo : {} });
+
+      // The structure of the data model is changing
+      ++this.__modelGeneration;
     },
     
     /**
@@ -1093,24 +2014,12 @@ qx.Class.define("playground.c.machine.Memory",
      */
     endActivationRecord : function()
     {
-      var             ar;
-      var             symbol;
-      var             stackStart = playground.c.machine.Memory.info.rts.start;
+      // Remove the ending activation record. Its symbol information goes
+      // with it.
+      this.__activationRecordsBegin.pop();
 
-      // Remove, but get a reference to, the ending activation record
-      ar = this.__activationRecordsBegin.pop();
-      
-      // Clear out any obsolete symbol info
-      for (symbol in this._symbolInfo)
-      {
-        // Is this symbol in the now-obsolete activation record?
-        if (this._symbolInfo[symbol].addr >= stackStart &&
-            this._symbolInfo[symbol].addr < ar.addr)
-        {
-          // Yup. Delete it.
-          delete this._symbolInfo[symbol];
-        }
-      }
+      // The structure of the data model is changing
+      ++this.__modelGeneration;
     },
 
     /**
@@ -1134,6 +2043,9 @@ qx.Class.define("playground.c.machine.Memory",
       
       // Add a name to the most recently added activation record
       activationRecord.name = name;
+
+      // The structure of the data model is changing
+      ++this.__modelGeneration;
     },
 
     /**
@@ -1154,15 +2066,15 @@ qx.Class.define("playground.c.machine.Memory",
     getDataModel : function(start, length)
     {
       var             i;
-      var             j;
       var             type;
       var             size;
       var             addr;
       var             datum;
       var             words;
-      var             values;
+      var             rows;
       var             elements;
       var             arrayCount;
+      var             layout = {};
       var             model = [];
       var             WORDSIZE = playground.c.machine.Memory.WORDSIZE;
       
@@ -1184,10 +2096,8 @@ qx.Class.define("playground.c.machine.Memory",
         new Uint32Array(this._memory, start, length / WORDSIZE),
         0);
       
-      // Create the model
-      //
-      // TODO: This could be optimized by creating it once, and then modifying
-      // it during calls to .set()
+      // Create the model. Subsequent changes to memory may be applied to it
+      // incrementally, via updateDataModel().
       words.forEach(
         function(word, index)
         {
@@ -1250,10 +2160,11 @@ qx.Class.define("playground.c.machine.Memory",
 
           // Retrieve the symbol information for this address, if
           // available.
-          if (this._symbolInfo[addr])
+          data = this.__getSymbolInfo(addr);
+          if (data)
           {
             // Create a clone since we'll be munging it.
-            data = JSON.parse(JSON.stringify(this._symbolInfo[addr]));
+            data = JSON.parse(JSON.stringify(data));
             data.group = group;
           }
           else
@@ -1353,34 +2264,11 @@ qx.Class.define("playground.c.machine.Memory",
             // Decrement the array count by how many we will retrieve
             arrayCount -= elements;
 
-            // Get an (ordinary JavaScript) array of values of the specified
-            // type.
-            values = 
-              Array.prototype.slice.call(
-                this._getByType(type, addr, elements), 
-                0);
-            
-            // Put those values into a new array, in the positions for display
-            datum.values = [];
-            do
-            {
-              // Take the next value from the retrieved array and put it into
-              // our new array.
-              datum.values.push(values.shift());
-              
-              // Insert space holders in positions where no values will be
-              // displayed
-              for (j = size - 1; j > 0; --j)
-              {
-                datum.values.push(null);
-              }
-            } while(values.length > 0);
-            
-            // If the data array isn't full, fill it
-            while (datum.values.length < WORDSIZE)
-            {
-              datum.values.push(null);
-            }
+            // Retrieve the values, in the positions for display
+            datum.values = this.__getWordValues(type, size, addr, elements);
+
+            // Save the layout of this word, for incremental updates
+            layout[addr] = { type : type, size : size, elements : elements };
             
             // If there are more elements...
             if (arrayCount > 0)
@@ -1416,9 +2304,271 @@ qx.Class.define("playground.c.machine.Memory",
           }
         }.bind(this));
 
+      // If this is a model of all of memory, it can later be updated
+      // incrementally. Save its structure.
+      if (start === 0 && length === this.__memSize)
+      {
+        rows = {};
+        model.forEach(
+          function(datum, index)
+          {
+            rows[datum.addr] = layout[datum.addr] || {};
+            rows[datum.addr].index = index;
+          });
+
+        this.__modelRows = rows;
+        this.__modelSignature = this.__getModelSignature();
+
+        // The model is now up to date
+        this.__dirtyWords.forEach(
+          function(addr)
+          {
+            this.__bDirtyWord[addr / WORDSIZE] = 0;
+          },
+          this);
+        this.__dirtyWords = [];
+      }
+
       return model;
     },
 
+    /**
+     * Update, in place, a model created from getDataModel() of all of
+     * memory, modifying only those words which have changed since it was
+     * created or last updated. This is possible only if the structure of
+     * memory (symbols, activation records, and the extent of each region in
+     * use) has not changed.
+     *
+     * @param model {qx.data.Array}
+     *   The model, as marshaled from the result of getDataModel()
+     *
+     * @return {Boolean}
+     *   true if the model was updated; false if the structure of memory has
+     *   changed, in which case a new model must be created via
+     *   getDataModel().
+     */
+    updateDataModel : function(model)
+    {
+      var             i;
+      var             row;
+      var             addr;
+      var             item;
+      var             bytes;
+      var             values;
+      var             WORDSIZE = playground.c.machine.Memory.WORDSIZE;
+
+      // Ensure that the model's structure is still valid
+      if (! this.__modelRows ||
+          this.__modelSignature !== this.__getModelSignature())
+      {
+        return false;
+      }
+
+      // Update each modified word
+      while (this.__dirtyWords.length > 0)
+      {
+        addr = this.__dirtyWords.pop();
+        this.__bDirtyWord[addr / WORDSIZE] = 0;
+
+        // Ignore words not displayed in the model
+        row = this.__modelRows[addr];
+        if (! row)
+        {
+          continue;
+        }
+
+        item = model.getItem(row.index);
+
+        // Update the bytes of this word
+        bytes = item.getBytes();
+        for (i = 0; i < WORDSIZE; i++)
+        {
+          bytes.setItem(i, this.__views[1][addr + i]);
+        }
+
+        // If it's typed, update its values too
+        if (row.type)
+        {
+          values = item.getValues();
+          this.__getWordValues(row.type, row.size, addr, row.elements).forEach(
+            function(value, i)
+            {
+              values.setItem(i, value);
+            });
+        }
+      }
+
+      return true;
+    },
+
+    /**
+     * Take a snapshot of memory and of the symbol information describing it,
+     * so that it may be displayed by another thread. Unless memory is
+     * shared, the snapshot contains a copy of it, in an ArrayBuffer, so it
+     * may be transferred, rather than copied again, by postMessage().
+     *
+     * @return {Map}
+     *   The snapshot, to be provided to loadSnapshot(). Its memory member is
+     *   the copy of memory, or the SharedArrayBuffer containing memory.
+     *
+     * @ignore(ArrayBuffer)
+     */
+    getSnapshot : function()
+    {
+      var             info = playground.c.machine.Memory.info;
+
+      return (
+        {
+          memory     : (this._memory instanceof ArrayBuffer
+                        ? this._memory.slice(0)
+                        : this._memory),
+          generation : this.__modelGeneration,
+          symbols    :
+          {
+            global  : this.__globalSymbolInfo,
+            heap    : this.__heapSymbolInfo,
+            records : this.__activationRecordsBegin
+          },
+          virgin     :
+          {
+            gas  : info.gas.virgin,
+            heap : info.heap.virgin,
+            rts  : info.rts.virgin
+          }
+        });
+    },
+
+    /**
+     * Replace memory, and the symbol information describing it, with a
+     * snapshot taken by getSnapshot(), so that it may be displayed. Words
+     * which differ from those being replaced are marked as modified, so
+     * that a data model may be updated incrementally.
+     *
+     * @param snapshot {Map}
+     *   The snapshot
+     *
+     * @ignore(ArrayBuffer)
+     * @ignore(Uint32Array)
+     */
+    loadSnapshot : function(snapshot)
+    {
+      var             i;
+      var             newWords;
+      var             oldWords = this.__snapshotWords || this.__views[5];
+      var             info = playground.c.machine.Memory.info;
+      var             WORDSIZE = playground.c.machine.Memory.WORDSIZE;
+
+      // Note which words have changed
+      newWords = new Uint32Array(snapshot.memory);
+      for (i = 0; i < newWords.length; i++)
+      {
+        if (newWords[i] !== oldWords[i])
+        {
+          this.__markDirty(i * WORDSIZE, WORDSIZE);
+        }
+      }
+
+      // Shared memory may be the same memory as that being replaced, and
+      // continues to change. Retain a copy, to compare the next snapshot to.
+      this.__snapshotWords = (snapshot.memory instanceof ArrayBuffer
+                              ? null
+                              : new Uint32Array(newWords));
+
+      // Use the snapshot's memory from now on
+      this._memory = snapshot.memory;
+      this.__createViews();
+
+      // Retrieve the symbol information, and the extent of each region
+      this.__globalSymbolInfo = snapshot.symbols.global;
+      this.__heapSymbolInfo = snapshot.symbols.heap;
+      this.__activationRecordsBegin = snapshot.symbols.records;
+      info.gas.virgin = snapshot.virgin.gas;
+      info.heap.virgin = snapshot.virgin.heap;
+      info.rts.virgin = snapshot.virgin.rts;
+
+      // If the structure of memory may have changed, so has that of the
+      // data model
+      if (snapshot.generation !== this.__snapshotGeneration)
+      {
+        ++this.__modelGeneration;
+        this.__snapshotGeneration = snapshot.generation;
+      }
+    },
+
+    /**
+     * Obtain a description of the structure of memory, as displayed in the
+     * data model. The model must be rebuilt if this changes.
+     *
+     * @return {String}
+     *   A string which differs whenever the model's structure differs
+     */
+    __getModelSignature : function()
+    {
+      var             info = playground.c.machine.Memory.info;
+
+      return [
+               this.__modelGeneration,
+               info.gas.virgin,
+               info.heap.virgin,
+               info.rts.virgin,
+               this.getReg("SP", "unsigned int")
+             ].join(",");
+    },
+
+    /**
+     * Retrieve the values of one word of memory, for display. Each value is
+     * placed at the position of its first byte within the word; the
+     * remaining positions are null.
+     *
+     * @param type {String}
+     *   The C type of the values in this word
+     *
+     * @param size {Number}
+     *   The size of that type
+     *
+     * @param addr {Number}
+     *   The address of the word
+     *
+     * @param elements {Number}
+     *   The number of values of the given type to retrieve
+     *
+     * @return {Array}
+     *   An array of WORDSIZE elements containing the values
+     */
+    __getWordValues : function(type, size, addr, elements)
+    {
+      var             j;
+      var             values;
+      var             result = [];
+      var             WORDSIZE = playground.c.machine.Memory.WORDSIZE;
+
+      // Get an (ordinary JavaScript) array of values of the specified type.
+      values = 
+        Array.prototype.slice.call(this._getByType(type, addr, elements), 0);
+
+      do
+      {
+        // Take the next value from the retrieved array and put it into our
+        // new array.
+        result.push(values.shift());
+
+        // Insert space holders in positions where no values will be
+        // displayed
+        for (j = size - 1; j > 0; --j)
+        {
+          result.push(null);
+        }
+      } while(values.length > 0);
+
+      // If the data array isn't full, fill it
+      while (result.length < WORDSIZE)
+      {
+        result.push(null);
+      }
+
+      return result;
+    },
+
     /**
      * Display a region of memory in a pretty format
      *
@@ -219,6 +219,13 @@ qx.Class.define("playground.c.stdio.AbstractFile",
         return;
       }
 
+      // If input can be awaited synchronously, do so, and then try again.
+      if (this._awaitInput())
+      {
+        this.getc(succ, fail);
+        return;
+      }
+
       // Wait for new characters to be available in inbuf, and then try again.
       this.addListenerOnce(
         "inputdata",
@@ -318,6 +325,13 @@ qx.Class.define("playground.c.stdio.AbstractFile",
         return;
       }
 
+      // If input can be awaited synchronously, do so, and then try again.
+      if (this._awaitInput())
+      {
+        this.read(numBytes, succ, fail);
+        return;
+      }
+
       // Wait for new characters to be available in inbuf, and then try again.
       this.addListenerOnce(
         "inputdata",
@@ -536,6 +550,23 @@ qx.Class.define("playground.c.stdio.AbstractFile",
       return false;
     },
 
+    /**
+     * Block until input data is available, or end-of-file or a request to
+     * stop is encountered, and add any input data to the input buffer.
+     *
+     * Ordinarily, input arrives via an event, so can't be awaited
+     * synchronously. Subclasses for which input can be (e.g., stdin, when
+     * running in a worker with shared memory) override this.
+     *
+     * @return {Boolean}
+     *   true if input was awaited; false if the caller must instead await
+     *   the "inputdata" event.
+     */
+    _awaitInput : function()
+    {
+      return false;
+    },
+
     /*
      * Write output buffer data to the file. The output buffer will be
      * truncated by the length output to the file.
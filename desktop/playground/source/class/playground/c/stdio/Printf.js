@@ -61,32 +61,70 @@ qx.Class.define("playground.c.stdio.Printf",
    */
   construct : function(formatAddr)
   {
-    var format = [];
-    var i;
+    var             compiled;
+    var             cache = playground.c.stdio.Printf.__cache;
 
-    this._mapped = false;
-
-    // Get memory as an array
-    this._mem = playground.c.machine.Memory.getInstance().toArray(0);
+    this._mem = playground.c.machine.Memory.getInstance();
     
-    // Copy the null-terminated format string (which is represented as the
-    // ASCII character codes of each character) from the given address, one
-    // character at a time, into an array.
-    for (i = formatAddr; this._mem[i] != 0 && i < this._mem.length; i++)
+    // Format strings are nearly always string literals, used repeatedly.
+    // If this format string has already been compiled, and the memory at
+    // its address still contains the same string, use the compiled tokens.
+    compiled = cache.hasOwnProperty(formatAddr) ? cache[formatAddr] : null;
+    if (compiled && this._mem.stringEquals(formatAddr, compiled.format))
     {
-      format.push(this._mem[i]);
+      this._format = compiled.format;
+      this._tokens = compiled.tokens;
+      this._mapped = compiled.mapped;
+      this._numFlags = compiled.numFlags;
+      return;
     }
+
+    this._mapped = false;
+
+    // Retrieve the null-terminated format string from the given address
+    this._format = this._mem.getString(formatAddr);
     
-    // Convert each character code into its actual character
-    this._format = String.fromCharCode.apply(null, format);
-    
-    // Now split the format string into its tokens
+    // Now split the format string into its tokens, and compile each of them
     this._tokens = 
       this.__tokenize(this._format, this._re, this._parseDelim, this);
+    this._numFlags = 0;
+    this._tokens.forEach(
+      function(token)
+      {
+        if (typeof token == "object")
+        {
+          this.__compileToken(token);
+          ++this._numFlags;
+        }
+      },
+      this);
+
+    // Save the compiled format. Don't let the cache grow without bound.
+    if (++playground.c.stdio.Printf.__cacheSize >
+        playground.c.stdio.Printf.CACHE_MAX)
+    {
+      playground.c.stdio.Printf.__cache = cache = {};
+      playground.c.stdio.Printf.__cacheSize = 1;
+    }
+    cache[formatAddr] =
+      {
+        format   : this._format,
+        tokens   : this._tokens,
+        mapped   : this._mapped,
+        numFlags : this._numFlags
+      };
   },
   
   statics :
   {
+    /** Maximum number of compiled format strings to retain */
+    CACHE_MAX : 256,
+
+    /** Compiled format strings, keyed by the address of the format string */
+    __cache : {},
+
+    /** Number of entries in __cache */
+    __cacheSize : 0
   },
   
   members :
@@ -94,6 +132,12 @@ qx.Class.define("playground.c.stdio.Printf",
     /** A reference to the Memory singleton instance */
     _mem : null,
 
+    /** The compiled tokens of the format string. Shared; do not modify. */
+    _tokens : null,
+
+    /** The number of conversion specifications in the format string */
+    _numFlags : 0,
+
     _re : /\%(?:\(([\w_]+)\)|([1-9]\d*)\$)?([0 +\-\#]*)(\*|\d+)?(\.)?(\*|\d+)?[hlL]?([\%bscdeEfFgGioOuxX])/g,
 
     _parseDelim : function(mapping, intmapping, flags, minWidth,
@@ -184,21 +228,8 @@ qx.Class.define("playground.c.stdio.Printf",
       {
         setArg : function(token)
         {
-          var             i;
-          var             ret = [];
-
-          // Copy the null-terminated string (which is represented as the
-          // ASCII character codes of each character) from the given address,
-          // one character at a time, into an array.
-          for (i = token.arg;
-               this._mem[i] != 0 && i < this._mem.length;
-               i++)
-          {
-            ret.push(this._mem[i]);
-          }
-
-          // Convert each character code into its actual character
-          token.arg = String.fromCharCode.apply(null, ret);
+          // Retrieve the null-terminated string from the given address
+          token.arg = this._mem.getString(token.arg);
         },
 
         setMaxWidth: function(token)
@@ -254,19 +285,9 @@ qx.Class.define("playground.c.stdio.Printf",
 
       var str = '';
       var position = 0;
-      var numFlags = 0;
+      var numFlags = this._numFlags;
       var formatForDisplay;
 
-      // Figure out how many format markers are in the format string
-      this._tokens.forEach(
-        function(token)
-        {
-          if (typeof token == "object" && token["specifier"])
-          {
-            ++numFlags;
-          }
-        });
-
       for (var i = 0, token; i < this._tokens.length; i++)
       {
         token = this._tokens[i];
@@ -277,6 +298,10 @@ qx.Class.define("playground.c.stdio.Printf",
         }
         else
         {
+          // The compiled token is shared by each use of this format string.
+          // Anything determined for this call is stored in a copy of it.
+          token = Object.create(token);
+
           if (this._mapped)
           {
             if (typeof filler[token.mapping] == 'undefined')
@@ -313,95 +338,6 @@ qx.Class.define("playground.c.stdio.Printf",
             token.arg = arguments[position++];
           }
 
-          if (! token.compiled)
-          {
-            token.compiled = true;
-            token.sign = '';
-            token.zeroPad = false;
-            token.rightJustify = false;
-            token.alternative = false;
-
-            var flags = {};
-            for (var fi = token.flags.length; fi--;)
-            {
-              var flag = token.flags.charAt(fi);
-
-              flags[flag] = true;
-
-              switch(flag)
-              {
-              case ' ':
-                token.sign = ' ';
-                break;
-
-              case '+':
-                token.sign = '+';
-                break;
-
-              case '0':
-                token.zeroPad = (flags['-']) ? false : true;
-                break;
-
-              case '-':
-                token.rightJustify = true;
-                token.zeroPad = false;
-                break;
-
-              case '\#':
-                token.alternative = true;
-                break;
-
-              default:
-                throw new playground.c.lib.RuntimeError(
-                  playground.c.lib.Node._currentNode,
-                  'bad formatting flag \'' + token.flags.charAt(fi) + '\'');
-              }
-            }
-
-            token.minWidth = (token._minWidth) ? parseInt(token._minWidth) : 0;
-            token.maxWidth = -1;
-            token.toUpper = false;
-            token.isUnsigned = false;
-            token.isInt = false;
-            token.isDouble = false;
-            token.precision = 1;
-            if (token.period == '.')
-            {
-              if (token._precision)
-              {
-                token.precision = parseInt(token._precision);
-              }
-              else
-              {
-                token.precision = 0;
-              }
-            }
-
-            var mixins = this._specifiers[token.specifier];
-            if (typeof mixins == 'undefined')
-            {
-              throw new playground.c.lib.RuntimeError(
-                playground.c.lib.Node._currentNode,
-                'unexpected specifier \'' + token.specifier + '\'');
-            }
-
-            if (mixins.extend)
-            {
-              var s = this._specifiers[mixins.extend];
-              for (var k in s)
-              {
-                mixins[k] = s[k];
-              }
-
-              delete mixins.extend;
-            }
-
-            for (var k in mixins)
-            {
-              token[k] = mixins[k];
-            }
-          }
-
           if (typeof token.setArg == 'function')
           {
             token.setArg.call(this, token);
@@ -494,6 +430,101 @@ qx.Class.define("playground.c.stdio.Printf",
       return str;
     },
 
+    /**
+     * Determine, once for each conversion specification in the format
+     * string, the properties which do not depend upon the arguments.
+     *
+     * @param token {Map}
+     *   The token, as created by _parseDelim, to be compiled in place
+     */
+    __compileToken : function(token)
+    {
+      token.sign = '';
+      token.zeroPad = false;
+      token.rightJustify = false;
+      token.alternative = false;
+
+      var flags = {};
+      for (var fi = token.flags.length; fi--;)
+      {
+        var flag = token.flags.charAt(fi);
+
+        flags[flag] = true;
+
+        switch(flag)
+        {
+        case ' ':
+          token.sign = ' ';
+          break;
+
+        case '+':
+          token.sign = '+';
+          break;
+
+        case '0':
+          token.zeroPad = (flags['-']) ? false : true;
+          break;
+
+        case '-':
+          token.rightJustify = true;
+          token.zeroPad = false;
+          break;
+
+        case '\#':
+          token.alternative = true;
+          break;
+
+        default:
+          throw new playground.c.lib.RuntimeError(
+            playground.c.lib.Node._currentNode,
+            'bad formatting flag \'' + token.flags.charAt(fi) + '\'');
+        }
+      }
+
+      token.minWidth = (token._minWidth) ? parseInt(token._minWidth) : 0;
+      token.maxWidth = -1;
+      token.toUpper = false;
+      token.isUnsigned = false;
+      token.isInt = false;
+      token.isDouble = false;
+      token.precision = 1;
+      if (token.period == '.')
+      {
+        if (token._precision)
+        {
+          token.precision = parseInt(token._precision);
+        }
+        else
+        {
+          token.precision = 0;
+        }
+      }
+
+      var mixins = this._specifiers[token.specifier];
+      if (typeof mixins == 'undefined')
+      {
+        throw new playground.c.lib.RuntimeError(
+          playground.c.lib.Node._currentNode,
+          'unexpected specifier \'' + token.specifier + '\'');
+      }
+
+      if (mixins.extend)
+      {
+        var s = this._specifiers[mixins.extend];
+        for (var k in s)
+        {
+          mixins[k] = s[k];
+        }
+
+        delete mixins.extend;
+      }
+
+      for (var k in mixins)
+      {
+        token[k] = mixins[k];
+      }
+    },
+
     _zeros10 : '0000000000',
 
     _spaces10 : '          ',
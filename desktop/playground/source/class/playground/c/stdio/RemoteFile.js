@@ -54,9 +54,8 @@ qx.Class.define("playground.c.stdio.RemoteFile",
     // overridden
     open : function(succ, fail, pathAddr)
     {
-      var             i;
       var             failureCode;
-      var             path = [];
+      var             path;
       var             fs;
       var             data;
 
@@ -76,19 +75,9 @@ qx.Class.define("playground.c.stdio.RemoteFile",
         return;
       }
 
-      // Get memory as an array
-      this._mem = playground.c.machine.Memory.getInstance().toArray(0);
-
-      // Copy the null-terminated path string (which is represented as the
-      // ASCII character codes of each character) from the given address, one
-      // character at a time, into an array.
-      for (i = pathAddr; this._mem[i] != 0 && i < this._mem.length; i++)
-      {
-        path.push(this._mem[i]);
-      }
-
-      // Convert each character code into its actual character
-      path = String.fromCharCode.apply(null, path);
+      // Retrieve the null-terminated path string from the given address
+      this._mem = playground.c.machine.Memory.getInstance();
+      path = this._mem.getString(pathAddr);
 
       // If we're in the gui environment, munge the path
       if (playground.view)
@@ -65,11 +65,6 @@ qx.Class.define("playground.c.stdio.Scanf",
    */
   construct : function(formatAddr)
   {
-    var             format = [];
-    var             memBytes;
-    var             i;
-    var             info = playground.c.machine.Memory.info;
-
     if (typeof formatAddr === "undefined")
     {
       throw new playground.c.lib.RuntimeError(
@@ -77,36 +72,21 @@ qx.Class.define("playground.c.stdio.Scanf",
         "The format string is missing.");
     }
 
-    // Get memory as an array
     this._mem = playground.c.machine.Memory.getInstance();
-    memBytes = this._mem.toArray(0);
-    
 
-    // Copy the null-terminated format string (which is represented as the
-    // ASCII character codes of each character) from the given address, one
-    // character at a time, into an array.
-    for (i = formatAddr; memBytes[i] != 0 && i < memBytes.length; i++)
+    // Retrieve the null-terminated format string from the given address,
+    // split into its individual characters
+    try
     {
-      // Ensure we are accessing a valid region of memory
-      if (! ((i >= info.gas.start && 
-              i < info.gas.start + info.gas.length) ||
-             (i >= info.heap.start && 
-              i < info.heap.start + info.heap.length) ||
-             (i >= info.rts.start &&
-              i < info.rts.start  + info.rts.length)))
-      {
-        throw new playground.c.lib.RuntimeError(
-          playground.c.lib.Node._currentNode,
-          "The format string argument appears to be invalid.\n" +
-          "  It is not the address of a string in memory");
-      }
-
-      format.push(memBytes[i]);
+      this._format = this._mem.getString(formatAddr).split("");
+    }
+    catch(e)
+    {
+      throw new playground.c.lib.RuntimeError(
+        playground.c.lib.Node._currentNode,
+        "The format string argument appears to be invalid.\n" +
+        "  It is not the address of a string in memory");
     }
-    
-    // Convert each character code in the format string into its actual
-    // character.
-    this._format = (String.fromCharCode.apply(null, format).split(""));
     
     // As characters are removed from the format array, they're shifted onto
     // this 'used' array, for the few cases where peeks at prior characters
@@ -115,6 +115,15 @@ qx.Class.define("playground.c.stdio.Stdin",
       }
     },
     
+    // overridden
+    _awaitInput : function()
+    {
+      // The worker's terminal can block awaiting input. Others can't.
+      return !! (this._terminal &&
+                 this._terminal.awaitInput &&
+                 this._terminal.awaitInput());
+    },
+
     /**
      * Inject input into this stream
      * 
@@ -50,7 +50,7 @@ qx.Class.define("playground.c.stdio.Stdio",
     /** Next open file index */
     _nextFileHandle : null,
 
-    include : function(name, line)
+    include : function(name, line, bDeclareOnly)
     {
       var             rootSymtab;
       var             mem;
@@ -66,33 +66,40 @@ qx.Class.define("playground.c.stdio.Stdio",
         // Get the root symbol table
         rootSymtab = playground.c.lib.Symtab.getByName("*");
 
-        // Save the standard handles, if they exists
-        stdin = playground.c.stdio.Stdio._openFileHandles[
-                   playground.c.stdio.Stdio._stdinFileHandle];
-        stdout = playground.c.stdio.Stdio._openFileHandles[
-                   playground.c.stdio.Stdio._stdoutFileHandle];
-        stderr = playground.c.stdio.Stdio._openFileHandles[
-                   playground.c.stdio.Stdio._stderrFileHandle];
-
-        // Initialize the open-file map and next file handle
-        playground.c.stdio.Stdio._openFileHandles = {};
-        playground.c.stdio.Stdio._nextFileHandle = 
-          playground.c.stdio.Stdio._stderrFileHandle + 1;
-
-        // Restore the standard handles, if they existed
-        playground.c.stdio.Stdio._openFileHandles[
-          playground.c.stdio.Stdio._stdinFileHandle] = stdin;
-        playground.c.stdio.Stdio._openFileHandles[
-          playground.c.stdio.Stdio._stdoutFileHandle] = stdout;
-        playground.c.stdio.Stdio._openFileHandles[
-          playground.c.stdio.Stdio._stderrFileHandle] = stderr;
+        // Unless only declaring the functions, forget any files left open
+        // by a prior run
+        if (! bDeclareOnly)
+        {
+          // Save the standard handles, if they exists
+          stdin = playground.c.stdio.Stdio._openFileHandles[
+                     playground.c.stdio.Stdio._stdinFileHandle];
+          stdout = playground.c.stdio.Stdio._openFileHandles[
+                     playground.c.stdio.Stdio._stdoutFileHandle];
+          stderr = playground.c.stdio.Stdio._openFileHandles[
+                     playground.c.stdio.Stdio._stderrFileHandle];
+
+          // Initialize the open-file map and next file handle
+          playground.c.stdio.Stdio._openFileHandles = {};
+          playground.c.stdio.Stdio._nextFileHandle = 
+            playground.c.stdio.Stdio._stderrFileHandle + 1;
+
+          // Restore the standard handles, if they existed
+          playground.c.stdio.Stdio._openFileHandles[
+            playground.c.stdio.Stdio._stdinFileHandle] = stdin;
+          playground.c.stdio.Stdio._openFileHandles[
+            playground.c.stdio.Stdio._stdoutFileHandle] = stdout;
+          playground.c.stdio.Stdio._openFileHandles[
+            playground.c.stdio.Stdio._stderrFileHandle] = stderr;
+        }
         
         //
-        // Add built-in functions.
+        // Add built-in functions. Those which may wait, for input or for the
+        // server, are marked as blocking.
         //
         [
           {
             name : "fopen",
+            bBlocking : true,
             func : function()
             {
               var args = Array.prototype.slice.call(arguments);
@@ -101,6 +108,7 @@ qx.Class.define("playground.c.stdio.Stdio",
           },
           {
             name : "fclose",
+            bBlocking : true,
             func : function()
             {
               var args = Array.prototype.slice.call(arguments);
@@ -109,6 +117,7 @@ qx.Class.define("playground.c.stdio.Stdio",
           },
           {
             name : "getchar",
+            bBlocking : true,
             func : function()
             {
               var args = Array.prototype.slice.call(arguments);
@@ -117,6 +126,7 @@ qx.Class.define("playground.c.stdio.Stdio",
           },
           {
             name : "fgetc",
+            bBlocking : true,
             func : function()
             {
               var args = Array.prototype.slice.call(arguments);
@@ -125,6 +135,7 @@ qx.Class.define("playground.c.stdio.Stdio",
           },
           {
             name : "fgets",
+            bBlocking : true,
             func : function()
             {
               var args = Array.prototype.slice.call(arguments);
@@ -133,6 +144,7 @@ qx.Class.define("playground.c.stdio.Stdio",
           },
           {
             name : "getc",
+            bBlocking : true,
             func : function()
             {
               // getc is an alias for fgetc
@@ -174,6 +186,7 @@ qx.Class.define("playground.c.stdio.Stdio",
           },
           {
             name : "scanf",
+            bBlocking : true,
             func : function()
             {
               var args = Array.prototype.slice.call(arguments);
@@ -182,6 +195,7 @@ qx.Class.define("playground.c.stdio.Stdio",
           },
           {
             name : "fscanf",
+            bBlocking : true,
             func : function()
             {
               var args = Array.prototype.slice.call(arguments);
@@ -223,7 +237,7 @@ qx.Class.define("playground.c.stdio.Stdio",
                   return info.name;
                 }
               });
-            declarator.setBuiltIn(info.func);
+            declarator.setBuiltIn(info.func, info.bBlocking);
 
             // Add the declarator to the symbol table entry
             entry.setSpecAndDecl( [ declarator ]);
@@ -245,7 +259,10 @@ qx.Class.define("playground.c.stdio.Stdio",
                   specifier
                 ]);
               entry.calculateOffset();
-              mem.set(entry.getAddr(), "int", -1);
+              if (! bDeclareOnly)
+              {
+                mem.set(entry.getAddr(), "int", -1);
+              }
             }
           },
           {
@@ -262,7 +279,10 @@ qx.Class.define("playground.c.stdio.Stdio",
                   specifier
                 ]);
               entry.calculateOffset();
-              mem.set(entry.getAddr(), "pointer", 0);
+              if (! bDeclareOnly)
+              {
+                mem.set(entry.getAddr(), "pointer", 0);
+              }
             }
           },
           {
@@ -279,9 +299,12 @@ qx.Class.define("playground.c.stdio.Stdio",
                   specifier
                 ]);
               entry.calculateOffset();
-              mem.set(entry.getAddr(), 
-                      "pointer", 
-                      playground.c.stdio.Stdio._stdinFileHandle);
+              if (! bDeclareOnly)
+              {
+                mem.set(entry.getAddr(), 
+                        "pointer", 
+                        playground.c.stdio.Stdio._stdinFileHandle);
+              }
             }
           },
           {
@@ -298,9 +321,12 @@ qx.Class.define("playground.c.stdio.Stdio",
                   specifier
                 ]);
               entry.calculateOffset();
-              mem.set(entry.getAddr(), 
-                      "pointer", 
-                      playground.c.stdio.Stdio._stdoutFileHandle);
+              if (! bDeclareOnly)
+              {
+                mem.set(entry.getAddr(), 
+                        "pointer", 
+                        playground.c.stdio.Stdio._stdoutFileHandle);
+              }
             }
           },
           {
@@ -317,9 +343,12 @@ qx.Class.define("playground.c.stdio.Stdio",
                   specifier
                 ]);
               entry.calculateOffset();
-              mem.set(entry.getAddr(), 
-                      "pointer", 
-                      playground.c.stdio.Stdio._stderrFileHandle);
+              if (! bDeclareOnly)
+              {
+                mem.set(entry.getAddr(), 
+                        "pointer", 
+                        playground.c.stdio.Stdio._stderrFileHandle);
+              }
             }
           }
         ].forEach(
@@ -25,25 +25,10 @@ qx.Class.define("playground.c.stdio.StringIn",
   construct : function(inputStrAddr)
   {
     var             mem;
-    var             memBytes;
-    var             inputStr;
-    var             i;
 
-    // Get memory as an array
+    // Retrieve the null-terminated input string from the given address
     mem = playground.c.machine.Memory.getInstance();
-    memBytes = this._mem.toArray(0);
-
-    // Copy the null-terminated input string (which is represented as the
-    // ASCII character codes of each character) from the given address, one
-    // character at a time, into an array.
-    for (i = inputStrAddr; memBytes[i] != 0 && i < memBytes.length; i++)
-    {
-      inputStr.push(memBytes[i]);
-    }
-    
-    // Convert each character code in the input string into its actual
-    // character, and join it back together into a single JavaScript string
-    this._inBuf = (String.fromCharCode.apply(null, inputStr)).join("");
+    this._inBuf = mem.getString(inputStrAddr);
   },
   
   members :
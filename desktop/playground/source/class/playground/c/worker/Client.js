@@ -0,0 +1,475 @@
+/**
+ * The user interface's side of running programs in a Web Worker
+ *
+ * A program run in the worker does not compete with the user interface for
+ * time, so it needn't yield as frequently. The worker relays the
+ * interpreter's output, errors, and state changes here, where they're
+ * applied to the terminal, editor, and application; and input entered in
+ * the terminal is sent to the worker. See playground.c.worker.Engine for
+ * the messages exchanged.
+ *
+ * The debugger runs in the worker too. Breakpoints, and presses of the Step
+ * and Continue buttons, are sent to it (via a shared
+ * playground.c.worker.DebugChannel, if the browser allows it); and it sends
+ * snapshots of memory, from which the memory template view is displayed
+ * here. With shared memory, a snapshot refers to the worker's memory
+ * rather than containing a copy of it.
+ *
+ * Graphics and file access require synchronous access to the user
+ * interface and the server, so programs needing either of those continue
+ * to be run in the user interface thread.
+ *
+ * Copyright (c) 2013 Derrell Lipman
+ *
+ * License:
+ *   GPL Version 2: http://www.gnu.org/licenses/gpl-2.0.html
+ */
+
+/*
+@ignore(Worker)
+@asset(playground/js/engine-worker.js)
+ */
+
+qx.Class.define("playground.c.worker.Client",
+{
+  type   : "singleton",
+  extend : qx.core.Object,
+
+  construct : function()
+  {
+    var             uri;
+
+    this.base(arguments);
+
+    // Start the worker. If workers aren't supported, or the interpreter
+    // can't be loaded into one, programs run in the user interface thread.
+    try
+    {
+      uri = qx.util.ResourceManager.getInstance().toUri(
+        "playground/js/engine-worker.js");
+      this.__worker = new Worker(uri);
+      this.__worker.onmessage = this.__onMessage.bind(this);
+      this.__worker.onerror = this.__onError.bind(this);
+
+      // Share terminal input with the worker, if the browser allows it, so
+      // that it can block awaiting input
+      if (playground.c.worker.InputChannel.isSupported())
+      {
+        this.__inputChannel = new playground.c.worker.InputChannel();
+
+        // Likewise, share breakpoints and the debugger buttons, so that it
+        // can block while stopped at a breakpoint
+        this.__debugChannel = new playground.c.worker.DebugChannel();
+      }
+    }
+    catch(e)
+    {
+      this.__worker = null;
+    }
+  },
+
+  members :
+  {
+    /** The worker */
+    __worker : null,
+
+    /** Whether the worker has loaded the interpreter */
+    __bReady : false,
+
+    /** Whether a program is running in the worker */
+    __bRunning : false,
+
+    /** Listener for input entered in the terminal, while running */
+    __textlineListenerId : null,
+
+    /**
+     * Listeners for the debugger buttons and breakpoint changes, while
+     * running. Each is a map containing the object listened to (target) and
+     * the listener's id.
+     */
+    __debugListeners : null,
+
+    /** Input shared with the worker, if available */
+    __inputChannel : null,
+
+    /** Debugger controls shared with the worker, if available */
+    __debugChannel : null,
+
+    /** Input not yet fit into the shared input channel */
+    __pendingInput : "",
+
+    /** Whether end of file was indicated with the pending input */
+    __bPendingEof : false,
+
+    /** Timer for retrying the writing of pending input */
+    __pendingInputTimer : null,
+
+    /** Number identifying the most recent syntax check */
+    __checkId : 0,
+
+    /** Function to receive the errors found by the most recent check */
+    __fCheckDone : null,
+
+    /**
+     * Determine whether a program can be run in the worker
+     *
+     * @param code {String}
+     *   The program source
+     *
+     * @return {Boolean}
+     *   true if the program can be run in the worker; false if it must be
+     *   run in the user interface thread
+     */
+    canRun : function(code)
+    {
+      if (! this.__bReady || this.__bRunning)
+      {
+        return false;
+      }
+
+      // Graphics, and file access, need the user interface thread
+      if (/^\s*#\s*include\s*<(draw|elevator)\.h>/m.test(code) ||
+          /\bfopen\s*\(/.test(code))
+      {
+        return false;
+      }
+
+      return true;
+    },
+
+    /**
+     * Run a program in the worker
+     *
+     * @param code {String}
+     *   The program source
+     */
+    run : function(code)
+    {
+      var             application = qx.core.Init.getApplication();
+      var             terminal = application.getUserData("terminal");
+      var             editor = application.getUserData("sourceeditor");
+
+      // Create a function which obtains the lines with breakpoints
+      var getBreakpoints = function()
+      {
+        return editor.getBreakpoints().map(function(bp) { return !! bp; });
+      };
+
+      // Create a function which listens for an event, while running, and
+      // calls a function upon it
+      var listen = function(target, event, f)
+      {
+        this.__debugListeners.push(
+          {
+            target : target,
+            id     : target.addListener(event, f, this)
+          });
+      }.bind(this);
+
+      // Create a function which conveys a debugger button press
+      var press = function(command)
+      {
+        return function()
+        {
+          if (this.__debugChannel)
+          {
+            this.__debugChannel.send(command);
+            return;
+          }
+
+          this.__worker.postMessage({ type : "debug", command : command });
+        };
+      };
+
+      this.__bRunning = true;
+
+      // Send input entered in the terminal to the program
+      terminal.focus();
+      this.__textlineListenerId = terminal.addListener(
+        "textline",
+        function(e)
+        {
+          if (this.__inputChannel)
+          {
+            this.__pendingInput += e.getData();
+            this.__bPendingEof = terminal.getEof();
+            this.__writeInput();
+            return;
+          }
+
+          this.__worker.postMessage(
+            {
+              type : "stdin",
+              text : e.getData(),
+              eof  : terminal.getEof()
+            });
+        },
+        this);
+
+      // Send presses of the debugger buttons, and breakpoint changes
+      this.__debugListeners = [];
+      listen(application.getUserData("stepButton"), "execute", press("step"));
+      listen(application.getUserData("continueButton"), "execute",
+             press("continue"));
+      listen(
+        editor,
+        "changeBreakpoints",
+        function()
+        {
+          if (this.__debugChannel)
+          {
+            this.__debugChannel.setBreakpoints(getBreakpoints());
+            return;
+          }
+
+          this.__worker.postMessage(
+            {
+              type        : "breakpoints",
+              breakpoints : getBreakpoints()
+            });
+        });
+
+      if (this.__inputChannel)
+      {
+        this.__inputChannel.reset();
+        this.__debugChannel.reset(getBreakpoints());
+      }
+
+      this.__worker.postMessage(
+        {
+          type        : "run",
+          code        : code,
+          cmdLine     : application.getUserData("cmdLine").getValue(),
+          input       : (this.__inputChannel
+                         ? this.__inputChannel.getBuffer()
+                         : null),
+          breakpoints : getBreakpoints(),
+          debug       : (this.__debugChannel
+                         ? this.__debugChannel.getBuffer()
+                         : null),
+          memoryView  : application.memTemplateBox.isVisible()
+        });
+    },
+
+    /**
+     * Check the syntax of a program in the worker, so that parsing it
+     * doesn't delay the user interface. A program which parses successfully
+     * is retained by the worker, so that it needn't be parsed again when
+     * it's run there.
+     *
+     * @param code {String}
+     *   The program source
+     *
+     * @param fDone {Function}
+     *   Function to be called with the list of errors found, each a map
+     *   containing the location of the error (loc) and a description of it
+     *   (message). It is not called if another check is requested first.
+     *
+     * @return {Boolean}
+     *   true if the program is being checked in the worker; false if the
+     *   worker isn't available, e.g., because a program is running in it
+     */
+    check : function(code, fDone)
+    {
+      if (! this.__bReady || this.__bRunning)
+      {
+        return false;
+      }
+
+      this.__fCheckDone = fDone;
+      this.__worker.postMessage(
+        {
+          type : "check",
+          code : code,
+          id   : ++this.__checkId
+        });
+
+      return true;
+    },
+
+    /**
+     * Stop the program running in the worker, if there is one
+     */
+    stop : function()
+    {
+      if (this.__bRunning)
+      {
+        this.__worker.postMessage({ type : "stop" });
+
+        // If the worker is blocked awaiting input, or stopped at a
+        // breakpoint, it receives no messages
+        if (this.__inputChannel)
+        {
+          this.__inputChannel.stop();
+          this.__debugChannel.send("stop");
+        }
+      }
+    },
+
+    /**
+     * Write pending input into the shared input channel. Whatever doesn't
+     * fit is retried shortly, after the worker has read some.
+     */
+    __writeInput : function()
+    {
+      this.__pendingInputTimer = null;
+      this.__pendingInput =
+        this.__inputChannel.write(this.__pendingInput, this.__bPendingEof);
+
+      if (this.__pendingInput.length > 0)
+      {
+        this.__pendingInputTimer =
+          qx.event.Timer.once(this.__writeInput, this, 50);
+      }
+    },
+
+    /**
+     * Handle a message from the worker
+     *
+     * @param e {Event}
+     *   The message event. Its data member contains the message.
+     */
+    __onMessage : function(e)
+    {
+      var             mem;
+      var             model;
+      var             oldModel;
+      var             editor;
+      var             message = e.data;
+      var             application = qx.core.Init.getApplication();
+      var             terminal = application.getUserData("terminal");
+
+      switch(message.type)
+      {
+      case "ready" :
+        this.__bReady = true;
+        break;
+
+      case "output" :
+        terminal.addOutput(message.text);
+        break;
+
+      case "clear" :
+        terminal.clear();
+        break;
+
+      case "eof" :
+        terminal.setEof(message.eof);
+        break;
+
+      case "state" :
+        application.setProgramState(message.state);
+        break;
+
+      case "error" :
+        application.showError(message.loc, message.message, message.errorType);
+        break;
+
+      case "status" :
+        playground.ServerOp.statusReport(message.data);
+        break;
+
+      case "memory" :
+        // Display the contents of memory in the memory template view. If
+        // only the contents have changed, update just the modified words of
+        // the old model.
+        mem = playground.c.machine.Memory.getInstance();
+        mem.loadSnapshot(message.snapshot);
+        oldModel = application.memTemplate.getModel();
+        if (! oldModel || ! mem.updateDataModel(oldModel))
+        {
+          model = qx.data.marshal.Json.createModel(mem.getDataModel());
+          application.memTemplate.setModel(model);
+          oldModel && oldModel.dispose();
+        }
+        break;
+
+      case "editor" :
+        // Show the current line, or update the breakpoints
+        editor = application.getUserData("sourceeditor");
+        editor[message.method].apply(editor, message.args);
+        break;
+
+      case "done" :
+        this.__finish();
+        break;
+
+      case "syntax" :
+        // Ignore the results of all but the most recent check
+        if (message.id === this.__checkId && this.__fCheckDone)
+        {
+          this.__fCheckDone(message.errors);
+          this.__fCheckDone = null;
+        }
+        break;
+
+      default :
+        this.warn("Unrecognized message from worker: " + message.type);
+        break;
+      }
+    },
+
+    /**
+     * Handle an error in the worker. If it occurs while loading, the
+     * interpreter isn't available there, and all programs will be run in the
+     * user interface thread.
+     *
+     * @param e {Event}
+     *   The error event
+     */
+    __onError : function(e)
+    {
+      var             application = qx.core.Init.getApplication();
+
+      this.warn("Worker error: " + e.message);
+
+      if (this.__bRunning)
+      {
+        playground.c.Main.output(
+          "[3]Internal error: " + e.message + "\n" +
+          ">>> Program had errors. It did not run to completion.\n");
+        application.setProgramState("crashed");
+        this.__finish();
+      }
+      else if (! this.__bReady)
+      {
+        this.__worker.terminate();
+      }
+    },
+
+    /**
+     * Clean up after a program has finished running
+     */
+    __finish : function()
+    {
+      var             terminal;
+
+      this.__bRunning = false;
+
+      // Discard any input the program didn't read
+      if (this.__pendingInputTimer)
+      {
+        this.__pendingInputTimer.stop();
+        this.__pendingInputTimer = null;
+      }
+      this.__pendingInput = "";
+
+      if (this.__textlineListenerId)
+      {
+        terminal = qx.core.Init.getApplication().getUserData("terminal");
+        terminal.removeListenerById(this.__textlineListenerId);
+        this.__textlineListenerId = null;
+      }
+
+      if (this.__debugListeners)
+      {
+        this.__debugListeners.forEach(
+          function(listener)
+          {
+            listener.target.removeListenerById(listener.id);
+          });
+        this.__debugListeners = null;
+      }
+    }
+  }
+});
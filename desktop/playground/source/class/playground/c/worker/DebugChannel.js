@@ -0,0 +1,183 @@
+/**
+ * Debugger controls shared between the user interface thread and the worker
+ *
+ * When the browser allows shared memory, the lines with breakpoints, and
+ * presses of the Step, Continue, and Stop buttons, are written into a
+ * SharedArrayBuffer rather than sent as messages. Breakpoints set while the
+ * program runs are then seen by the worker immediately. A worker stopped at
+ * a breakpoint blocks (with Atomics.wait) until a button is pressed, and
+ * continues the program as soon as it is, rather than returning to its
+ * event loop to await a message.
+ *
+ * The buffer begins with a control block of 32-bit integers (see the
+ * statics), followed by one byte per line of the program, which is nonzero
+ * if there is a breakpoint at that line.
+ *
+ * Copyright (c) 2013 Derrell Lipman
+ *
+ * License:
+ *   GPL Version 2: http://www.gnu.org/licenses/gpl-2.0.html
+ */
+
+/*
+@ignore(SharedArrayBuffer)
+@ignore(Atomics)
+@ignore(Atomics.*)
+ */
+
+qx.Class.define("playground.c.worker.DebugChannel",
+{
+  extend : qx.core.Object,
+
+  /**
+   * @param buffer {SharedArrayBuffer?}
+   *   The buffer shared with the other side. If not provided, a new one is
+   *   allocated, to be provided to the other side via getBuffer().
+   */
+  construct : function(buffer)
+  {
+    var             DebugChannel = playground.c.worker.DebugChannel;
+
+    this.base(arguments);
+
+    if (! buffer)
+    {
+      buffer = new SharedArrayBuffer(
+        DebugChannel.HEADER_SIZE * 4 + DebugChannel.MAX_LINES);
+    }
+
+    this.__buffer = buffer;
+    this.__control = new Int32Array(buffer, 0, DebugChannel.HEADER_SIZE);
+    this.__breakpoints =
+      new Uint8Array(buffer, DebugChannel.HEADER_SIZE * 4,
+                     DebugChannel.MAX_LINES);
+  },
+
+  statics :
+  {
+    /** Index in the control block of the button pressed, if any */
+    COMMAND : 0,
+
+    /** Number of integers in the control block */
+    HEADER_SIZE : 1,
+
+    /** Maximum number of lines at which breakpoints may be set */
+    MAX_LINES : 65536,
+
+    /** The buttons, indexed by their value in the control block */
+    COMMANDS : [ null, "step", "continue", "stop" ]
+  },
+
+  members :
+  {
+    /** The shared buffer */
+    __buffer : null,
+
+    /** The control block, viewed as 32-bit integers */
+    __control : null,
+
+    /** The breakpoint indicator for each line (0-relative) */
+    __breakpoints : null,
+
+    /**
+     * Retrieve the shared buffer, to be provided to the other side
+     *
+     * @return {SharedArrayBuffer}
+     */
+    getBuffer : function()
+    {
+      return this.__buffer;
+    },
+
+    /**
+     * Discard any button press not yet seen by the worker, and provide the
+     * lines with breakpoints. This must be called only while the worker is
+     * not running a program.
+     *
+     * @param breakpoints {Array}
+     *   An array with a truthy element for each line (0-relative) at which
+     *   there is a breakpoint
+     */
+    reset : function(breakpoints)
+    {
+      Atomics.store(this.__control, playground.c.worker.DebugChannel.COMMAND,
+                    0);
+      this.setBreakpoints(breakpoints);
+    },
+
+    /**
+     * Provide the lines with breakpoints (called in the user interface
+     * thread, whenever they change)
+     *
+     * @param breakpoints {Array}
+     *   An array with a truthy element for each line (0-relative) at which
+     *   there is a breakpoint
+     */
+    setBreakpoints : function(breakpoints)
+    {
+      var             i;
+      var             MAX_LINES = playground.c.worker.DebugChannel.MAX_LINES;
+
+      for (i = 0; i < MAX_LINES; i++)
+      {
+        this.__breakpoints[i] = breakpoints[i] ? 1 : 0;
+      }
+    },
+
+    /**
+     * Retrieve the lines with breakpoints (called in the worker). The
+     * interpreter may also move a breakpoint to a line with code, by
+     * modifying this array.
+     *
+     * @return {Uint8Array}
+     *   An array with a nonzero element for each line (0-relative) at which
+     *   there is a breakpoint. It reflects subsequent changes made by the
+     *   user interface thread.
+     */
+    getBreakpoints : function()
+    {
+      return this.__breakpoints;
+    },
+
+    /**
+     * Report that a debugger button was pressed (called in the user
+     * interface thread)
+     *
+     * @param command {String}
+     *   "step", "continue", or "stop"
+     */
+    send : function(command)
+    {
+      var             DebugChannel = playground.c.worker.DebugChannel;
+
+      Atomics.store(this.__control, DebugChannel.COMMAND,
+                    DebugChannel.COMMANDS.indexOf(command));
+      Atomics.notify(this.__control, DebugChannel.COMMAND);
+    },
+
+    /**
+     * Block until a debugger button is pressed (called in the worker, while
+     * stopped at a breakpoint)
+     *
+     * @return {String}
+     *   "step", "continue", or "stop". The button press is consumed.
+     */
+    awaitCommand : function()
+    {
+      var             command;
+      var             DebugChannel = playground.c.worker.DebugChannel;
+
+      for (;;)
+      {
+        command = Atomics.exchange(this.__control, DebugChannel.COMMAND, 0);
+        if (command)
+        {
+          return DebugChannel.COMMANDS[command];
+        }
+
+        // Block until a button is pressed
+        Atomics.wait(this.__control, DebugChannel.COMMAND, 0);
+      }
+    }
+  }
+});
@@ -0,0 +1,633 @@
+/**
+ * The interpreter's side of running programs in a Web Worker
+ *
+ * In the worker, there is no application and no user interface. The
+ * interpreter nonetheless retrieves the application, and from it the
+ * terminal, editor, debugger buttons, and memory template view, to display
+ * output, errors, and memory, to set the program state, and to await the
+ * Step and Continue buttons. This class provides stand-ins for each of
+ * those, which relay what the interpreter asks of them to the user
+ * interface thread as messages. It also accepts messages from that thread,
+ * to run a program, provide input, step, continue, and stop the program,
+ * and change breakpoints. The messages are:
+ *
+ * From the user interface thread:
+ *   { type : "run", code : <source>, cmdLine : <command line>,
+ *     input : <SharedArrayBuffer of a playground.c.worker.InputChannel, or
+ *              null if input is sent via "stdin" messages>,
+ *     breakpoints : <Array, with a truthy element for each line (0-relative)
+ *                    at which there is a breakpoint>,
+ *     debug : <SharedArrayBuffer of a playground.c.worker.DebugChannel, or
+ *              null if breakpoints and button presses are sent via
+ *              "breakpoints" and "debug" messages>,
+ *     memoryView : <whether the memory template view is open> }
+ *   { type : "stdin", text : <line of input>, eof : <Boolean> }
+ *   { type : "stop" }
+ *   { type : "debug", command : <"step" or "continue"> }
+ *   { type : "breakpoints", breakpoints : <as in "run"> }
+ *   { type : "check", code : <source>, id : <number identifying the check> }
+ *
+ * To the user interface thread:
+ *   { type : "ready" }
+ *   { type : "output", text : <text to display in the terminal> }
+ *   { type : "clear" }
+ *   { type : "eof", eof : <Boolean> }
+ *   { type : "state", state : <program state> }
+ *   { type : "error", loc : <location>, message : <message>,
+ *     errorType : <"error" for syntax errors; otherwise undefined> }
+ *   { type : "status", data : <status report> }
+ *   { type : "memory", snapshot : <snapshot of memory, from
+ *     playground.c.machine.Memory.getSnapshot(); its memory is transferred> }
+ *   { type : "editor", method : <name of editor method>, args : <Array> }
+ *   { type : "done" }
+ *   { type : "syntax", id : <id of the check>, errors : <array of errors,
+ *     each with a location (loc) and a message> }
+ *
+ * The user interface side is playground.c.worker.Client.
+ *
+ * Copyright (c) 2013 Derrell Lipman
+ *
+ * License:
+ *   GPL Version 2: http://www.gnu.org/licenses/gpl-2.0.html
+ */
+
+/*
+@ignore(setTimeout)
+ */
+
+qx.Class.define("playground.c.worker.Engine",
+{
+  type : "static",
+
+  statics :
+  {
+    /**
+     * Number of milliseconds to execute before yielding. Yielding is needed
+     * only to receive messages, e.g., to stop the program, as the user
+     * interface is not affected by a worker's execution.
+     */
+    BUDGET : 250,
+
+    /** The port via which messages are exchanged */
+    __port : null,
+
+    /** The parser */
+    __parser : null,
+
+    /** The stand-in for the application */
+    __application : null,
+
+    /** Whether the current program has begun executing */
+    __bStarted : false,
+
+    /** Whether a program is running, i.e., has not yet finished */
+    __bRunning : false,
+
+    /** Lines with breakpoints, as provided by the user interface thread */
+    __breakpoints : [],
+
+    /** Debugger controls shared with the user interface thread, if any */
+    __debugChannel : null,
+
+    /** Whether the memory template view is open */
+    __bMemoryView : false,
+
+    /**
+     * The listener awaiting each debugger button, as a map containing its
+     * id, function, and context; keyed by the button's name
+     */
+    __buttonListeners : {},
+
+    /** The id of the most recently added button listener */
+    __buttonListenerId : 0,
+
+    /**
+     * Begin accepting messages, and note that we're ready to run programs
+     *
+     * @param port {Object}
+     *   The worker's global scope, or other object with postMessage() and
+     *   onmessage
+     *
+     * @param parser {Object}
+     *   The parser
+     */
+    start : function(port, parser)
+    {
+      var             Engine = playground.c.worker.Engine;
+      var             terminal = new playground.c.worker.Terminal();
+      var             userData;
+
+      Engine.__port = port;
+      Engine.__parser = parser;
+
+      // Values which the interpreter retrieves from the application
+      userData =
+        {
+          terminal       : terminal,
+          sourceeditor   : Engine.__createEditor(),
+          stepButton     : Engine.__createButton("stepButton"),
+          continueButton : Engine.__createButton("continueButton"),
+          stopButton     : Engine.__createButton("stopButton"),
+          cmdLine        :
+          {
+            getValue : function()
+            {
+              return playground.c.Main.commandLine || "";
+            }
+          }
+        };
+
+      // Create the stand-in for the application
+      Engine.__application =
+        {
+          // The memory template view is in the user interface thread. The
+          // interpreter sends it snapshots of memory, from which it builds
+          // its model.
+          memTemplate    :
+          {
+            setModel    : function(model) {},
+
+            setSnapshot : function(snapshot)
+            {
+              // Ignore the periodic redisplay once the program has finished
+              if (Engine.__bRunning)
+              {
+                Engine.__postSnapshot(snapshot);
+              }
+            }
+          },
+
+          memTemplateBox :
+          {
+            isVisible : function()
+            {
+              return Engine.__bMemoryView;
+            }
+          },
+
+          getUserData : function(key)
+          {
+            return userData[key];
+          },
+
+          setProgramState : function(state)
+          {
+            Engine.post({ type : "state", state : state });
+
+            // The program has ended if it crashed, or if it's become idle
+            // after running. (It also becomes idle as it's about to run.)
+            if (state == "running")
+            {
+              Engine.__bStarted = true;
+            }
+            else if (state == "stopped" && Engine.__debugChannel)
+            {
+              // Once the interpreter awaits the Step or Continue button,
+              // block until one is pressed
+              setTimeout(Engine.__awaitDebugCommand, 0);
+            }
+            else if (state == "crashed" ||
+                     (state == "idle" && Engine.__bStarted))
+            {
+              Engine.__finish();
+            }
+          },
+
+          showError : function(loc, message, type)
+          {
+            Engine.post(
+              {
+                type      : "error",
+                loc       : loc,
+                message   : message,
+                errorType : type
+              });
+          }
+        };
+
+      // The interpreter retrieves the application from qx.core.Init
+      qx.core.Init = qx.core.Init || {};
+      qx.core.Init.getApplication = function()
+      {
+        return Engine.__application;
+      };
+
+      // Status reports are sent by the user interface thread
+      qx.Class.createNamespace(
+        "playground.ServerOp",
+        {
+          statusReport : function(data)
+          {
+            Engine.post({ type : "status", data : data });
+          }
+        });
+
+      // Run for longer between yields than in the user interface thread
+      playground.c.lib.Scheduler.budget = Engine.BUDGET;
+
+      // If the memory template view can read memory directly, there's no
+      // need to copy it for each display of the view
+      playground.c.machine.Memory.bShared =
+        playground.c.worker.InputChannel.isSupported();
+
+      // Begin accepting messages
+      port.onmessage = Engine.__onMessage;
+      Engine.post({ type : "ready" });
+    },
+
+    /**
+     * Send a message to the user interface thread. Any pending terminal
+     * output is sent first, so that messages are received in the order in
+     * which they were generated.
+     *
+     * @param message {Map}
+     *   The message to be sent
+     *
+     * @param bNoFlush {Boolean?}
+     *   If true, pending terminal output is not sent first. This is used
+     *   when the message is, itself, the terminal output.
+     *
+     * @param transfer {Array?}
+     *   Objects (e.g., ArrayBuffers) in the message, whose ownership is to
+     *   be transferred to the user interface thread rather than copied
+     */
+    post : function(message, bNoFlush, transfer)
+    {
+      var             Engine = playground.c.worker.Engine;
+
+      if (! bNoFlush && Engine.__application)
+      {
+        Engine.__application.getUserData("terminal").flush();
+      }
+
+      Engine.__port.postMessage(message, transfer || []);
+    },
+
+    /**
+     * Send a snapshot of memory to the user interface thread, for the memory
+     * template view. A copy of memory is transferred, not copied again.
+     *
+     * @param snapshot {Map}
+     *   The snapshot, from playground.c.machine.Memory.getSnapshot()
+     */
+    __postSnapshot : function(snapshot)
+    {
+      // Shared memory is not transferable (nor need it be)
+      playground.c.worker.Engine.post(
+        {
+          type     : "memory",
+          snapshot : snapshot
+        },
+        false,
+        snapshot.memory instanceof ArrayBuffer ? [ snapshot.memory ] : []);
+    },
+
+    /**
+     * Handle a message from the user interface thread
+     *
+     * @param e {Event}
+     *   The message event. Its data member contains the message.
+     */
+    __onMessage : function(e)
+    {
+      var             Engine = playground.c.worker.Engine;
+      var             message = e.data;
+
+      switch(message.type)
+      {
+      case "run" :
+        Engine.__debugChannel = (message.debug
+                                 ? new playground.c.worker.DebugChannel(
+                                     message.debug)
+                                 : null);
+        Engine.__breakpoints = (Engine.__debugChannel
+                                ? Engine.__debugChannel.getBreakpoints()
+                                : message.breakpoints || []);
+        Engine.__bMemoryView = !! message.memoryView;
+        Engine.__run(message.code, message.cmdLine, message.input);
+        break;
+
+      case "stdin" :
+        Engine.__application.getUserData("terminal").input(
+          message.text, message.eof);
+        break;
+
+      case "stop" :
+        playground.c.lib.Node._bStop = true;
+
+        // Simulate stdin data available, in case it's blocked awaiting input
+        Engine.__application.getUserData("terminal").input("", true);
+
+        // If it's stopped at a breakpoint, end it
+        Engine.__press("stopButton");
+        break;
+
+      case "debug" :
+        Engine.__press(message.command + "Button");
+        break;
+
+      case "breakpoints" :
+        Engine.__breakpoints = message.breakpoints;
+        break;
+
+      case "check" :
+        Engine.__check(message.code, message.id);
+        break;
+
+      default :
+        throw new Error("Unrecognized message type: " + message.type);
+      }
+    },
+
+    /**
+     * Preprocess, parse, and run a program
+     *
+     * @param code {String}
+     *   The program source
+     *
+     * @param cmdLine {String}
+     *   The command line with which to run the program
+     *
+     * @param input {SharedArrayBuffer|null}
+     *   The buffer via which input is shared, if available
+     */
+    __run : function(code, cmdLine, input)
+    {
+      var             message;
+      var             Engine = playground.c.worker.Engine;
+      var             parser = Engine.__parser;
+
+      // Await input in the shared buffer, if there is one
+      Engine.__application.getUserData("terminal").setInputChannel(
+        input ? new playground.c.worker.InputChannel(input) : null);
+
+      playground.c.Main.commandLine = cmdLine;
+      playground.c.lib.Node._bStop = false;
+      Engine.__bStarted = false;
+      Engine.__bRunning = true;
+      Engine.__buttonListeners = {};
+
+      try
+      {
+        playground.c.lib.Preprocessor.preprocess(
+          code,
+          function(preprocessedCode)
+          {
+            playground.c.Main.main(parser);
+            playground.c.Main.parse(parser, preprocessedCode);
+          });
+
+        // If there were syntax errors, the program won't be run
+        if (playground.c.lib.Node.getError().errorCount > 0)
+        {
+          Engine.__finish();
+        }
+      }
+      catch(e)
+      {
+        // Errors during execution are handled by Main.process(). Any error
+        // here is from the preprocessor or the parser.
+        if (e instanceof playground.c.lib.RuntimeError)
+        {
+          message = "Error near line " + e.node.line + ": " + e.message + "\n";
+          playground.c.Main._statusReport(
+            {
+              type       : "exit_crash",
+              exit_crash : message
+            });
+          Engine.__application.showError(
+            {
+              first_line   : e.node.line,
+              first_column : 0,
+              last_line    : e.node.line,
+              last_column  : 9999
+            },
+            message);
+          playground.c.Main.output(message);
+          Engine.__application.setProgramState("crashed");
+        }
+        else
+        {
+          // The parser gives up after reporting a syntax error
+          console.log("Ignoring (irrelevant?) error: " + e);
+          Engine.__finish();
+        }
+      }
+    },
+
+    /**
+     * Preprocess and parse a program, without running it, and report any
+     * errors. This is requested while the user edits the program, and never
+     * while a program is running here, as parsing resets the symbol table.
+     * A program which parses successfully is retained, so that it needn't
+     * be parsed again when it's run.
+     *
+     * @param code {String}
+     *   The program source
+     *
+     * @param id {Number}
+     *   The number identifying this check, returned with the errors
+     */
+    __check : function(code, id)
+    {
+      var             errors = [];
+      var             Engine = playground.c.worker.Engine;
+
+      try
+      {
+        playground.c.lib.Preprocessor.preprocess(
+          code,
+          function(preprocessedCode)
+          {
+            try
+            {
+              errors =
+                playground.c.Main.check(Engine.__parser, preprocessedCode);
+            }
+            catch(e)
+            {
+              // It'll be reported if the program is run
+              console.log("Syntax check failed: " + e);
+            }
+          },
+          true);
+      }
+      catch(e)
+      {
+        // The preprocessor found an error
+        errors =
+          [
+            {
+              loc     :
+              {
+                first_line   : (e.node && e.node.line) || 1,
+                first_column : 0
+              },
+              message : e.message || String(e)
+            }
+          ];
+      }
+
+      Engine.post({ type : "syntax", id : id, errors : errors });
+    },
+
+    /**
+     * Note that the program has finished. Once the interpreter has finished
+     * cleaning up, send the final contents of memory, for the memory
+     * template view.
+     */
+    __finish : function()
+    {
+      var             Engine = playground.c.worker.Engine;
+
+      Engine.__bRunning = false;
+      Engine.__buttonListeners = {};
+
+      setTimeout(
+        function()
+        {
+          Engine.__postSnapshot(
+            playground.c.machine.Memory.getInstance().getSnapshot());
+          Engine.post({ type : "done" });
+        },
+        0);
+    },
+
+    /**
+     * Create the stand-in for the editor. Breakpoints are those provided by
+     * the user interface thread. Changes to them, and to the display, are
+     * relayed to the editor there.
+     *
+     * @return {Map}
+     *   An object providing the editor methods used by the interpreter
+     */
+    __createEditor : function()
+    {
+      var             Engine = playground.c.worker.Engine;
+      var             decorations = {};
+
+      // Create a function which relays a call to the editor
+      var relay = function(method)
+      {
+        return function()
+        {
+          Engine.post(
+            {
+              type   : "editor",
+              method : method,
+              args   : qx.lang.Array.cast(arguments, Array)
+            });
+        };
+      };
+
+      return (
+        {
+          getBreakpoints : function()
+          {
+            return Engine.__breakpoints;
+          },
+
+          setBreakpoint : function(line)
+          {
+            Engine.__breakpoints[line] = true;
+            relay("setBreakpoint").apply(null, arguments);
+          },
+
+          clearBreakpoint : function(line)
+          {
+            Engine.__breakpoints[line] = false;
+            relay("clearBreakpoint").apply(null, arguments);
+          },
+
+          addGutterDecoration : function(row, className)
+          {
+            decorations[row + " " + className] = true;
+            relay("addGutterDecoration").apply(null, arguments);
+          },
+
+          // The interpreter removes the decoration from the prior line upon
+          // each change of line. Relay only removal of added decorations.
+          removeGutterDecoration : function(row, className)
+          {
+            if (decorations[row + " " + className])
+            {
+              delete decorations[row + " " + className];
+              relay("removeGutterDecoration").apply(null, arguments);
+            }
+          },
+
+          scrollToLine : relay("scrollToLine")
+        });
+    },
+
+    /**
+     * Create the stand-in for a debugger button. The interpreter adds a
+     * one-time listener to it, which is called when the user interface
+     * thread reports that the button was pressed.
+     *
+     * @param name {String}
+     *   The name of the button, e.g., "stepButton"
+     *
+     * @return {Map}
+     *   An object providing the button methods used by the interpreter
+     */
+    __createButton : function(name)
+    {
+      var             Engine = playground.c.worker.Engine;
+
+      return (
+        {
+          addListenerOnce : function(type, f, context)
+          {
+            Engine.__buttonListeners[name] =
+              {
+                id      : ++Engine.__buttonListenerId,
+                f       : f,
+                context : context
+              };
+
+            return Engine.__buttonListenerId;
+          },
+
+          removeListenerById : function(id)
+          {
+            var             listener = Engine.__buttonListeners[name];
+
+            if (listener && listener.id === id)
+            {
+              delete Engine.__buttonListeners[name];
+            }
+          }
+        });
+    },
+
+    /**
+     * Block until a debugger button is pressed in the user interface thread,
+     * and then call the listener awaiting it
+     */
+    __awaitDebugCommand : function()
+    {
+      var             Engine = playground.c.worker.Engine;
+
+      Engine.__press(Engine.__debugChannel.awaitCommand() + "Button");
+    },
+
+    /**
+     * Call the listener awaiting a debugger button, if there is one
+     *
+     * @param name {String}
+     *   The name of the button which was pressed, e.g., "stepButton"
+     */
+    __press : function(name)
+    {
+      var             Engine = playground.c.worker.Engine;
+      var             listener = Engine.__buttonListeners[name];
+
+      if (listener)
+      {
+        delete Engine.__buttonListeners[name];
+        listener.f.call(listener.context);
+      }
+    }
+  }
+});
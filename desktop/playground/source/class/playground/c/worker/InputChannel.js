@@ -0,0 +1,268 @@
+/**
+ * Terminal input shared between the user interface thread and the worker
+ *
+ * When the browser allows shared memory, input entered in the terminal is
+ * written into a SharedArrayBuffer rather than sent as a message. The
+ * worker can then block (with Atomics.wait) until input is available, and
+ * continue the program as soon as it is, rather than returning to its event
+ * loop to await a message. A request to stop the program is also conveyed
+ * here, since a blocked worker receives no messages.
+ *
+ * The buffer begins with a control block of 32-bit integers (see the
+ * statics), followed by the input characters not yet read by the worker.
+ * The control block and characters are modified only while holding the
+ * lock, which each side holds only briefly.
+ *
+ * Copyright (c) 2013 Derrell Lipman
+ *
+ * License:
+ *   GPL Version 2: http://www.gnu.org/licenses/gpl-2.0.html
+ */
+
+/*
+@ignore(SharedArrayBuffer)
+@ignore(Atomics)
+@ignore(Atomics.*)
+@ignore(self)
+ */
+
+qx.Class.define("playground.c.worker.InputChannel",
+{
+  extend : qx.core.Object,
+
+  /**
+   * @param buffer {SharedArrayBuffer?}
+   *   The buffer shared with the other side. If not provided, a new one is
+   *   allocated, to be provided to the other side via getBuffer().
+   */
+  construct : function(buffer)
+  {
+    var             InputChannel = playground.c.worker.InputChannel;
+
+    this.base(arguments);
+
+    if (! buffer)
+    {
+      buffer = new SharedArrayBuffer(
+        InputChannel.HEADER_SIZE * 4 + InputChannel.CAPACITY * 2);
+    }
+
+    this.__buffer = buffer;
+    this.__control = new Int32Array(buffer, 0, InputChannel.HEADER_SIZE);
+    this.__data =
+      new Uint16Array(buffer, InputChannel.HEADER_SIZE * 4,
+                      InputChannel.CAPACITY);
+  },
+
+  statics :
+  {
+    /** Index in the control block of the lock */
+    LOCK     : 0,
+
+    /** Index of the count of writes, awaited by a blocked reader */
+    SEQUENCE : 1,
+
+    /** Index of the number of characters not yet read */
+    LENGTH   : 2,
+
+    /** Index of the end-of-file indicator */
+    EOF      : 3,
+
+    /** Index of the request to stop the program */
+    STOP     : 4,
+
+    /** Number of integers in the control block */
+    HEADER_SIZE : 5,
+
+    /** Maximum number of characters not yet read */
+    CAPACITY : 16384,
+
+    /**
+     * Determine whether input can be shared with a worker
+     *
+     * @return {Boolean}
+     *   true if SharedArrayBuffer is available and may be sent to a worker
+     */
+    isSupported : function()
+    {
+      return (typeof SharedArrayBuffer != "undefined" &&
+              typeof Atomics != "undefined" &&
+              !! self.crossOriginIsolated);
+    }
+  },
+
+  members :
+  {
+    /** The shared buffer */
+    __buffer : null,
+
+    /** The control block, viewed as 32-bit integers */
+    __control : null,
+
+    /** The input characters not yet read */
+    __data : null,
+
+    /**
+     * Retrieve the shared buffer, to be provided to the other side
+     *
+     * @return {SharedArrayBuffer}
+     */
+    getBuffer : function()
+    {
+      return this.__buffer;
+    },
+
+    /**
+     * Discard any unread input, and clear the end-of-file indicator and any
+     * request to stop. This must be called only while the worker is not
+     * running a program.
+     */
+    reset : function()
+    {
+      var             InputChannel = playground.c.worker.InputChannel;
+
+      this.__lock();
+      this.__control[InputChannel.LENGTH] = 0;
+      this.__control[InputChannel.EOF] = 0;
+      this.__control[InputChannel.STOP] = 0;
+      this.__unlock();
+    },
+
+    /**
+     * Provide input to the worker (called in the user interface thread)
+     *
+     * @param text {String}
+     *   The entered text
+     *
+     * @param bEof {Boolean}
+     *   Whether end of file was indicated along with this text
+     *
+     * @return {String}
+     *   The portion of the text which did not fit in the buffer, to be
+     *   written once the worker has read what's there. The end-of-file
+     *   indicator is not set until all text has been written.
+     */
+    write : function(text, bEof)
+    {
+      var             i;
+      var             length;
+      var             count;
+      var             InputChannel = playground.c.worker.InputChannel;
+      var             control = this.__control;
+
+      this.__lock();
+
+      // Append as much of the text as fits
+      length = control[InputChannel.LENGTH];
+      count = Math.min(text.length, InputChannel.CAPACITY - length);
+      for (i = 0; i < count; i++)
+      {
+        this.__data[length + i] = text.charCodeAt(i);
+      }
+      control[InputChannel.LENGTH] = length + count;
+
+      if (count == text.length)
+      {
+        control[InputChannel.EOF] = bEof ? 1 : 0;
+      }
+
+      this.__unlock();
+
+      // Wake the worker, if it's awaiting input
+      this.__notify();
+
+      return text.substr(count);
+    },
+
+    /**
+     * Request that the program stop (called in the user interface thread)
+     */
+    stop : function()
+    {
+      Atomics.store(this.__control, playground.c.worker.InputChannel.STOP, 1);
+      this.__notify();
+    },
+
+    /**
+     * Read all available input (called in the worker)
+     *
+     * @param bWait {Boolean}
+     *   Whether to block until there is input, end of file, or a request to
+     *   stop
+     *
+     * @return {Map}
+     *   The input text (text), whether end of file was indicated (bEof),
+     *   and whether the program has been asked to stop (bStop). The text
+     *   and end-of-file indicator are consumed.
+     */
+    read : function(bWait)
+    {
+      var             sequence;
+      var             length;
+      var             ret;
+      var             InputChannel = playground.c.worker.InputChannel;
+      var             control = this.__control;
+
+      for (;;)
+      {
+        // Retrieve the sequence first, so no write is missed while waiting
+        sequence = Atomics.load(control, InputChannel.SEQUENCE);
+
+        this.__lock();
+        length = control[InputChannel.LENGTH];
+        ret =
+          {
+            text  : String.fromCharCode.apply(
+                      null, this.__data.subarray(0, length)),
+            bEof  : !! control[InputChannel.EOF],
+            bStop : !! control[InputChannel.STOP]
+          };
+        control[InputChannel.LENGTH] = 0;
+        control[InputChannel.EOF] = 0;
+        this.__unlock();
+
+        if (! bWait || length > 0 || ret.bEof || ret.bStop)
+        {
+          return ret;
+        }
+
+        // Block until something is written
+        Atomics.wait(control, InputChannel.SEQUENCE, sequence);
+      }
+    },
+
+    /**
+     * Acquire the lock. It is held only while copying a line of input, so
+     * spinning is cheaper than blocking (which isn't allowed in the user
+     * interface thread anyway).
+     */
+    __lock : function()
+    {
+      var             LOCK = playground.c.worker.InputChannel.LOCK;
+
+      while (Atomics.compareExchange(this.__control, LOCK, 0, 1) !== 0)
+      {
+        // spin
+      }
+    },
+
+    /**
+     * Release the lock
+     */
+    __unlock : function()
+    {
+      Atomics.store(this.__control, playground.c.worker.InputChannel.LOCK, 0);
+    },
+
+    /**
+     * Wake a reader blocked awaiting input
+     */
+    __notify : function()
+    {
+      var             SEQUENCE = playground.c.worker.InputChannel.SEQUENCE;
+
+      Atomics.add(this.__control, SEQUENCE, 1);
+      Atomics.notify(this.__control, SEQUENCE);
+    }
+  }
+});
@@ -0,0 +1,195 @@
+/**
+ * Stand-in for the terminal, when the interpreter runs in a Web Worker
+ *
+ * The interpreter retrieves the terminal from the application, and expects
+ * it to accept output and to provide input via its "textline" event. In the
+ * worker, this object provides that interface, relaying output to the
+ * real terminal, in the user interface thread, via playground.c.worker.Engine.
+ *
+ * Copyright (c) 2013 Derrell Lipman
+ *
+ * License:
+ *   GPL Version 2: http://www.gnu.org/licenses/gpl-2.0.html
+ */
+
+/*
+@ignore(setTimeout)
+ */
+
+qx.Class.define("playground.c.worker.Terminal",
+{
+  extend : qx.core.Object,
+
+  construct : function()
+  {
+    this.base(arguments);
+
+    // Nothing has been output yet
+    this.__pending = [];
+  },
+
+  events :
+  {
+    // Fired when a line of text has been entered
+    "textline" : "qx.event.type.Data"
+  },
+
+  members :
+  {
+    /** Output not yet sent to the user interface thread */
+    __pending : null,
+
+    /** Whether end of file has been indicated */
+    __bEof : false,
+
+    /** Whether a flush of pending output has been scheduled */
+    __bFlushScheduled : false,
+
+    /** Input shared with the user interface thread, if available */
+    __inputChannel : null,
+
+    /**
+     * Specify where input is to be awaited
+     *
+     * @param channel {playground.c.worker.InputChannel|null}
+     *   The input shared with the user interface thread, or null if input
+     *   arrives via messages
+     */
+    setInputChannel : function(channel)
+    {
+      this.__inputChannel = channel;
+    },
+
+    /**
+     * Add output to be displayed. Output is sent to the user interface
+     * thread in batches, rather than with a message per call.
+     *
+     * @param text {String}
+     *   The text to be displayed
+     */
+    addOutput : function(text)
+    {
+      this.__pending.push(text);
+
+      if (! this.__bFlushScheduled)
+      {
+        this.__bFlushScheduled = true;
+        setTimeout(this.flush.bind(this), 0);
+      }
+    },
+
+    /**
+     * Send any pending output to the user interface thread
+     */
+    flush : function()
+    {
+      this.__bFlushScheduled = false;
+
+      if (this.__pending.length > 0)
+      {
+        playground.c.worker.Engine.post(
+          {
+            type : "output",
+            text : this.__pending.join("")
+          },
+          true);
+        this.__pending = [];
+      }
+    },
+
+    /**
+     * Clear the terminal
+     */
+    clear : function()
+    {
+      this.__pending = [];
+      playground.c.worker.Engine.post({ type : "clear" });
+    },
+
+    /**
+     * Give the terminal focus. That's the user interface thread's concern.
+     */
+    focus : function()
+    {
+    },
+
+    /**
+     * Turn on/off the EOF indicator
+     *
+     * @param bEof {Boolean}
+     *   Whether end of file has been reached
+     */
+    setEof : function(bEof)
+    {
+      this.__bEof = !! bEof;
+      playground.c.worker.Engine.post({ type : "eof", eof : this.__bEof });
+    },
+
+    /**
+     * Retrieve the current value of the EOF flag
+     */
+    getEof : function()
+    {
+      return this.__bEof;
+    },
+
+    /**
+     * Provide input which was entered in the real terminal
+     *
+     * @param text {String}
+     *   The entered text
+     *
+     * @param bEof {Boolean}
+     *   Whether end of file was indicated along with this text
+     */
+    input : function(text, bEof)
+    {
+      this.__bEof = !! bEof;
+      this.fireDataEvent("textline", text);
+    },
+
+    /**
+     * Block until input is available in the shared input channel, and then
+     * provide it as if it had been entered.
+     *
+     * @return {Boolean}
+     *   true if input was awaited; false if there is no shared input
+     *   channel, so input arrives via messages.
+     */
+    awaitInput : function()
+    {
+      var             input;
+
+      if (! this.__inputChannel)
+      {
+        return false;
+      }
+
+      // Whatever's been output (e.g., a prompt) must be seen before blocking
+      this.flush();
+
+      input = this.__inputChannel.read(true);
+
+      // A request to stop arrives here rather than as a message, since no
+      // messages are received while blocked. Terminate the input, as for
+      // the "stop" message.
+      if (input.bStop)
+      {
+        playground.c.lib.Node._bStop = true;
+        input.bEof = true;
+      }
+
+      this.input(input.text, input.bEof);
+      return true;
+    },
+
+    /**
+     * Graphics are drawn directly into the document, which a worker cannot
+     * access. Programs which use graphics are therefore not run in a worker.
+     */
+    getGraphicsCanvas : function()
+    {
+      throw new Error("Graphics are not available in a worker");
+    }
+  }
+});
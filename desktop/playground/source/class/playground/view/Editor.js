@@ -72,7 +72,17 @@ qx.Class.define("playground.view.Editor",
     /**
      * Event for signaling that the highlighting could not be done by the editor.
      */
-    "disableHighlighting" : "qx.event.type.Event"
+    "disableHighlighting" : "qx.event.type.Event",
+
+    /**
+     * Event fired whenever the user changes the code in the editor
+     */
+    "changeCode" : "qx.event.type.Event",
+
+    /**
+     * Event fired whenever the user sets or clears a breakpoint
+     */
+    "changeBreakpoints" : "qx.event.type.Event"
   },
 
 
@@ -349,7 +359,10 @@ qx.Class.define("playground.view.Editor",
                   snapshot      : qx.core.Init.getApplication().editor.getCode()
                 });
 */
-            });
+
+              // Let listeners know that the code has changed
+              this.fireEvent("changeCode");
+            }.bind(this));
 
           // enable/disable breakpoints by click in gutter
           editor.on(
@@ -408,8 +421,11 @@ qx.Class.define("playground.view.Editor",
                       })
                 });
               
+              // Let listeners know that the breakpoints have changed
+              this.fireEvent("changeBreakpoints");
+
               e.stop();
-            });
+            }.bind(this));
 
           // copy the inital value
           session.setValue(this.__textarea.getValue() || "");
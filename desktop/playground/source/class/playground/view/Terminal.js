@@ -35,6 +35,7 @@ qx.Class.define("playground.view.Terminal",
     legend = new qx.ui.basic.Label("Terminal");
     legend.setFont("bold");
     hBox.add(legend);
+    this._legend = legend;
     
     // Add a spacer to right-justify the EOF button
     hBox.add(new qx.ui.core.Spacer(), { flex : 1 });
@@ -70,6 +71,10 @@ qx.Class.define("playground.view.Terminal",
     
     // Prepare to store input characters
     this._linebuf = [];
+
+    // Nothing has been displayed yet
+    this.__text = "";
+    this.__pending = [];
   },
   
   events :
@@ -78,6 +83,20 @@ qx.Class.define("playground.view.Terminal",
     "textline" : "qx.event.type.Data"
   },
 
+  properties :
+  {
+    /**
+     * The maximum number of lines retained in the terminal. When output
+     * exceeds this, the earliest lines are discarded.
+     */
+    maxLines :
+    {
+      check : "Integer",
+      init  : 5000,
+      apply : "_applyMaxLines"
+    }
+  },
+
   members :
   {
     /** Line buffer, contains chars typed on one line. Flushed on Enter. */
@@ -85,6 +104,24 @@ qx.Class.define("playground.view.Terminal",
     
     _graphicsCanvas : null,
 
+    /** The "Terminal" legend, which also reports discarded lines */
+    _legend : null,
+
+    /** The text displayed in the terminal */
+    __text : null,
+
+    /** The number of complete (newline-terminated) lines in __text */
+    __lineCount : 0,
+
+    /** Output which has not yet been displayed */
+    __pending : null,
+
+    /** Whether a flush of pending output has been scheduled */
+    __bFlushScheduled : false,
+
+    /** Number of lines discarded since the terminal was last cleared */
+    __droppedLines : 0,
+
     /**
      * Focus the text area
      */
@@ -92,6 +129,9 @@ qx.Class.define("playground.view.Terminal",
     {
       var             pos;
 
+      // Display any pending output
+      this.__flush();
+
       // On terminal focus, focus the text area
       this._textArea.focus();
       
@@ -108,9 +148,21 @@ qx.Class.define("playground.view.Terminal",
      */
     clear : function()
     {
-      // Clear the terminal window
-      this._textArea.setValue(null);
-      
+      // Clear the terminal window, and discard any pending output
+      this.__text = "";
+      this.__lineCount = 0;
+      this.__pending = [];
+
+      // Output may have been appended directly to the DOM element, unseen
+      // by the text area, which ignores setting null if its value is
+      // already null. Set the empty string, which is compared with what's
+      // actually displayed.
+      this._textArea.setValue("");
+
+      // Nothing has been discarded from the cleared window
+      this.__droppedLines = 0;
+      this._legend.setValue("Terminal");
+
       // Flush prior input
       this._linebuf = [];
     },
@@ -119,18 +171,142 @@ qx.Class.define("playground.view.Terminal",
      * Add text output to the terminal. This is intended for things like
      * printf() to place its output in the terminal window.
      *
+     * The text is not displayed immediately. Output is collected and
+     * displayed once per animation frame, so that a program which writes
+     * many lines doesn't re-render the terminal for each of them.
+     *
      * @param text {String}
      *   Text to be appended ot the terminal window
      */
     addOutput : function(text)
     {
+      this.__pending.push(text);
+
+      // If we haven't yet scheduled display of pending output, do so now.
+      if (! this.__bFlushScheduled)
+      {
+        this.__bFlushScheduled = true;
+        if (window.requestAnimationFrame)
+        {
+          window.requestAnimationFrame(this.__flush.bind(this));
+        }
+        else
+        {
+          qx.event.Timer.once(this.__flush, this, 0);
+        }
+      }
+    },
+
+    /**
+     * Retrieve the number of lines which have been discarded, since the
+     * terminal was last cleared, due to the maxLines limit.
+     *
+     * @return {Integer}
+     *   The number of discarded lines
+     */
+    getDroppedLineCount : function()
+    {
+      return this.__droppedLines;
+    },
+
+    /**
+     * Display any pending output
+     */
+    __flush : function()
+    {
+      this.__bFlushScheduled = false;
+
+      if (this.__pending.length === 0)
+      {
+        return;
+      }
+
+      this.__append(this.__pending.join(""));
+      this.__pending = [];
+    },
+
+    /**
+     * Append text to the terminal window, and scroll to the bottom. Only
+     * the new text is added to the text area, unless earlier lines must be
+     * discarded to remain within the maxLines limit.
+     *
+     * @param text {String}
+     *   The text to be appended
+     */
+    __append : function(text)
+    {
+      var             i;
+      var             dom;
       var             textArea = this._textArea;
-      
-      // Add the next text to the terminal
-      textArea.setValue((textArea.getValue() || "") + text);
+
+      // Count the lines which this text completes
+      for (i = text.indexOf("\n"); i != -1; i = text.indexOf("\n", i + 1))
+      {
+        ++this.__lineCount;
+      }
+
+      this.__text += text;
+
+      // If there are now too many lines, discard the earliest ones
+      if (this.__lineCount > this.getMaxLines())
+      {
+        this.__trim();
+      }
+      else
+      {
+        // Otherwise, append just the new text, if the browser allows it
+        dom = textArea.getContentElement().getDomElement();
+        if (dom && dom.setRangeText)
+        {
+          dom.setRangeText(text, dom.value.length, dom.value.length);
+        }
+        else
+        {
+          textArea.setValue(this.__text);
+        }
+      }
+
       textArea.getContentElement().scrollToY(100000);
     },
 
+    /**
+     * Discard the earliest lines, beyond the maxLines limit, and display the
+     * retained text in the text area.
+     */
+    __trim : function()
+    {
+      var             i;
+      var             excess;
+      var             textArea = this._textArea;
+
+      // Find the end of the last line to be discarded
+      excess = this.__lineCount - this.getMaxLines();
+      for (i = -1; excess > 0; excess--)
+      {
+        i = this.__text.indexOf("\n", i + 1);
+        --this.__lineCount;
+        ++this.__droppedLines;
+      }
+
+      // Discard those lines, and report how many have been discarded
+      this.__text = this.__text.substr(i + 1);
+      this._legend.setValue("Terminal (" + this.__droppedLines +
+                            " earlier lines discarded)");
+
+      textArea.setValue(this.__text);
+      textArea.getContentElement().scrollToY(100000);
+    },
+
+    // property apply function
+    _applyMaxLines : function(value, old)
+    {
+      // Enforce the new limit on the lines already displayed
+      if (this.__text && this.__lineCount > value)
+      {
+        this.__trim();
+      }
+    },
+
     /**
      * Turn on/off the EOF button
      * 
@@ -176,7 +352,6 @@ qx.Class.define("playground.view.Terminal",
     _onKeyPress : function(e)
     {
       var             keyId = e.getKeyIdentifier();
-      var             textArea = this._textArea;
       var             value;
       var             data;
       
@@ -187,8 +362,8 @@ qx.Class.define("playground.view.Terminal",
         this._linebuf.push("\n");
 
         // Add a newline to the text area  and scroll to the bottom
-        textArea.setValue(textArea.getValue() + "\n");
-        textArea.getContentElement().scrollToY(100000);
+        this.__flush();
+        this.__append("\n");
 
         // Get the data string
         data = this._linebuf.join("");
@@ -208,9 +383,10 @@ qx.Class.define("playground.view.Terminal",
           this._linebuf.pop();
           
           // Remove the final character from the text field
-          value = textArea.getValue();
-          textArea.setValue(value.substr(0, value.length - 1));
-          textArea.getContentElement().scrollToY(100000);
+          this.__flush();
+          value = this.__text;
+          this.__text = value.substr(0, value.length - 1);
+          this._textArea.setValue(this.__text);
         }
         break;
         
@@ -226,15 +402,14 @@ qx.Class.define("playground.view.Terminal",
     /** Event listener for keyinput event */
     _onKeyInput : function(e)
     {
-      var             textArea = this._textArea;
       var             inputChar = e.getChar();
 
       // Add this character to the line buffer
       this._linebuf.push(inputChar);
 
-      // Add this character to the text field
-      textArea.setValue(textArea.getValue() + inputChar);
-      textArea.getContentElement().scrollToY(100000);
+      // Add this character to the text field, after any pending output
+      this.__flush();
+      this.__append(inputChar);
       
       // Prevent the character from being echoed
       e.preventDefault();
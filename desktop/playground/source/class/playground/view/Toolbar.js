@@ -348,14 +348,17 @@ qx.Class.define("playground.view.Toolbar",
             });
         }
 
-        // Show or hide the Memory Template view
+        // Show or hide the Memory Template view. While it's hidden, symbol
+        // information for it need not be maintained by a running program.
         if (bOn)
         {
           application.memTemplateBox.show();
+          playground.c.machine.Memory.getInstance().setViewDetached(false);
         }
         else
         {
           application.memTemplateBox.exclude();
+          playground.c.machine.Memory.getInstance().setViewDetached(true);
         }
     }, this);
     
@@ -539,6 +542,9 @@ qx.Class.define("playground.view.Toolbar",
 
       // Simulate stdin data available, in case it's blocked awaiting input
       playground.c.stdio.Stdin.getInstance().fireEvent("inputdata");
+
+      // If the program is running in a worker, stop it there
+      playground.c.worker.Client.getInstance().stop();
     }
   },
 
@@ -0,0 +1,40 @@
+/**
+ * Web Worker in which programs are run
+ *
+ * The interpreter (engine.js) and parser (ansic.js) are built by the
+ * Makefile in compilers/ansic. The parser is a requireJS module; there's no
+ * requireJS in the worker, so it is retrieved here by providing the define()
+ * function it calls.
+ *
+ * Copyright (c) 2013 Derrell Lipman
+ *
+ * License:
+ *   GPL Version 2: http://www.gnu.org/licenses/gpl-2.0.html
+ */
+
+var             parser;
+
+// Load the interpreter
+importScripts("../script/engine.js");
+
+// Load the parser, capturing the module it defines
+self.define = function(deps, factory)
+{
+  // The dependency list is optional
+  if (typeof deps == "function")
+  {
+    factory = deps;
+  }
+
+  parser = factory(
+    function(name)
+    {
+      throw new Error("engine-worker: can't require " + name);
+    });
+};
+self.define.amd = {};
+
+importScripts("../script/ansic.js");
+
+// Begin accepting programs to run
+playground.c.worker.Engine.start(self, parser);